@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/**
+ * @brief Consumer-loop helper that sizes its batches from the observed queue depth.
+ *
+ * Popping one item at a time keeps latency low when the queue is idle but
+ * pays the index synchronisation cost per item under burst. Draining fixed
+ * large batches does the opposite. AdaptiveBatchConsumer sits in between:
+ * it starts with single-item batches and grows the batch limit while the
+ * queue keeps handing back full batches (the backlog is building), then
+ * shrinks it again once batches come back short (the backlog is gone).
+ *
+ * @tparam Queue Any queue exposing pop_batch(fn, maxItems), e.g.
+ *               SPSCRingBuffer or MPSCQueue.
+ * @tparam MAX_BATCH Upper bound on the batch limit. Must be a power of two.
+ *
+ * Features:
+ * - Depth driven: the limit doubles when a batch was full, halves when it was short
+ * - At idle the limit settles at 1-2, which drains the same single item as pop()
+ * - One index release per batch: relies on Queue::pop_batch()
+ * - No waiting: a batch never blocks for more items, so idle latency is unchanged
+ * - Counters for items and batches, useful for monitoring the average batch size
+ *
+ * Usage Constraints:
+ * - Must only be used from the queue's single consumer thread
+ *
+ * Example:
+ * @code
+ *   SPSCRingBuffer<Tick, 4096> ring;
+ *   AdaptiveBatchConsumer<decltype(ring)> consumer(ring);
+ *   while (running) {
+ *       if (consumer.poll([](Tick&& t) { handle(t); }) == 0) {
+ *           idle();
+ *       }
+ *   }
+ * @endcode
+ */
+template<typename Queue, std::size_t MAX_BATCH = 64>
+class AdaptiveBatchConsumer {
+    static_assert(MAX_BATCH >= 1 && (MAX_BATCH & (MAX_BATCH - 1)) == 0,
+                  "MAX_BATCH must be a non-zero power of two");
+
+public:
+    /**
+     * @brief Bind the helper to a queue.
+     *
+     * @param queue The queue to consume from. Must outlive this object.
+     */
+    explicit AdaptiveBatchConsumer(Queue& queue) noexcept : mQueue(queue) {}
+
+    /**
+     * @brief Consume one batch from the queue.
+     *
+     * @param fn Callable invoked as fn(T&&) for every item in the batch.
+     * @return size_t Number of items consumed (0 if the queue was empty).
+     *
+     * Time Complexity: O(n) where n is at most the current batch limit
+     */
+    template<typename F>
+    size_t poll(F&& fn) noexcept {
+        size_t limit = mBatchLimit;
+        size_t count = mQueue.pop_batch(std::forward<F>(fn), limit);
+
+        if (count == limit) {
+            // Queue had at least a full batch waiting: backlog is building
+            mBatchLimit = std::min(limit * 2, MAX_BATCH);
+        } else if (count < limit) {
+            // Batch came back short, queue is shallow: fall back towards single items
+            mBatchLimit = std::max<size_t>(limit / 2, 1);
+        }
+
+        if (count != 0) {
+            mItems += count;
+            ++mBatches;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Drain the queue completely, using as many batches as needed.
+     *
+     * @param fn Callable invoked as fn(T&&) for every item.
+     * @return size_t Total number of items consumed.
+     */
+    template<typename F>
+    size_t drain(F&& fn) noexcept {
+        size_t total = 0;
+        while (size_t count = poll(fn)) {
+            total += count;
+        }
+        return total;
+    }
+
+    /**
+     * @brief Get the batch limit the next poll() will use.
+     */
+    size_t batch_limit() const noexcept {
+        return mBatchLimit;
+    }
+
+    /**
+     * @brief Get the total number of items consumed so far.
+     */
+    uint64_t items() const noexcept {
+        return mItems;
+    }
+
+    /**
+     * @brief Get the number of non-empty batches consumed so far.
+     */
+    uint64_t batches() const noexcept {
+        return mBatches;
+    }
+
+private:
+    Queue& mQueue;              ///< Queue being consumed (consumer side only)
+    size_t mBatchLimit = 1;     ///< Current batch limit, in [1, MAX_BATCH]
+    uint64_t mItems = 0;        ///< Items consumed
+    uint64_t mBatches = 0;      ///< Non-empty batches consumed
+};
@@ -0,0 +1,436 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Shared-memory layout of a BroadcastBus.
+ *
+ * Follows the SPSCRingBuffer conventions: monotonically increasing
+ * positions masked into a power-of-two buffer, and every shared cursor
+ * on its own cache line.
+ */
+struct BroadcastBusHeader {
+    static constexpr uint64_t MAGIC = 0x4846544243415354ull;  // "HFTBCAST"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t CACHE_LINE = 64;
+
+    uint64_t magic;
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t capacity;      ///< Data area size in bytes, power of two
+
+    /**
+     * @brief Writer's published position (end of the last complete record).
+     *
+     * Only written by the writer, read by every reader.
+     */
+    alignas(CACHE_LINE) std::atomic<uint64_t> tail;
+
+    /**
+     * @brief Writer's claimed position: bytes below it may be in the middle of being written.
+     *
+     * Readers compare their cursor against claim - capacity after copying a
+     * record to detect that the writer lapped them during the copy.
+     */
+    alignas(CACHE_LINE) std::atomic<uint64_t> claim;
+};
+
+/**
+ * @brief Header in front of every record in the data area.
+ */
+struct BroadcastRecordHeader {
+    static constexpr uint32_t PADDING = 0xFFFFFFFFu;  ///< Type of the filler record at the wrap point
+
+    uint64_t seq;       ///< Record sequence number, increments by one per record
+    uint32_t size;      ///< Payload bytes after this header (record length is rounded up to ALIGN)
+    uint32_t type;      ///< User message type, or PADDING
+};
+
+/**
+ * @brief Single writer of a shared-memory broadcast market-data log.
+ *
+ * One writer process appends records into a POSIX shared-memory ring; any
+ * number of reader processes map it read-only and follow with private
+ * cursors (see BroadcastBusReader). The writer never waits for readers: a
+ * reader that falls more than one buffer behind detects the overrun through
+ * positions and record sequence numbers and resynchronises.
+ *
+ * Features:
+ * - Fixed-size or variable-length records, 16-byte aligned
+ * - Records never straddle the wrap point (a padding record fills the gap)
+ * - Writer cost: two stores of shared cursors plus the memcpy of the record
+ * - No reader state in shared memory: readers cannot slow the writer down
+ *
+ * Usage Constraints:
+ * - Exactly ONE writer per bus name
+ * - Records are limited to capacity / 4 bytes
+ */
+class BroadcastBusWriter {
+public:
+    static constexpr size_t ALIGN = sizeof(BroadcastRecordHeader);
+
+    /**
+     * @brief Create (or recreate) the shared-memory segment.
+     *
+     * @param name POSIX shm name, e.g. "/md.feed0".
+     * @param capacity Data area size in bytes. Must be a power of two >= 4096.
+     *
+     * Check is_open() afterwards; creation fails on an invalid capacity or
+     * if shm_open/ftruncate/mmap fail.
+     */
+    BroadcastBusWriter(const std::string& name, size_t capacity) noexcept {
+        if (capacity < 4096 || (capacity & (capacity - 1)) != 0) {
+            return;
+        }
+
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+        if (fd < 0) {
+            return;
+        }
+        mSize = sizeof(BroadcastBusHeader) + capacity;
+        if (::ftruncate(fd, static_cast<off_t>(mSize)) != 0) {
+            ::close(fd);
+            return;
+        }
+        void* addr = ::mmap(nullptr, mSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            return;
+        }
+
+        mHeader = new (addr) BroadcastBusHeader{};
+        mHeader->capacity = capacity;
+        mHeader->version = BroadcastBusHeader::VERSION;
+        mHeader->tail.store(0, std::memory_order_relaxed);
+        mHeader->claim.store(0, std::memory_order_relaxed);
+        mData = reinterpret_cast<std::byte*>(mHeader + 1);
+        mMask = capacity - 1;
+
+        // Magic last: readers only attach to a fully initialised header
+        std::atomic_thread_fence(std::memory_order_release);
+        mHeader->magic = BroadcastBusHeader::MAGIC;
+    }
+
+    /**
+     * @brief Unmap the segment. The name stays until unlink() is called.
+     */
+    ~BroadcastBusWriter() noexcept {
+        if (mHeader) {
+            ::munmap(mHeader, mSize);
+        }
+    }
+
+    BroadcastBusWriter(const BroadcastBusWriter&) = delete;
+    BroadcastBusWriter& operator=(const BroadcastBusWriter&) = delete;
+
+    /**
+     * @brief Check whether the segment was created and mapped.
+     */
+    bool is_open() const noexcept {
+        return mHeader != nullptr;
+    }
+
+    /**
+     * @brief Append a variable-length record.
+     *
+     * @param type User message type (any value except PADDING).
+     * @param data Payload bytes.
+     * @param size Payload size in bytes.
+     * @return true if the record was appended.
+     * @return false if it is larger than capacity / 4, type is PADDING or the bus is not open.
+     *
+     * Memory Ordering:
+     * - relaxed claim store + release fence: claim is visible before any
+     *   overwritten byte, so a reader racing with us sees the lap
+     * - release tail store: record bytes are visible before the new tail
+     */
+    bool publish(uint32_t type, const void* data, uint32_t size) noexcept {
+        if (!mHeader || type == BroadcastRecordHeader::PADDING) {
+            return false;
+        }
+        uint64_t length = (sizeof(BroadcastRecordHeader) + size + ALIGN - 1) & ~uint64_t(ALIGN - 1);
+        if (length > (mMask + 1) / 4) {
+            return false;
+        }
+
+        uint64_t offset = mTail & mMask;
+        uint64_t padding = (offset + length > mMask + 1) ? (mMask + 1 - offset) : 0;
+
+        mHeader->claim.store(mTail + padding + length, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        if (padding) {
+            BroadcastRecordHeader filler{mSeq,
+                                         static_cast<uint32_t>(padding - sizeof(BroadcastRecordHeader)),
+                                         BroadcastRecordHeader::PADDING};
+            std::memcpy(mData + offset, &filler, sizeof(filler));
+            offset = 0;
+        }
+
+        BroadcastRecordHeader header{mSeq, size, type};
+        std::memcpy(mData + offset, &header, sizeof(header));
+        std::memcpy(mData + offset + sizeof(header), data, size);
+
+        mTail += padding + length;
+        ++mSeq;
+        mHeader->tail.store(mTail, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Append a fixed-size record.
+     *
+     * @tparam T Trivially copyable message type.
+     */
+    template<typename T>
+    bool publish(uint32_t type, const T& message) noexcept {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Broadcast records are copied with memcpy");
+        return publish(type, &message, static_cast<uint32_t>(sizeof(T)));
+    }
+
+    /**
+     * @brief Get the number of records published so far.
+     */
+    uint64_t published() const noexcept {
+        return mSeq;
+    }
+
+    /**
+     * @brief Remove the shm name; existing mappings stay valid.
+     */
+    static void unlink(const std::string& name) noexcept {
+        ::shm_unlink(name.c_str());
+    }
+
+private:
+    BroadcastBusHeader* mHeader = nullptr;
+    std::byte* mData = nullptr;
+    size_t mSize = 0;
+    uint64_t mMask = 0;
+    uint64_t mTail = 0;     ///< Writer-local copy of the published tail
+    uint64_t mSeq = 0;      ///< Sequence number of the next record
+};
+
+/**
+ * @brief Read-only follower of a BroadcastBus with a private cursor.
+ *
+ * Each reader maps the segment PROT_READ and keeps its cursor in process
+ * memory, so readers never write to shared memory and never contend with
+ * each other or with the writer.
+ *
+ * Overrun Detection:
+ * - Before reading: writer tail more than capacity ahead of the cursor
+ * - After copying: writer claim more than capacity ahead (record was
+ *   overwritten during the copy, seqlock-style validation)
+ * - Record sequence number not the one expected
+ * On overrun the reader jumps to the writer's tail; the gap in sequence
+ * numbers of the next record is added to lost(). The gap is measured from
+ * the last sequence number the reader was synchronised to, so an overrun
+ * before the first record after attaching to a non-empty bus, or after
+ * seek_latest(), counts in overruns() but not in lost().
+ *
+ * Usage Constraints:
+ * - A reader object is used by one thread
+ */
+class BroadcastBusReader {
+public:
+    static constexpr size_t ALIGN = sizeof(BroadcastRecordHeader);
+
+    /**
+     * @brief Attach to an existing bus and start at its current tail.
+     *
+     * @param name POSIX shm name used by the writer.
+     *
+     * Check is_open() afterwards.
+     */
+    explicit BroadcastBusReader(const std::string& name) noexcept {
+        int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(BroadcastBusHeader)) {
+            ::close(fd);
+            return;
+        }
+        mSize = static_cast<size_t>(st.st_size);
+        void* addr = ::mmap(nullptr, mSize, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            return;
+        }
+
+        auto header = static_cast<const BroadcastBusHeader*>(addr);
+        if (header->magic != BroadcastBusHeader::MAGIC ||
+            header->version != BroadcastBusHeader::VERSION ||
+            sizeof(BroadcastBusHeader) + header->capacity != mSize) {
+            ::munmap(addr, mSize);
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        mHeader = header;
+        mData = reinterpret_cast<const std::byte*>(header + 1);
+        mMask = header->capacity - 1;
+        mScratch.resize(header->capacity / 4);
+        seek_latest();
+    }
+
+    ~BroadcastBusReader() noexcept {
+        if (mHeader) {
+            ::munmap(const_cast<BroadcastBusHeader*>(mHeader), mSize);
+        }
+    }
+
+    BroadcastBusReader(const BroadcastBusReader&) = delete;
+    BroadcastBusReader& operator=(const BroadcastBusReader&) = delete;
+
+    /**
+     * @brief Check whether the bus was found and mapped.
+     */
+    bool is_open() const noexcept {
+        return mHeader != nullptr;
+    }
+
+    /**
+     * @brief Deliver up to maxRecords new records.
+     *
+     * @param fn Callable invoked as fn(uint32_t type, const void* data, uint32_t size).
+     *           data points into a reader-private copy, valid during the call.
+     * @param maxRecords Upper bound on records delivered by this call.
+     * @return size_t Number of records delivered.
+     */
+    template<typename F>
+    size_t poll(F&& fn, size_t maxRecords = SIZE_MAX) noexcept {
+        size_t delivered = 0;
+        while (delivered < maxRecords) {
+            uint64_t tail = mHeader->tail.load(std::memory_order_acquire);
+            if (mPos == tail) {
+                break;
+            }
+            if (tail - mPos > mMask + 1) {
+                overrun();
+                continue;
+            }
+
+            uint64_t offset = mPos & mMask;
+            BroadcastRecordHeader header;
+            std::memcpy(&header, mData + offset, sizeof(header));
+
+            // A torn header must not make us read outside the data area
+            uint64_t length = (sizeof(header) + uint64_t(header.size) + ALIGN - 1) & ~uint64_t(ALIGN - 1);
+            bool sane = length <= mScratch.size() && offset + length <= mMask + 1;
+            if (sane && header.type != BroadcastRecordHeader::PADDING) {
+                std::memcpy(mScratch.data(), mData + offset + sizeof(header), header.size);
+            }
+
+            // Validate the copy: the writer must not have lapped us meanwhile
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (mHeader->claim.load(std::memory_order_relaxed) - mPos > mMask + 1 || !sane) {
+                overrun();
+                continue;
+            }
+
+            if (mResync) {
+                // First record after attach/seek/overrun re-bases the sequence
+                if (mCountLoss) {
+                    mLost += header.seq - mLostFrom;
+                }
+                mNextSeq = header.seq;
+                mResync = false;
+                mCountLoss = false;
+            } else if (header.seq != mNextSeq) {
+                overrun();
+                continue;
+            }
+
+            mPos += length;
+            if (header.type == BroadcastRecordHeader::PADDING) {
+                continue;  // padding shares the sequence number of the next record
+            }
+
+            ++mNextSeq;
+            fn(header.type, static_cast<const void*>(mScratch.data()), header.size);
+            ++delivered;
+        }
+        return delivered;
+    }
+
+    /**
+     * @brief Skip everything published so far and continue from the writer's tail.
+     *
+     * Records skipped this way are not losses; a pending loss count from an
+     * earlier overrun is dropped.
+     */
+    void seek_latest() noexcept {
+        jump_to_tail();
+        mCountLoss = false;
+        if (mPos == 0) {
+            // Nothing published yet: the first record is sequence 0
+            mNextSeq = 0;
+            mResync = false;
+        }
+    }
+
+    /**
+     * @brief Get the number of overruns detected.
+     */
+    uint64_t overruns() const noexcept {
+        return mOverruns;
+    }
+
+    /**
+     * @brief Get the number of records lost to overruns.
+     */
+    uint64_t lost() const noexcept {
+        return mLost;
+    }
+
+private:
+    /**
+     * @brief Recover from being lapped: jump to the tail and account the gap.
+     *
+     * While re-basing, mNextSeq is not a position in the stream, so the gap
+     * is only counted when the reader was synchronised (or is still counting
+     * from an earlier overrun).
+     */
+    void overrun() noexcept {
+        ++mOverruns;
+        if (!mResync) {
+            mLostFrom = mNextSeq;
+            mCountLoss = true;
+        }
+        jump_to_tail();
+    }
+
+    void jump_to_tail() noexcept {
+        mPos = mHeader->tail.load(std::memory_order_acquire);
+        mResync = true;
+    }
+
+    const BroadcastBusHeader* mHeader = nullptr;
+    const std::byte* mData = nullptr;
+    size_t mSize = 0;
+    uint64_t mMask = 0;
+    uint64_t mPos = 0;          ///< Private cursor (byte position)
+    uint64_t mNextSeq = 0;      ///< Sequence number expected at mPos
+    uint64_t mLostFrom = 0;     ///< First sequence number not delivered before an overrun
+    uint64_t mOverruns = 0;
+    uint64_t mLost = 0;
+    bool mResync = false;       ///< Next record re-bases mNextSeq
+    bool mCountLoss = false;    ///< Re-basing follows an overrun, count the gap
+    std::vector<std::byte> mScratch;
+};
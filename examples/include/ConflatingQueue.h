@@ -0,0 +1,243 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+/**
+ * @brief A keyed conflating Multiple-Producer, Single-Consumer queue.
+ *
+ * GUI, risk and analytics consumers only care about the latest value per key
+ * (e.g. the latest quote per instrument). ConflatingQueue keeps exactly one
+ * pending value per key: producers overwrite it, only the first update since
+ * the last consume enqueues the key, and the consumer receives each dirty
+ * key once together with its newest value.
+ *
+ * @tparam T The value type. Must be trivially copyable (copied with memcpy).
+ * @tparam NUM_KEYS Number of keys; keys are dense indices in [0, NUM_KEYS).
+ *
+ * Features:
+ * - Bounded memory: NUM_KEYS value slots plus a key ring of the same order,
+ *   independent of the update rate
+ * - Conflation: N updates to one key between two consumes cost one dequeue
+ * - Lock-free consumer: values are read with a seqlock-style retry
+ * - Cache-friendly: every key slot sits on its own cache line
+ *
+ * Slot State (one atomic word per key):
+ * - bit 0: write in progress (serialises producers of the same key)
+ * - bit 1: dirty (key is enqueued and not yet consumed)
+ * - bits 2+: version, bumped by every write
+ *
+ * Usage Constraints:
+ * - Any number of threads may call push()
+ * - Exactly ONE thread may call pop()/drain()
+ * - The object is large for big universes; allocate it on the heap
+ */
+template<typename T, std::size_t NUM_KEYS>
+class ConflatingQueue {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "ConflatingQueue values are copied with memcpy and must be trivially copyable");
+    static_assert(NUM_KEYS >= 1 && NUM_KEYS < (std::size_t{1} << 31),
+                  "NUM_KEYS must fit in a 31-bit key index");
+
+public:
+    /**
+     * @brief Publish the newest value for a key.
+     *
+     * @param key The key, in [0, NUM_KEYS).
+     * @param value The value; replaces any value still pending for this key.
+     * @return true if this update enqueued the key (first since the last consume).
+     * @return false if it was conflated into an already pending update.
+     *
+     * Thread Safety: Safe to call from multiple producer threads concurrently.
+     *
+     * Time Complexity: O(1); spins only while another producer writes the same key
+     */
+    bool push(uint32_t key, const T& value) noexcept {
+        auto& slot = mSlots[key];
+
+        // Take the per-key write bit
+        uint64_t state = slot.state.load(std::memory_order_relaxed);
+        while (true) {
+            if (state & WRITING) {
+                cpu_relax();
+                state = slot.state.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (slot.state.compare_exchange_weak(state, state | WRITING,
+                                                 std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        std::memcpy(&slot.value, &value, sizeof(T));
+
+        // Publish: bump version, mark dirty, drop the write bit
+        slot.state.store((state + VERSION) | DIRTY, std::memory_order_release);
+
+        if (state & DIRTY) {
+            return false;  // key already queued, consumer will see this value
+        }
+        enqueue_key(key);
+        return true;
+    }
+
+    /**
+     * @brief Pop the next dirty key with its newest value.
+     *
+     * @param key Receives the key.
+     * @param value Receives the newest value of that key.
+     * @return true if a key was popped.
+     * @return false if no key is dirty.
+     *
+     * Thread Safety: May ONLY be called by the single consumer thread.
+     *
+     * The dirty bit is cleared with the same CAS that validates the copied
+     * value, so any update that lands after the copy re-enqueues the key.
+     */
+    bool pop(uint32_t& key, T& value) noexcept {
+        uint32_t k;
+        if (!dequeue_key(k)) {
+            return false;
+        }
+
+        auto& slot = mSlots[k];
+        while (true) {
+            uint64_t state = slot.state.load(std::memory_order_acquire);
+            if (state & WRITING) {
+                cpu_relax();
+                continue;
+            }
+
+            std::memcpy(&value, &slot.value, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // Succeeds only if no producer wrote the slot during the copy
+            if (slot.state.compare_exchange_weak(state, state & ~DIRTY,
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        key = k;
+        return true;
+    }
+
+    /**
+     * @brief Pop every currently dirty key.
+     *
+     * @param fn Callable invoked as fn(uint32_t key, const T& value).
+     * @return size_t Number of keys consumed.
+     *
+     * Thread Safety: May ONLY be called by the single consumer thread.
+     */
+    template<typename F>
+    size_t drain(F&& fn) noexcept {
+        size_t count = 0;
+        uint32_t key;
+        T value;
+        while (pop(key, value)) {
+            fn(key, value);
+            ++count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Check whether any key is waiting to be consumed.
+     *
+     * Note: Only meaningful from the consumer thread.
+     */
+    bool empty() const noexcept {
+        return mKeys[mHead & (KEY_RING - 1)].load(std::memory_order_acquire) == 0;
+    }
+
+    /**
+     * @brief Get the number of keys.
+     */
+    static constexpr size_t keys() noexcept {
+        return NUM_KEYS;
+    }
+
+private:
+    // Cache line size to prevent false sharing between keys
+    static constexpr size_t CACHE_LINE = std::hardware_destructive_interference_size;
+
+    static constexpr uint64_t WRITING = 1;   ///< State bit: producer is writing the value
+    static constexpr uint64_t DIRTY = 2;     ///< State bit: key is enqueued
+    static constexpr uint64_t VERSION = 4;   ///< Increment for the version field
+
+    /**
+     * @brief Key ring capacity: next power of two >= NUM_KEYS.
+     *
+     * A key sits in the ring at most once, so the ring can never overflow.
+     */
+    static constexpr size_t KEY_RING = [] {
+        size_t capacity = 1;
+        while (capacity < NUM_KEYS) capacity <<= 1;
+        return capacity;
+    }();
+
+    /**
+     * @brief Per-key value slot.
+     */
+    struct alignas(CACHE_LINE) Slot {
+        std::atomic<uint64_t> state{0};  ///< WRITING | DIRTY | version
+        T value;                         ///< Newest value (seqlock protected)
+    };
+
+    static void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    /**
+     * @brief Append a key to the key ring (producers).
+     *
+     * Cells hold key + 1 so that 0 marks an empty cell. The wait on a
+     * non-empty cell only covers the window between the consumer's
+     * dequeue and its clearing store.
+     */
+    void enqueue_key(uint32_t key) noexcept {
+        size_t pos = mTail.fetch_add(1, std::memory_order_relaxed);
+        auto& cell = mKeys[pos & (KEY_RING - 1)];
+        while (cell.load(std::memory_order_acquire) != 0) {
+            cpu_relax();
+        }
+        cell.store(key + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Take the oldest key from the key ring (consumer).
+     */
+    bool dequeue_key(uint32_t& key) noexcept {
+        auto& cell = mKeys[mHead & (KEY_RING - 1)];
+        uint32_t value = cell.load(std::memory_order_acquire);
+        if (value == 0) {
+            return false;  // empty, or the producer has not stored yet
+        }
+        cell.store(0, std::memory_order_release);
+        ++mHead;
+        key = value - 1;
+        return true;
+    }
+
+    // mHead is only accessed by the consumer
+    alignas(CACHE_LINE) size_t mHead{0};
+
+    // mTail is claimed by producers with fetch_add
+    alignas(CACHE_LINE) std::atomic<size_t> mTail{0};
+
+    // Key ring, each cell holds key + 1 or 0
+    alignas(CACHE_LINE) std::array<std::atomic<uint32_t>, KEY_RING> mKeys{};
+
+    // One slot per key
+    std::array<Slot, NUM_KEYS> mSlots{};
+};
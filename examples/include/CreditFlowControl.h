@@ -0,0 +1,174 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+/**
+ * @brief End-to-end credit tracking for multi-hop ring pipelines.
+ *
+ * In a pipeline such as feed -> ring A -> normaliser -> ring B -> recorder,
+ * a lagging final stage fills ring B, then ring A, and only then does the
+ * feed see failed pushes. CreditFlowControl moves that decision to ingress:
+ * each source may only have `window` messages in flight between ingress and
+ * the final sink. The sink hands credits back as it finishes messages, so
+ * backpressure is applied before any internal ring can overflow.
+ *
+ * @tparam NUM_SOURCES Number of ingress sources sharing the pipeline.
+ *
+ * Features:
+ * - No RMW: each counter has a single writer (source or sink)
+ * - Cached sink progress: a source only reloads the sink's counter when its
+ *   cached credits run out, like a ring producer caching the consumer head
+ * - Cache-friendly: source state and sink state live on separate cache lines
+ * - Credit exhaustion is counted per source and exposed as a metric
+ *
+ * Sizing Rule:
+ * - If the sum of all source windows is <= the usable capacity of every ring
+ *   on the path, no internal push can fail for lack of space.
+ *
+ * Usage Constraints:
+ * - Exactly ONE thread calls try_acquire() for a given source
+ * - Exactly ONE thread (the final sink) calls release()
+ * - Messages must carry their source index so the sink can release them
+ */
+template<std::size_t NUM_SOURCES>
+class CreditFlowControl {
+    static_assert(NUM_SOURCES >= 1, "CreditFlowControl needs at least one source");
+
+public:
+    /**
+     * @brief Construct with the same credit window for every source.
+     *
+     * @param window Maximum messages one source may have in flight.
+     */
+    explicit CreditFlowControl(uint64_t window) noexcept {
+        for (auto& source : mSources) {
+            source.window = window;
+        }
+    }
+
+    /**
+     * @brief Try to take credits before injecting messages at ingress.
+     *
+     * @param source Index of the calling source, in [0, NUM_SOURCES).
+     * @param n Number of messages the caller wants to inject.
+     * @return true if the credits were taken; the caller must inject n messages.
+     * @return false if not enough credits are available (exhaustion is counted).
+     *
+     * Thread Safety: May ONLY be called by the thread owning this source.
+     *
+     * Memory Ordering:
+     * - acquire load of the sink counter, only when cached credits are short
+     * - relaxed store of the sent counter, it is only read for monitoring
+     */
+    bool try_acquire(size_t source, uint64_t n = 1) noexcept {
+        auto& state = mSources[source];
+        uint64_t sent = state.sent.load(std::memory_order_relaxed);
+
+        if (sent + n - state.consumedCache > state.window) {
+            // Out of cached credits: refresh from the sink's progress
+            state.consumedCache = mSinks[source].consumed.load(std::memory_order_acquire);
+            if (sent + n - state.consumedCache > state.window) {
+                state.exhausted.store(state.exhausted.load(std::memory_order_relaxed) + 1,
+                                      std::memory_order_relaxed);
+                return false;
+            }
+        }
+
+        state.sent.store(sent + n, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Hand credits back after the final sink finished messages.
+     *
+     * @param source Source the finished messages came from.
+     * @param n Number of finished messages.
+     *
+     * Thread Safety: May ONLY be called by the single sink thread.
+     *
+     * The release store publishes the sink's progress; once a source sees
+     * it, every ring slot those messages used has been freed.
+     */
+    void release(size_t source, uint64_t n = 1) noexcept {
+        auto& consumed = mSinks[source].consumed;
+        consumed.store(consumed.load(std::memory_order_relaxed) + n,
+                       std::memory_order_release);
+    }
+
+    /**
+     * @brief Get the number of messages of a source still in flight.
+     *
+     * Note: Approximate when read from a thread other than the source.
+     * consumed is loaded before sent so the pair can only overstate the
+     * count; the clamp covers a stale sent on a monitoring thread.
+     */
+    uint64_t in_flight(size_t source) const noexcept {
+        uint64_t consumed = mSinks[source].consumed.load(std::memory_order_acquire);
+        uint64_t sent = mSources[source].sent.load(std::memory_order_relaxed);
+        return sent > consumed ? sent - consumed : 0;
+    }
+
+    /**
+     * @brief Get the number of credits a source could take right now.
+     *
+     * Note: Approximate when read from a thread other than the source.
+     */
+    uint64_t available(size_t source) const noexcept {
+        uint64_t used = in_flight(source);
+        uint64_t window = mSources[source].window;
+        return used >= window ? 0 : window - used;
+    }
+
+    /**
+     * @brief Get how often a source was refused credits.
+     */
+    uint64_t exhausted(size_t source) const noexcept {
+        return mSources[source].exhausted.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get how often any source was refused credits.
+     */
+    uint64_t exhausted_total() const noexcept {
+        uint64_t total = 0;
+        for (const auto& source : mSources) {
+            total += source.exhausted.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /**
+     * @brief Get the credit window of a source.
+     */
+    uint64_t window(size_t source) const noexcept {
+        return mSources[source].window;
+    }
+
+private:
+    // Cache line size to keep source and sink counters apart
+    static constexpr size_t CACHE_LINE = std::hardware_destructive_interference_size;
+
+    /**
+     * @brief State written only by one source thread.
+     */
+    struct alignas(CACHE_LINE) SourceState {
+        std::atomic<uint64_t> sent{0};       ///< Messages admitted at ingress
+        std::atomic<uint64_t> exhausted{0};  ///< Refused try_acquire() calls (metric)
+        uint64_t consumedCache = 0;          ///< Last sink progress seen by the source
+        uint64_t window = 0;                 ///< Maximum messages in flight
+    };
+
+    /**
+     * @brief State written only by the sink thread.
+     */
+    struct alignas(CACHE_LINE) SinkState {
+        std::atomic<uint64_t> consumed{0};   ///< Messages finished by the sink
+    };
+
+    std::array<SourceState, NUM_SOURCES> mSources{};
+    std::array<SinkState, NUM_SOURCES> mSinks{};
+};
@@ -0,0 +1,674 @@
+#pragma once
+
+#include "FixedPoint.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief One tag=value field of a parsed FIX message.
+ */
+struct FixField {
+    uint32_t tag;
+    std::string_view value;   ///< Points into the parsed buffer
+};
+
+/**
+ * @brief Outcome of FixParser::parse().
+ */
+enum class FixParseResult {
+    OK,               ///< A complete message was parsed
+    INCOMPLETE,       ///< The buffer holds only part of a message; read more
+    MALFORMED,        ///< Framing or field syntax is broken
+    BAD_CHECKSUM,     ///< Tag 10 does not match the message bytes
+    TOO_MANY_FIELDS,  ///< More than FixMessage::MAX_FIELDS fields
+};
+
+/**
+ * @brief Zero-copy view of a parsed FIX message.
+ *
+ * Fields are string_views into the caller's receive buffer, kept in wire
+ * order in a fixed array. Tags below MAX_INDEXED_TAG are also indexed by a
+ * direct lookup table, so get(tag) is one array load; higher tags fall back
+ * to a linear scan.
+ *
+ * Usage Constraints:
+ * - Valid only while the parsed buffer is unchanged
+ * - For repeated tags (repeating groups) get() returns the first
+ *   occurrence; walk field(i) for the rest
+ * - Reuse one FixMessage per parser thread: reset cost is O(fields of the
+ *   previous message), not O(MAX_INDEXED_TAG)
+ */
+class FixMessage {
+public:
+    static constexpr size_t MAX_FIELDS = 128;
+    static constexpr uint32_t MAX_INDEXED_TAG = 1024;
+
+    /**
+     * @brief Check whether a tag is present.
+     */
+    bool has(uint32_t tag) const noexcept {
+        return find(tag) != nullptr;
+    }
+
+    /**
+     * @brief Get the value of a tag, or an empty view if absent.
+     */
+    std::string_view get(uint32_t tag) const noexcept {
+        const FixField* field = find(tag);
+        return field ? field->value : std::string_view();
+    }
+
+    /**
+     * @brief Get an integer tag (e.g. 34 MsgSeqNum, 38 OrderQty in whole units).
+     *
+     * @return false if absent or not a plain decimal integer.
+     */
+    bool get_int(uint32_t tag, int64_t& out) const noexcept {
+        std::string_view value = get(tag);
+        if (value.empty()) {
+            return false;
+        }
+        bool negative = value[0] == '-';
+        if (negative) value.remove_prefix(1);
+        if (value.empty() || value.size() > 18) {
+            return false;
+        }
+        int64_t result = 0;
+        for (char c : value) {
+            if (c < '0' || c > '9') return false;
+            result = result * 10 + (c - '0');
+        }
+        out = negative ? -result : result;
+        return true;
+    }
+
+    /**
+     * @brief Get a decimal tag (e.g. 44 Price) as fixed point.
+     */
+    template<unsigned DECIMALS>
+    bool get_decimal(uint32_t tag, FixedPoint<DECIMALS>& out) const noexcept {
+        const FixField* field = find(tag);
+        return field && FixedPoint<DECIMALS>::parse(field->value, out);
+    }
+
+    /**
+     * @brief Get tag 35 (MsgType).
+     */
+    std::string_view msg_type() const noexcept {
+        return get(35);
+    }
+
+    size_t field_count() const noexcept {
+        return mCount;
+    }
+
+    const FixField& field(size_t i) const noexcept {
+        return mFields[i];
+    }
+
+    /**
+     * @brief Get the whole message, from "8=" through the checksum SOH.
+     */
+    std::string_view raw() const noexcept {
+        return mRaw;
+    }
+
+private:
+    friend class FixParser;
+
+    const FixField* find(uint32_t tag) const noexcept {
+        if (tag < MAX_INDEXED_TAG) {
+            uint8_t slot = mIndex[tag];
+            return slot ? &mFields[slot - 1] : nullptr;
+        }
+        for (size_t i = 0; i < mCount; ++i) {
+            if (mFields[i].tag == tag) return &mFields[i];
+        }
+        return nullptr;
+    }
+
+    void reset() noexcept {
+        for (size_t i = 0; i < mCount; ++i) {
+            if (mFields[i].tag < MAX_INDEXED_TAG) {
+                mIndex[mFields[i].tag] = 0;
+            }
+        }
+        mCount = 0;
+        mRaw = {};
+    }
+
+    bool add(uint32_t tag, std::string_view value) noexcept {
+        if (mCount == MAX_FIELDS) {
+            return false;
+        }
+        mFields[mCount++] = FixField{tag, value};
+        if (tag < MAX_INDEXED_TAG && mIndex[tag] == 0) {
+            mIndex[tag] = uint8_t(mCount);   // first occurrence wins
+        }
+        return true;
+    }
+
+    std::array<FixField, MAX_FIELDS> mFields;
+    std::array<uint8_t, MAX_INDEXED_TAG> mIndex{};   ///< field index + 1, 0 = absent
+    size_t mCount = 0;
+    std::string_view mRaw;
+};
+
+/**
+ * @brief Zero-copy FIX tag=value parser with SIMD delimiter scanning.
+ *
+ * Frames one message from the front of a receive buffer using BodyLength
+ * (tag 9), verifies the CheckSum (tag 10), then splits the fields. SOH and
+ * '=' positions are found 32 bytes at a time with AVX2 (16 with SSE2 when
+ * AVX2 is unavailable) and walked as bitmasks, so the cost per field is a
+ * couple of bit operations plus the tag digits.
+ *
+ * Features:
+ * - No allocation, no copying: fields are views into the input
+ * - Stream friendly: INCOMPLETE plus `consumed` for partial reads
+ * - Runtime dispatch: AVX2 when the CPU has it, no -march flags needed
+ *
+ * Usage Constraints:
+ * - Stateless and thread-safe; each thread uses its own FixMessage
+ */
+class FixParser {
+public:
+    static constexpr char SOH = '\x01';
+
+    /**
+     * @brief Parse the first message in a buffer.
+     *
+     * @param buffer Received bytes, starting at "8=".
+     * @param message Receives the fields.
+     * @param consumed Set to the message length on OK (bytes to drop from the buffer).
+     * @return FixParseResult
+     */
+    static FixParseResult parse(std::string_view buffer, FixMessage& message, size_t& consumed) noexcept {
+        message.reset();
+        consumed = 0;
+
+        // Framing: 8=<BeginString> SOH 9=<BodyLength> SOH <body> 10=nnn SOH
+        if (buffer.size() < 2) {
+            return buffer.empty() || buffer[0] == '8' ? FixParseResult::INCOMPLETE : FixParseResult::MALFORMED;
+        }
+        if (buffer[0] != '8' || buffer[1] != '=') {
+            return FixParseResult::MALFORMED;
+        }
+        size_t beginEnd = buffer.find(SOH);
+        if (beginEnd == std::string_view::npos) {
+            return buffer.size() > 32 ? FixParseResult::MALFORMED : FixParseResult::INCOMPLETE;
+        }
+        size_t pos = beginEnd + 1;
+        if (buffer.size() < pos + 2) {
+            return FixParseResult::INCOMPLETE;
+        }
+        if (buffer[pos] != '9' || buffer[pos + 1] != '=') {
+            return FixParseResult::MALFORMED;
+        }
+        pos += 2;
+        size_t bodyLength = 0;
+        size_t digits = 0;
+        for (; pos < buffer.size() && buffer[pos] != SOH; ++pos, ++digits) {
+            char c = buffer[pos];
+            if (c < '0' || c > '9' || digits == 7) {
+                return FixParseResult::MALFORMED;
+            }
+            bodyLength = bodyLength * 10 + (c - '0');
+        }
+        if (pos == buffer.size()) {
+            return FixParseResult::INCOMPLETE;
+        }
+        if (digits == 0) {
+            return FixParseResult::MALFORMED;
+        }
+
+        size_t trailer = pos + 1 + bodyLength;
+        size_t total = trailer + TRAILER_LENGTH;
+        if (buffer.size() < total) {
+            return FixParseResult::INCOMPLETE;
+        }
+        const char* t = buffer.data() + trailer;
+        if (t[0] != '1' || t[1] != '0' || t[2] != '=' || t[6] != SOH || !is_digit(t[3]) ||
+            !is_digit(t[4]) || !is_digit(t[5])) {
+            return FixParseResult::MALFORMED;
+        }
+        unsigned expected = unsigned(t[3] - '0') * 100 + unsigned(t[4] - '0') * 10 + unsigned(t[5] - '0');
+        if (checksum(buffer.data(), trailer) != expected) {
+            return FixParseResult::BAD_CHECKSUM;
+        }
+
+        FixParseResult result = split(buffer.data(), total, message);
+        if (result == FixParseResult::OK) {
+            message.mRaw = buffer.substr(0, total);
+            consumed = total;
+        }
+        return result;
+    }
+
+    /**
+     * @brief FIX checksum: sum of all bytes modulo 256.
+     */
+    static unsigned checksum(const char* data, size_t length) noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        if (has_avx2()) {
+            return checksum_avx2(data, length);
+        }
+#endif
+        uint32_t sum = 0;
+        for (size_t i = 0; i < length; ++i) {
+            sum += uint8_t(data[i]);
+        }
+        return sum & 0xFF;
+    }
+
+private:
+    static constexpr size_t TRAILER_LENGTH = 7;   ///< "10=nnn" SOH
+
+    static constexpr bool is_digit(char c) noexcept {
+        return c >= '0' && c <= '9';
+    }
+
+    /**
+     * @brief Field splitter state carried across SIMD blocks.
+     */
+    struct Splitter {
+        const char* data;
+        FixMessage& message;
+        size_t fieldStart = 0;   ///< First byte of the current tag
+        size_t equals = 0;       ///< Position of the current field's '='
+        bool inValue = false;    ///< '=' seen; further '=' belong to the value
+
+        /**
+         * @brief Consume the delimiters of one block, given as bitmasks.
+         */
+        bool consume(size_t base, uint64_t sohMask, uint64_t eqMask) noexcept {
+            uint64_t events = sohMask | eqMask;
+            while (events) {
+                size_t bit = __builtin_ctzll(events);
+                size_t at = base + bit;
+                events &= events - 1;
+
+                if (!inValue) {
+                    if (!((eqMask >> bit) & 1) || !field_tag(at)) {
+                        return false;   // SOH before '=', or a bad tag
+                    }
+                    equals = at;
+                    inValue = true;
+                } else if ((sohMask >> bit) & 1) {
+                    if (!message.add(tag, std::string_view(data + equals + 1, at - equals - 1))) {
+                        overflow = true;
+                        return false;
+                    }
+                    fieldStart = at + 1;
+                    inValue = false;
+                }
+            }
+            return true;
+        }
+
+        bool field_tag(size_t equalsAt) noexcept {
+            size_t length = equalsAt - fieldStart;
+            if (length == 0 || length > 9) {
+                return false;
+            }
+            uint32_t tag = 0;
+            for (size_t i = fieldStart; i < equalsAt; ++i) {
+                char c = data[i];
+                if (c < '0' || c > '9') return false;
+                tag = tag * 10 + uint32_t(c - '0');
+            }
+            this->tag = tag;
+            return true;
+        }
+
+        uint32_t tag = 0;        ///< Tag of the current field
+        bool overflow = false;   ///< FixMessage::MAX_FIELDS exceeded
+    };
+
+    static FixParseResult finish(const Splitter& splitter, bool ok, size_t total) noexcept {
+        if (splitter.overflow) {
+            return FixParseResult::TOO_MANY_FIELDS;
+        }
+        return ok && !splitter.inValue && splitter.fieldStart == total ? FixParseResult::OK
+                                                                      : FixParseResult::MALFORMED;
+    }
+
+    static FixParseResult split(const char* data, size_t total, FixMessage& message) noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        if (has_avx2()) {
+            return split_avx2(data, total, message);
+        }
+        return split_sse2(data, total, message);
+#else
+        Splitter splitter{data, message};
+        bool ok = true;
+        for (size_t i = 0; i < total && ok; ++i) {
+            uint64_t soh = data[i] == SOH, eq = data[i] == '=';
+            if (soh | eq) ok = splitter.consume(i, soh, eq);
+        }
+        return finish(splitter, ok, total);
+#endif
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    static bool has_avx2() noexcept {
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+    }
+
+    /**
+     * @brief Load up to 32 bytes, zero-filling past the end (no over-read).
+     */
+    static void load_tail(const char* data, size_t length, char (&block)[32]) noexcept {
+        std::memset(block, 0, sizeof(block));
+        std::memcpy(block, data, length);
+    }
+
+    __attribute__((target("avx2")))
+    static FixParseResult split_avx2(const char* data, size_t total, FixMessage& message) noexcept {
+        const __m256i soh = _mm256_set1_epi8(SOH);
+        const __m256i eq = _mm256_set1_epi8('=');
+        Splitter splitter{data, message};
+        bool ok = true;
+        size_t i = 0;
+        for (; i + 32 <= total && ok; i += 32) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            uint32_t sohMask = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, soh)));
+            uint32_t eqMask = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, eq)));
+            ok = splitter.consume(i, sohMask, eqMask);
+        }
+        if (i < total && ok) {
+            alignas(32) char tail[32];
+            load_tail(data + i, total - i, tail);
+            __m256i block = _mm256_load_si256(reinterpret_cast<const __m256i*>(tail));
+            uint32_t sohMask = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, soh)));
+            uint32_t eqMask = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, eq)));
+            uint32_t valid = (1u << (total - i)) - 1;
+            ok = splitter.consume(i, sohMask & valid, eqMask & valid);
+        }
+        return finish(splitter, ok, total);
+    }
+
+    static FixParseResult split_sse2(const char* data, size_t total, FixMessage& message) noexcept {
+        const __m128i soh = _mm_set1_epi8(SOH);
+        const __m128i eq = _mm_set1_epi8('=');
+        Splitter splitter{data, message};
+        bool ok = true;
+        size_t i = 0;
+        for (; i + 16 <= total && ok; i += 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            uint32_t sohMask = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(block, soh)));
+            uint32_t eqMask = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(block, eq)));
+            ok = splitter.consume(i, sohMask, eqMask);
+        }
+        if (i < total && ok) {
+            alignas(32) char tail[32];
+            load_tail(data + i, total - i, tail);
+            __m128i block = _mm_load_si128(reinterpret_cast<const __m128i*>(tail));
+            uint32_t sohMask = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(block, soh)));
+            uint32_t eqMask = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(block, eq)));
+            uint32_t valid = (1u << (total - i)) - 1;
+            ok = splitter.consume(i, sohMask & valid, eqMask & valid);
+        }
+        return finish(splitter, ok, total);
+    }
+
+    /**
+     * @brief Byte sum with _mm256_sad_epu8 (32 bytes per instruction).
+     */
+    __attribute__((target("avx2")))
+    static unsigned checksum_avx2(const char* data, size_t length) noexcept {
+        __m256i sums = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            sums = _mm256_add_epi64(sums, _mm256_sad_epu8(block, _mm256_setzero_si256()));
+        }
+        uint64_t sum = uint64_t(_mm256_extract_epi64(sums, 0)) + uint64_t(_mm256_extract_epi64(sums, 1)) +
+                       uint64_t(_mm256_extract_epi64(sums, 2)) + uint64_t(_mm256_extract_epi64(sums, 3));
+        for (; i < length; ++i) {
+            sum += uint8_t(data[i]);
+        }
+        return unsigned(sum & 0xFF);
+    }
+#endif
+};
+
+/**
+ * @brief Writes one FIX message into a caller-provided buffer.
+ *
+ * Obtained from FixEncoder::begin(). Body fields are appended in order and
+ * summed for the checksum as they are written; finish() then places the
+ * precomputed "8=...|9=" prefix with the real BodyLength directly in front
+ * of the body (the body is written at a fixed offset that leaves room for
+ * the prefix), so nothing is moved or rescanned.
+ *
+ * Usage Constraints:
+ * - The buffer must outlive the returned view
+ * - If the buffer is too small, finish() returns an empty view
+ */
+class FixWriter {
+public:
+    /// Room reserved in front of the body for "8=FIX.x.y" SOH "9=nnnnnnn" SOH
+    static constexpr size_t MAX_PREFIX = 32;
+
+    FixWriter& add(uint32_t tag, std::string_view value) noexcept {
+        char* p = field_begin(tag, value.size());
+        if (p) {
+            std::memcpy(p, value.data(), value.size());
+            field_end(p + value.size());
+        }
+        return *this;
+    }
+
+    FixWriter& add(uint32_t tag, int64_t value) noexcept {
+        char* p = field_begin(tag, 20);
+        if (p) {
+            if (value < 0) {
+                *p++ = '-';
+            }
+            p += fixed_point_detail::write_uint(value < 0 ? 0 - uint64_t(value) : uint64_t(value), p);
+            field_end(p);
+        }
+        return *this;
+    }
+
+    FixWriter& add(uint32_t tag, char value) noexcept {
+        return add(tag, std::string_view(&value, 1));
+    }
+
+    template<unsigned DECIMALS>
+    FixWriter& add(uint32_t tag, FixedPoint<DECIMALS> value) noexcept {
+        char* p = field_begin(tag, FixedPoint<DECIMALS>::MAX_CHARS);
+        if (p) {
+            field_end(p + value.format(p));
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Complete the message: header prefix, BodyLength and CheckSum.
+     *
+     * @return std::string_view The encoded message inside the buffer, or an
+     *         empty view if it did not fit.
+     */
+    std::string_view finish() noexcept {
+        if (mFailed || mEnd - mPos < 7) {
+            return {};
+        }
+        size_t bodyLength = mPos - mBody;
+
+        // "8=FIX.x.y" SOH "9=" <len> SOH, written backwards from the body start
+        char digits[20];
+        size_t digitCount = fixed_point_detail::write_uint(bodyLength, digits);
+        if (mPrefix.size() + digitCount + 1 > MAX_PREFIX) {
+            return {};
+        }
+        char* start = mBody - 1 - digitCount - mPrefix.size();
+        std::memcpy(start, mPrefix.data(), mPrefix.size());
+        std::memcpy(start + mPrefix.size(), digits, digitCount);
+        mBody[-1] = FixParser::SOH;
+
+        uint32_t sum = mSum + mPrefixSum + FixParser::SOH;
+        for (size_t i = 0; i < digitCount; ++i) {
+            sum += uint8_t(digits[i]);
+        }
+        sum &= 0xFF;
+        char* p = mPos;
+        p[0] = '1';
+        p[1] = '0';
+        p[2] = '=';
+        p[3] = char('0' + sum / 100);
+        p[4] = char('0' + sum / 10 % 10);
+        p[5] = char('0' + sum % 10);
+        p[6] = FixParser::SOH;
+        return std::string_view(start, p + 7 - start);
+    }
+
+private:
+    friend class FixEncoder;
+
+    FixWriter(char* buffer, size_t capacity, std::string_view prefix, uint32_t prefixSum,
+              size_t reserve) noexcept
+        : mPrefix(prefix), mPrefixSum(prefixSum) {
+        mBody = buffer + reserve;
+        mPos = mBody;
+        mEnd = buffer + capacity;
+        mFailed = capacity < reserve;
+    }
+
+    /**
+     * @brief Write "tag=" and return where the value goes (nullptr if it cannot fit).
+     */
+    char* field_begin(uint32_t tag, size_t maxValue) noexcept {
+        if (mFailed || size_t(mEnd - mPos) < 10 + 1 + maxValue + 1) {
+            mFailed = true;
+            return nullptr;
+        }
+        mFieldStart = mPos;
+        char* p = mPos + fixed_point_detail::write_uint(tag, mPos);
+        *p++ = '=';
+        return p;
+    }
+
+    void field_end(char* p) noexcept {
+        *p++ = FixParser::SOH;
+        for (const char* c = mFieldStart; c < p; ++c) {
+            mSum += uint8_t(*c);
+        }
+        mPos = p;
+    }
+
+    std::string_view mPrefix;   ///< "8=FIX.4.4" SOH "9="
+    uint32_t mPrefixSum;
+    char* mBody;
+    char* mPos;
+    char* mEnd;
+    char* mFieldStart = nullptr;
+    uint32_t mSum = 0;
+    bool mFailed;
+};
+
+/**
+ * @brief FIX session encoder with precomputed header templates.
+ *
+ * The BeginString prefix and the per-session CompIDs are formatted (and
+ * their checksum contribution summed) once at construction; begin() copies
+ * the template and appends MsgType, MsgSeqNum and SendingTime.
+ *
+ * Usage Constraints:
+ * - One encoder per session; begin() is const and thread-safe, each
+ *   FixWriter belongs to one thread
+ * - A BeginString or CompIDs too long for the templates leave the encoder
+ *   invalid (see valid()); every writer it begins then fails
+ */
+class FixEncoder {
+public:
+    static constexpr size_t MAX_PREFIX = FixWriter::MAX_PREFIX;
+
+    FixEncoder(std::string_view beginString, std::string_view senderCompId, std::string_view targetCompId) noexcept {
+        // leave room for up to 7 BodyLength digits and the SOH
+        mValid = build(mPrefix, MAX_PREFIX - 8, {"8=", beginString, "\x01" "9="}, mPrefixLength) &&
+                 build(mSession, sizeof(mSession), {"49=", senderCompId, "\x01" "56=", targetCompId, "\x01"},
+                       mSessionLength);
+        mPrefixSum = sum(mPrefix, mPrefixLength);
+        mSessionSum = sum(mSession, mSessionLength);
+    }
+
+    /**
+     * @brief Check that the header templates fit (false if a BeginString or CompID is too long).
+     */
+    bool valid() const noexcept {
+        return mValid;
+    }
+
+    /**
+     * @brief Start a message: standard header fields are written immediately.
+     *
+     * @param buffer Output buffer; the message ends up somewhere in its first
+     *        MAX_PREFIX bytes plus body, see FixWriter::finish().
+     * @param msgType Tag 35.
+     * @param seqNum Tag 34.
+     * @param sendingTime Tag 52, pre-formatted (e.g. cached per millisecond).
+     */
+    FixWriter begin(char* buffer, size_t capacity, std::string_view msgType, uint64_t seqNum,
+                    std::string_view sendingTime) const noexcept {
+        FixWriter writer(buffer, capacity, std::string_view(mPrefix, mPrefixLength), mPrefixSum, MAX_PREFIX);
+        writer.mFailed |= !mValid;
+        writer.add(35, msgType);
+        if (!writer.mFailed && size_t(writer.mEnd - writer.mPos) >= mSessionLength) {
+            std::memcpy(writer.mPos, mSession, mSessionLength);
+            writer.mPos += mSessionLength;
+            writer.mSum += mSessionSum;
+        } else {
+            writer.mFailed = true;
+        }
+        writer.add(34, int64_t(seqNum));
+        writer.add(52, sendingTime);
+        return writer;
+    }
+
+private:
+    /**
+     * @brief Concatenate parts into out; false (and nothing written) if they exceed capacity.
+     */
+    static bool build(char* out, size_t capacity, std::initializer_list<std::string_view> parts,
+                      size_t& length) noexcept {
+        size_t total = 0;
+        for (auto part : parts) total += part.size();
+        if (total > capacity) {
+            length = 0;
+            return false;
+        }
+        length = 0;
+        for (auto part : parts) {
+            std::memcpy(out + length, part.data(), part.size());
+            length += part.size();
+        }
+        return true;
+    }
+
+    static uint32_t sum(const char* data, size_t length) noexcept {
+        uint32_t total = 0;
+        for (size_t i = 0; i < length; ++i) total += uint8_t(data[i]);
+        return total;
+    }
+
+    char mPrefix[MAX_PREFIX];
+    char mSession[128];
+    size_t mPrefixLength = 0;
+    size_t mSessionLength = 0;
+    uint32_t mPrefixSum = 0;
+    uint32_t mSessionSum = 0;
+    bool mValid = false;
+};
@@ -0,0 +1,427 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Rounding applied when a value has to drop decimal places.
+ */
+enum class Rounding {
+    TRUNCATE,   ///< Toward zero
+    FLOOR,      ///< Toward negative infinity (e.g. sell-side tick rounding)
+    CEIL,       ///< Toward positive infinity (e.g. buy-side tick rounding)
+    NEAREST,    ///< Half away from zero
+};
+
+namespace fixed_point_detail {
+
+constexpr int64_t pow10(unsigned n) noexcept {
+    int64_t value = 1;
+    while (n--) value *= 10;
+    return value;
+}
+
+constexpr uint64_t POW10[20] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+    100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+    10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+    100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull};
+
+/**
+ * @brief Integer division with the given rounding (divisor > 0).
+ */
+constexpr int64_t divide(int64_t value, int64_t divisor, Rounding rounding) noexcept {
+    int64_t quotient = value / divisor;
+    int64_t remainder = value % divisor;
+    if (remainder == 0) {
+        return quotient;
+    }
+    switch (rounding) {
+        case Rounding::TRUNCATE:
+            return quotient;
+        case Rounding::FLOOR:
+            return value < 0 ? quotient - 1 : quotient;
+        case Rounding::CEIL:
+            return value < 0 ? quotient : quotient + 1;
+        case Rounding::NEAREST:
+        default: {
+            int64_t twice = remainder < 0 ? -2 * remainder : 2 * remainder;
+            if (twice >= divisor) {
+                return value < 0 ? quotient - 1 : quotient + 1;
+            }
+            return quotient;
+        }
+    }
+}
+
+/**
+ * @brief Write an unsigned integer, two digits per step; returns the length.
+ */
+inline size_t write_uint(uint64_t value, char* out) noexcept {
+    static constexpr char PAIRS[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    char buffer[20];
+    char* p = buffer + sizeof(buffer);
+    while (value >= 100) {
+        unsigned pair = unsigned(value % 100) * 2;
+        value /= 100;
+        *--p = PAIRS[pair + 1];
+        *--p = PAIRS[pair];
+    }
+    if (value >= 10) {
+        *--p = PAIRS[value * 2 + 1];
+        *--p = PAIRS[value * 2];
+    } else {
+        *--p = char('0' + value);
+    }
+    size_t length = buffer + sizeof(buffer) - p;
+    std::memcpy(out, p, length);
+    return length;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+/**
+ * @brief Convert 16 ASCII digits to an integer (SSSE3 multiply-add, SSE4.1 pack).
+ *
+ * @return false if any of the 16 bytes is not a digit.
+ */
+__attribute__((target("sse4.1")))
+inline bool digits16_sse41(const char* text, uint64_t& value) noexcept {
+    __m128i chunk = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text)),
+                                 _mm_set1_epi8('0'));
+    // Bytes below '0' wrap to >= 0xD0, so one unsigned max catches both sides
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(chunk, _mm_set1_epi8(9)),
+                                         _mm_set1_epi8(9))) != 0xFFFF) {
+        return false;
+    }
+    chunk = _mm_maddubs_epi16(chunk, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1,
+                                                   10, 1, 10, 1, 10, 1, 10, 1));
+    chunk = _mm_madd_epi16(chunk, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+    chunk = _mm_packus_epi32(chunk, chunk);
+    chunk = _mm_madd_epi16(chunk, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+    value = uint64_t(uint32_t(_mm_cvtsi128_si32(chunk))) * 100000000ull +
+            uint32_t(_mm_extract_epi32(chunk, 1));
+    return true;
+}
+
+inline bool has_sse41() noexcept {
+    static const bool supported = __builtin_cpu_supports("sse4.1");
+    return supported;
+}
+#endif
+
+}  // namespace fixed_point_detail
+
+/**
+ * @brief Decimal fixed-point number with a compile-time number of decimals.
+ *
+ * Prices and quantities are stored as a signed 64-bit count of 10^-DECIMALS
+ * units, so "100.25" is exactly 10025 at 2 decimals. Addition, subtraction,
+ * comparison and multiplication are exact integer operations; dropping
+ * decimals (rescale, tick rounding) always names its rounding mode.
+ *
+ * @tparam DECIMALS Decimal places, at most 15.
+ *
+ * Features:
+ * - Trivially copyable 8-byte value, flows through every queue as a memcpy
+ * - Exact products: Price * Quantity yields FixedPoint<P + Q> without rounding
+ * - ASCII parse (FIX) with an SSE4.1 digit path, chosen at runtime
+ * - Binary feed conversion from any other scale via from_scaled()
+ *
+ * Usage Constraints:
+ * - Values outside +/- INT64_MAX units are rejected by parse() and are the
+ *   caller's responsibility for arithmetic (as with int64_t); products add
+ *   the decimals of both sides, so pick scales with the range in mind
+ */
+template<unsigned DECIMALS>
+class FixedPoint {
+    static_assert(DECIMALS <= 15, "FixedPoint supports up to 15 decimals");
+
+public:
+    static constexpr unsigned decimals = DECIMALS;
+    static constexpr int64_t SCALE = fixed_point_detail::pow10(DECIMALS);
+
+    /// Longest output of format(): sign, 19 integer digits, dot, decimals
+    static constexpr size_t MAX_CHARS = 1 + 19 + 1 + DECIMALS;
+
+    constexpr FixedPoint() noexcept = default;
+
+    /**
+     * @brief Construct from a raw count of 10^-DECIMALS units.
+     */
+    static constexpr FixedPoint from_raw(int64_t raw) noexcept {
+        FixedPoint value;
+        value.mRaw = raw;
+        return value;
+    }
+
+    /**
+     * @brief Construct from whole units (e.g. 100 -> "100.00").
+     */
+    static constexpr FixedPoint from_int(int64_t units) noexcept {
+        return from_raw(units * SCALE);
+    }
+
+    /**
+     * @brief Convert a scaled integer from a binary feed with FROM decimals.
+     */
+    template<unsigned FROM>
+    static constexpr FixedPoint from_scaled(int64_t raw, Rounding rounding = Rounding::NEAREST) noexcept {
+        return FixedPoint<FROM>::from_raw(raw).template rescale<DECIMALS>(rounding);
+    }
+
+    /**
+     * @brief Get the raw count of 10^-DECIMALS units.
+     */
+    constexpr int64_t raw() const noexcept {
+        return mRaw;
+    }
+
+    /**
+     * @brief Approximate value for display and analytics; never for pricing.
+     */
+    constexpr double to_double() const noexcept {
+        return double(mRaw) / double(SCALE);
+    }
+
+    /**
+     * @brief Convert to another number of decimals.
+     *
+     * Widening is exact; narrowing applies the rounding mode.
+     */
+    template<unsigned TO>
+    constexpr FixedPoint<TO> rescale(Rounding rounding = Rounding::NEAREST) const noexcept {
+        if constexpr (TO >= DECIMALS) {
+            return FixedPoint<TO>::from_raw(mRaw * fixed_point_detail::pow10(TO - DECIMALS));
+        } else {
+            return FixedPoint<TO>::from_raw(
+                fixed_point_detail::divide(mRaw, fixed_point_detail::pow10(DECIMALS - TO), rounding));
+        }
+    }
+
+    /**
+     * @brief Round to a multiple of a tick size (same scale).
+     */
+    constexpr FixedPoint round_to(FixedPoint tick, Rounding rounding) const noexcept {
+        return from_raw(fixed_point_detail::divide(mRaw, tick.mRaw, rounding) * tick.mRaw);
+    }
+
+    constexpr FixedPoint operator-() const noexcept { return from_raw(-mRaw); }
+
+    constexpr FixedPoint& operator+=(FixedPoint other) noexcept {
+        mRaw += other.mRaw;
+        return *this;
+    }
+
+    constexpr FixedPoint& operator-=(FixedPoint other) noexcept {
+        mRaw -= other.mRaw;
+        return *this;
+    }
+
+    friend constexpr FixedPoint operator+(FixedPoint a, FixedPoint b) noexcept { return a += b; }
+    friend constexpr FixedPoint operator-(FixedPoint a, FixedPoint b) noexcept { return a -= b; }
+    friend constexpr FixedPoint operator*(FixedPoint a, int64_t n) noexcept { return from_raw(a.mRaw * n); }
+    friend constexpr FixedPoint operator*(int64_t n, FixedPoint a) noexcept { return from_raw(a.mRaw * n); }
+
+    /**
+     * @brief Exact product; the result carries the decimals of both operands.
+     */
+    template<unsigned OTHER>
+    friend constexpr FixedPoint<DECIMALS + OTHER> operator*(FixedPoint a, FixedPoint<OTHER> b) noexcept {
+        return FixedPoint<DECIMALS + OTHER>::from_raw(a.raw() * b.raw());
+    }
+
+    friend constexpr bool operator==(FixedPoint, FixedPoint) noexcept = default;
+    friend constexpr auto operator<=>(FixedPoint, FixedPoint) noexcept = default;
+
+    /**
+     * @brief Parse decimal ASCII such as "-123.45" (FIX price/qty fields).
+     *
+     * Accepts an optional '-', digits with at most one '.', and more decimals
+     * than DECIMALS only if the extra ones are zero (no silent rounding).
+     *
+     * @return false on malformed input or overflow; out is left unchanged.
+     *
+     * Uses parse_sse41() when the CPU supports it, parse_scalar() otherwise.
+     */
+    static bool parse(std::string_view text, FixedPoint& out) noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        if (fixed_point_detail::has_sse41()) {
+            return parse_sse41(text, out);
+        }
+#endif
+        return parse_scalar(text, out);
+    }
+
+    /**
+     * @brief Portable parser; same contract as parse().
+     */
+    static bool parse_scalar(std::string_view text, FixedPoint& out) noexcept {
+        size_t i = 0;
+        bool negative = false;
+        if (i < text.size() && text[i] == '-') {
+            negative = true;
+            ++i;
+        }
+
+        uint64_t integer = 0;
+        size_t digits = 0;
+        for (; i < text.size() && is_digit(text[i]); ++i, ++digits) {
+            if (__builtin_mul_overflow(integer, 10u, &integer) ||
+                __builtin_add_overflow(integer, uint64_t(text[i] - '0'), &integer)) {
+                return false;
+            }
+        }
+
+        uint64_t fraction = 0;
+        if (i < text.size() && text[i] == '.') {
+            ++i;
+            size_t places = 0;
+            for (; i < text.size() && is_digit(text[i]); ++i, ++places, ++digits) {
+                if (places < DECIMALS) {
+                    fraction = fraction * 10 + uint64_t(text[i] - '0');
+                } else if (text[i] != '0') {
+                    return false;   // more precision than the type holds
+                }
+            }
+            if (places < DECIMALS) {
+                fraction *= fixed_point_detail::POW10[DECIMALS - places];
+            }
+        }
+
+        if (i != text.size() || digits == 0) {
+            return false;
+        }
+        return combine(negative, integer, fraction, out);
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    /**
+     * @brief SSE4.1 parser; same contract as parse().
+     *
+     * Copies the text into a '0'-filled buffer, then converts the integer
+     * part (right-aligned window) and the fraction (left-aligned window) with
+     * one 16-digit SIMD conversion each. Inputs with more than 16 integer or
+     * fraction digits fall back to parse_scalar().
+     *
+     * Note: Requires SSE4.1; call through parse() unless the CPU is known.
+     */
+    static bool parse_sse41(std::string_view text, FixedPoint& out) noexcept {
+        bool negative = !text.empty() && text[0] == '-';
+        std::string_view body = text.substr(negative);
+        if (body.size() > 32) {
+            return parse_scalar(text, out);
+        }
+
+        size_t dot = body.find('.');
+        size_t intLen = dot == std::string_view::npos ? body.size() : dot;
+        size_t fracLen = dot == std::string_view::npos ? 0 : body.size() - dot - 1;
+        if (intLen > 16 || fracLen > 16) {
+            return parse_scalar(text, out);
+        }
+        if (intLen + fracLen == 0) {
+            return false;
+        }
+
+        // 16 bytes of '0' on either side make both windows safe to load
+        alignas(16) char buffer[64];
+        std::memset(buffer, '0', sizeof(buffer));
+        std::memcpy(buffer + 16, body.data(), body.size());
+
+        uint64_t integer = 0;
+        if (!fixed_point_detail::digits16_sse41(buffer + intLen, integer)) {
+            return false;
+        }
+
+        uint64_t fraction = 0;
+        if (dot != std::string_view::npos) {
+            uint64_t window = 0;
+            if (!fixed_point_detail::digits16_sse41(buffer + 16 + dot + 1, window)) {
+                return false;   // also rejects a second '.'
+            }
+            // window = fraction digits * 10^(16 - fracLen); extra decimals must be zero
+            constexpr uint64_t DROP = fixed_point_detail::POW10[16 - DECIMALS];
+            if (window % DROP != 0) {
+                return false;
+            }
+            fraction = window / DROP;
+        }
+        return combine(negative, integer, fraction, out);
+    }
+#endif
+
+    /**
+     * @brief Write the value as ASCII, without trailing fractional zeros.
+     *
+     * @param out Buffer of at least MAX_CHARS bytes.
+     * @return size_t Number of characters written (no terminator).
+     */
+    size_t format(char* out) const noexcept {
+        char* p = out;
+        uint64_t magnitude = uint64_t(mRaw);
+        if (mRaw < 0) {
+            *p++ = '-';
+            magnitude = 0 - magnitude;
+        }
+        p += fixed_point_detail::write_uint(magnitude / uint64_t(SCALE), p);
+
+        uint64_t fraction = magnitude % uint64_t(SCALE);
+        if (fraction != 0) {
+            unsigned places = DECIMALS;
+            while (fraction % 10 == 0) {
+                fraction /= 10;
+                --places;
+            }
+            *p++ = '.';
+            char digits[20];
+            size_t length = fixed_point_detail::write_uint(fraction, digits);
+            for (size_t pad = length; pad < places; ++pad) {
+                *p++ = '0';
+            }
+            std::memcpy(p, digits, length);
+            p += length;
+        }
+        return p - out;
+    }
+
+    std::string to_string() const {
+        char buffer[MAX_CHARS];
+        return std::string(buffer, format(buffer));
+    }
+
+private:
+    static constexpr bool is_digit(char c) noexcept {
+        return c >= '0' && c <= '9';
+    }
+
+    static bool combine(bool negative, uint64_t integer, uint64_t fraction, FixedPoint& out) noexcept {
+        uint64_t raw;
+        if (__builtin_mul_overflow(integer, uint64_t(SCALE), &raw) ||
+            __builtin_add_overflow(raw, fraction, &raw) || raw > uint64_t(INT64_MAX)) {
+            return false;
+        }
+        out.mRaw = negative ? -int64_t(raw) : int64_t(raw);
+        return true;
+    }
+
+    int64_t mRaw = 0;
+};
+
+/// Prices: 6 decimals covers equity sub-penny and FX pip fractions
+using Price = FixedPoint<6>;
+
+/// Quantities: 2 decimals covers fractional shares
+using Quantity = FixedPoint<2>;
+
+/// Price * Quantity, exact up to about 9.2e10 units of currency
+using Notional = FixedPoint<8>;
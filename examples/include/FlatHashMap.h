@@ -0,0 +1,377 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Default hasher: std::hash followed by a 64-bit finaliser.
+ *
+ * std::hash is the identity for integers on common standard libraries, which
+ * would put sequential order ids into sequential slots and leave the 7-bit
+ * tag with no entropy. The murmur3 finaliser spreads every input bit.
+ */
+template<typename K>
+struct FlatHash {
+    size_t operator()(const K& key) const noexcept {
+        uint64_t h = std::hash<K>{}(key);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+};
+
+/**
+ * @brief A flat, open-addressed hash map with SwissTable-style control bytes.
+ *
+ * Built for order-id and symbol lookups on the hot path, where node-based
+ * std::unordered_map spends most of its time chasing pointers. Every key has
+ * one control byte holding a 7-bit tag of its hash; a lookup compares 16
+ * control bytes against the tag with one SSE2 instruction and only touches
+ * slots whose tag matches.
+ *
+ * @tparam K Key type. Must be trivially copyable and equality comparable.
+ * @tparam V Value type. Must be trivially copyable.
+ * @tparam Hash Hash functor; see FlatHash.
+ *
+ * Features:
+ * - Preallocated: capacity is fixed at construction, never rehashes
+ * - SIMD probing: 16 control bytes per compare (scalar fallback without SSE2)
+ * - Tombstone-free: erase() shifts the following run back (linear probing),
+ *   so lookups never slow down after churn
+ * - Single-writer / multi-reader mode through find_concurrent()
+ *
+ * Layout:
+ * - Control bytes: EMPTY (0x80) or the 7-bit tag; the first GROUP bytes are
+ *   mirrored after the end so a group load never needs to wrap
+ * - Slots: key/value pairs in a separate array, same index as the control byte
+ *
+ * Concurrency:
+ * - The writer wraps every mutation in a sequence counter (odd = in progress)
+ * - find_concurrent() retries when the counter moved during its lookup, like
+ *   the value copy in ConflatingQueue
+ *
+ * Usage Constraints:
+ * - Exactly ONE thread may call insert()/assign()/erase()/clear()
+ * - find() is for the writer thread or for single-threaded use
+ * - Any number of threads may call find_concurrent() concurrently with the writer
+ */
+template<typename K, typename V, typename Hash = FlatHash<K>>
+class FlatHashMap {
+    static_assert(std::is_trivially_copyable_v<K> && std::is_trivially_copyable_v<V>,
+                  "FlatHashMap keys and values are read optimistically and must be trivially copyable");
+
+public:
+    /**
+     * @brief Allocate a table for up to maxElements keys.
+     *
+     * The slot count is the next power of two giving a load factor of at most 7/8.
+     */
+    explicit FlatHashMap(size_t maxElements) {
+        size_t slots = GROUP;
+        while (slots - slots / 8 < maxElements) {
+            slots <<= 1;
+        }
+        mMask = slots - 1;
+        mMaxElements = slots - slots / 8;
+        mCtrl.reset(new (std::align_val_t(GROUP)) uint8_t[slots + GROUP]);
+        mSlots.reset(new Slot[slots]);
+        std::memset(mCtrl.get(), EMPTY, slots + GROUP);
+    }
+
+    FlatHashMap(const FlatHashMap&) = delete;
+    FlatHashMap& operator=(const FlatHashMap&) = delete;
+
+    /**
+     * @brief Insert a new key.
+     *
+     * @return true if the key was inserted.
+     * @return false if the key already exists or the table is full.
+     *
+     * Thread Safety: May ONLY be called by the writer thread.
+     */
+    bool insert(const K& key, const V& value) noexcept {
+        if (mSize == mMaxElements) {
+            return false;
+        }
+        size_t hash = mHash(key);
+        if (lookup(key, hash) != NOT_FOUND) {
+            return false;
+        }
+
+        // Linear probing: the key goes to the first empty slot after its home
+        size_t pos = home(hash);
+        while (true) {
+            uint32_t empty = match(pos, EMPTY);
+            if (empty) {
+                size_t index = (pos + __builtin_ctz(empty)) & mMask;
+                begin_write();
+                mSlots[index].key = key;
+                mSlots[index].value = value;
+                set_ctrl(index, tag(hash));
+                end_write();
+                ++mSize;
+                return true;
+            }
+            pos = (pos + GROUP) & mMask;
+        }
+    }
+
+    /**
+     * @brief Insert a key or overwrite its value.
+     *
+     * @return false only if the key is new and the table is full.
+     *
+     * Thread Safety: May ONLY be called by the writer thread.
+     */
+    bool assign(const K& key, const V& value) noexcept {
+        size_t index = lookup(key, mHash(key));
+        if (index == NOT_FOUND) {
+            return insert(key, value);
+        }
+        begin_write();
+        mSlots[index].value = value;
+        end_write();
+        return true;
+    }
+
+    /**
+     * @brief Find a key (writer or single-threaded use).
+     *
+     * @return V* Pointer to the value, or nullptr. Writes through the pointer
+     *         are not seen consistently by find_concurrent(); use assign().
+     */
+    V* find(const K& key) noexcept {
+        size_t index = lookup(key, mHash(key));
+        return index == NOT_FOUND ? nullptr : &mSlots[index].value;
+    }
+
+    const V* find(const K& key) const noexcept {
+        size_t index = lookup(key, mHash(key));
+        return index == NOT_FOUND ? nullptr : &mSlots[index].value;
+    }
+
+    /**
+     * @brief Find a key while the writer may be mutating the table.
+     *
+     * @param key The key to look up.
+     * @param value Receives a copy of the value.
+     * @return true if the key was present at some point during the call.
+     *
+     * Thread Safety: Safe from any number of reader threads concurrently
+     * with one writer. Retries while a write overlaps the lookup.
+     */
+    bool find_concurrent(const K& key, V& value) const noexcept {
+        size_t hash = mHash(key);
+        while (true) {
+            uint64_t before = mVersion.load(std::memory_order_acquire);
+            if (before & 1) {
+                cpu_relax();
+                continue;
+            }
+
+            size_t index = lookup(key, hash);
+            bool found = index != NOT_FOUND;
+            if (found) {
+                std::memcpy(&value, &mSlots[index].value, sizeof(V));
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (mVersion.load(std::memory_order_relaxed) == before) {
+                return found;
+            }
+        }
+    }
+
+    /**
+     * @brief Remove a key.
+     *
+     * The entries after it in the probe run are shifted back into the hole,
+     * so no tombstone is left behind.
+     *
+     * @return true if the key was present.
+     *
+     * Thread Safety: May ONLY be called by the writer thread.
+     */
+    bool erase(const K& key) noexcept {
+        size_t hole = lookup(key, mHash(key));
+        if (hole == NOT_FOUND) {
+            return false;
+        }
+
+        begin_write();
+        size_t next = hole;
+        while (true) {
+            next = (next + 1) & mMask;
+            if (mCtrl[next] == EMPTY) {
+                break;
+            }
+            // Move the entry back unless that would put it before its home slot
+            size_t entryHome = home(mHash(mSlots[next].key));
+            if (((next - entryHome) & mMask) >= ((next - hole) & mMask)) {
+                mSlots[hole] = mSlots[next];
+                set_ctrl(hole, mCtrl[next]);
+                hole = next;
+            }
+        }
+        set_ctrl(hole, EMPTY);
+        end_write();
+        --mSize;
+        return true;
+    }
+
+    /**
+     * @brief Remove every key.
+     *
+     * Thread Safety: May ONLY be called by the writer thread.
+     */
+    void clear() noexcept {
+        begin_write();
+        std::memset(mCtrl.get(), EMPTY, mMask + 1 + GROUP);
+        end_write();
+        mSize = 0;
+    }
+
+    /**
+     * @brief Visit every entry as fn(const K&, const V&) (writer or single-threaded use).
+     */
+    template<typename F>
+    void for_each(F&& fn) const {
+        for (size_t i = 0; i <= mMask; ++i) {
+            if (mCtrl[i] != EMPTY) {
+                fn(mSlots[i].key, mSlots[i].value);
+            }
+        }
+    }
+
+    /**
+     * @brief Get the number of keys (writer thread).
+     */
+    size_t size() const noexcept {
+        return mSize;
+    }
+
+    bool empty() const noexcept {
+        return mSize == 0;
+    }
+
+    /**
+     * @brief Get the maximum number of keys the table accepts.
+     */
+    size_t capacity() const noexcept {
+        return mMaxElements;
+    }
+
+private:
+    // Cache line size to keep the reader-polled version away from writer state
+    static constexpr size_t CACHE_LINE = std::hardware_destructive_interference_size;
+
+    static constexpr size_t GROUP = 16;              ///< Control bytes per SIMD compare
+    static constexpr uint8_t EMPTY = 0x80;           ///< Control byte of a free slot
+    static constexpr size_t NOT_FOUND = ~size_t{0};
+
+    struct Slot {
+        K key;
+        V value;
+    };
+
+    struct AlignedDelete {
+        void operator()(uint8_t* p) const noexcept {
+            ::operator delete[](p, std::align_val_t(GROUP));
+        }
+    };
+
+    static void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    size_t home(size_t hash) const noexcept {
+        return (hash >> 7) & mMask;
+    }
+
+    static uint8_t tag(size_t hash) noexcept {
+        return hash & 0x7F;
+    }
+
+    /**
+     * @brief Bitmask of the control bytes in [pos, pos + GROUP) equal to value.
+     */
+    uint32_t match(size_t pos, uint8_t value) const noexcept {
+#if defined(__SSE2__)
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mCtrl.get() + pos));
+        return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(char(value)))));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP; ++i) {
+            mask |= uint32_t(mCtrl[pos + i] == value) << i;
+        }
+        return mask;
+#endif
+    }
+
+    /**
+     * @brief Probe for a key, returning its slot index or NOT_FOUND.
+     *
+     * Linear probing keeps every key in the unbroken run that starts at its
+     * home slot, so the probe can stop at the first group containing EMPTY.
+     */
+    size_t lookup(const K& key, size_t hash) const noexcept {
+        size_t pos = home(hash);
+        uint8_t t = tag(hash);
+        for (size_t probed = 0; probed <= mMask; probed += GROUP) {
+            uint32_t hits = match(pos, t);
+            while (hits) {
+                size_t index = (pos + __builtin_ctz(hits)) & mMask;
+                if (mSlots[index].key == key) {
+                    return index;
+                }
+                hits &= hits - 1;
+            }
+            if (match(pos, EMPTY)) {
+                return NOT_FOUND;
+            }
+            pos = (pos + GROUP) & mMask;
+        }
+        return NOT_FOUND;
+    }
+
+    void set_ctrl(size_t index, uint8_t value) noexcept {
+        mCtrl[index] = value;
+        if (index < GROUP) {
+            mCtrl[mMask + 1 + index] = value;  // mirror for wrap-free group loads
+        }
+    }
+
+    void begin_write() noexcept {
+        mVersion.store(mVersion.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void end_write() noexcept {
+        mVersion.store(mVersion.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    std::unique_ptr<uint8_t[], AlignedDelete> mCtrl;
+    std::unique_ptr<Slot[]> mSlots;
+    size_t mMask = 0;
+    size_t mMaxElements = 0;
+    size_t mSize = 0;
+    [[no_unique_address]] Hash mHash;
+
+    // Sequence counter polled by find_concurrent(), odd while a write is in progress
+    alignas(CACHE_LINE) std::atomic<uint64_t> mVersion{0};
+};
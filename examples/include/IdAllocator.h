@@ -0,0 +1,217 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace id_detail {
+
+// Leaf words per cache line: hints start threads on different lines
+constexpr uint32_t LEAVES_PER_LINE = 8;
+
+/**
+ * @brief Leaf index the calling thread last allocated from; seeded from the
+ *        thread id so threads start on different cache lines.
+ */
+inline uint32_t& thread_hint() noexcept {
+    thread_local uint32_t hint =
+        uint32_t(std::hash<std::thread::id>()(std::this_thread::get_id())) * LEAVES_PER_LINE;
+    return hint;
+}
+
+}  // namespace id_detail
+
+/**
+ * @brief Lock-free allocator of small integer ids over atomic bitmap words.
+ *
+ * Ids [0, capacity) are bits in 64-bit leaf words (1 = free). A second
+ * level of summary words has one bit per leaf, set while the leaf may have
+ * a free bit, so allocate() finds a candidate leaf with one countr_zero
+ * (tzcnt) on a summary word and a free id with another on the leaf, and
+ * skips full regions 4096 ids at a time.
+ *
+ * A bit is claimed with fetch_and on the leaf: the returned old value says
+ * whether this thread won it, so there is no CAS retry when other bits of
+ * the same word change. Each thread starts searching at the leaf it last
+ * allocated from, which keeps threads on different words (and cache
+ * lines) and makes allocation mostly uncontended.
+ *
+ * Features:
+ * - No per-id nodes: 1 bit per id plus 1 bit per 64 ids
+ * - allocate()/release() are lock-free; release() reports double frees
+ * - Summary bits are only hints: a leaf's bit is re-set if a release races
+ *   with its clearing, and a full scan backs up the search before
+ *   allocate() reports exhaustion
+ *
+ * Usage Constraints:
+ * - Capacity is fixed at construction (up to 2^32 - 1 ids)
+ * - Ids come back in no particular order
+ */
+class IdAllocator {
+public:
+    /**
+     * @brief Construct with all ids in [0, capacity) free.
+     */
+    explicit IdAllocator(uint32_t capacity)
+        : mCapacity(capacity),
+          mLeafCount(uint32_t((uint64_t(capacity) + 63) / 64)),
+          mSummaryCount((mLeafCount + 63) / 64),
+          mLeaves(std::make_unique<std::atomic<uint64_t>[]>(mLeafCount)),
+          mSummary(std::make_unique<std::atomic<uint64_t>[]>(mSummaryCount)) {
+        for (uint32_t leaf = 0; leaf < mLeafCount; ++leaf) {
+            uint32_t bits = leaf + 1 < mLeafCount || capacity % 64 == 0 ? 64 : capacity % 64;
+            mLeaves[leaf].store(bits == 64 ? ~uint64_t{0} : (uint64_t{1} << bits) - 1, std::memory_order_relaxed);
+        }
+        for (uint32_t s = 0; s < mSummaryCount; ++s) {
+            uint32_t leaves = s + 1 < mSummaryCount || mLeafCount % 64 == 0 ? 64 : mLeafCount % 64;
+            mSummary[s].store(leaves == 64 ? ~uint64_t{0} : (uint64_t{1} << leaves) - 1, std::memory_order_relaxed);
+        }
+    }
+
+    IdAllocator(const IdAllocator&) = delete;
+    IdAllocator& operator=(const IdAllocator&) = delete;
+
+    /**
+     * @brief Allocate a free id.
+     *
+     * @param id Receives the allocated id.
+     * @return true if an id was allocated.
+     * @return false if every id is in use.
+     *
+     * Thread Safety: Safe to call from multiple threads concurrently.
+     *
+     * Memory Ordering: acquire, pairs with the release in release(), so the
+     * previous owner's writes to state indexed by the id are visible.
+     *
+     * Time Complexity: O(1) typically; O(capacity / 64) when nearly full
+     */
+    bool allocate(uint32_t& id) noexcept {
+        if (mLeafCount == 0) {
+            return false;
+        }
+        uint32_t& hint = id_detail::thread_hint();
+        uint32_t startLeaf = hint % mLeafCount;
+
+        for (uint32_t n = 0; n < mSummaryCount; ++n) {
+            uint32_t s = (startLeaf / 64 + n) % mSummaryCount;
+            // Start from the hinted leaf within the first summary word
+            uint32_t shift = n == 0 ? startLeaf % 64 : 0;
+            uint64_t candidates = std::rotr(mSummary[s].load(std::memory_order_relaxed), int(shift));
+            while (candidates != 0) {
+                uint32_t leaf = s * 64 + (uint32_t(std::countr_zero(candidates)) + shift) % 64;
+                if (claim(leaf, id)) {
+                    hint = leaf;
+                    return true;
+                }
+                candidates &= candidates - 1;
+            }
+        }
+
+        // Summary bits may be transiently clear; confirm with a full scan
+        for (uint32_t leaf = 0; leaf < mLeafCount; ++leaf) {
+            if (claim(leaf, id)) {
+                hint = leaf;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Return an id to the allocator.
+     *
+     * @return false if the id was out of range or not allocated (double free).
+     *
+     * Thread Safety: Safe to call from multiple threads concurrently.
+     *
+     * Time Complexity: O(1)
+     */
+    bool release(uint32_t id) noexcept {
+        if (id >= mCapacity) {
+            return false;
+        }
+        uint32_t leaf = id / 64;
+        uint64_t bit = uint64_t{1} << (id % 64);
+        uint64_t old = mLeaves[leaf].fetch_or(bit, std::memory_order_seq_cst);
+        if (old & bit) {
+            return false;
+        }
+        // seq_cst with the clear-then-recheck in mark_empty(): one of the two
+        // sides always leaves the summary bit set
+        std::atomic<uint64_t>& summary = mSummary[leaf / 64];
+        uint64_t mask = uint64_t{1} << (leaf % 64);
+        if (!(summary.load(std::memory_order_seq_cst) & mask)) {
+            summary.fetch_or(mask, std::memory_order_seq_cst);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Check whether an id is currently allocated (a snapshot).
+     */
+    bool is_allocated(uint32_t id) const noexcept {
+        return id < mCapacity && !(mLeaves[id / 64].load(std::memory_order_relaxed) & (uint64_t{1} << (id % 64)));
+    }
+
+    /**
+     * @brief Get the number of free ids (a snapshot).
+     *
+     * Time Complexity: O(capacity / 64)
+     */
+    size_t available() const noexcept {
+        size_t total = 0;
+        for (uint32_t leaf = 0; leaf < mLeafCount; ++leaf) {
+            total += size_t(std::popcount(mLeaves[leaf].load(std::memory_order_relaxed)));
+        }
+        return total;
+    }
+
+    uint32_t capacity() const noexcept {
+        return mCapacity;
+    }
+
+private:
+    /**
+     * @brief Try to take the lowest free bit of a leaf.
+     */
+    bool claim(uint32_t leaf, uint32_t& id) noexcept {
+        std::atomic<uint64_t>& word = mLeaves[leaf];
+        uint64_t bits = word.load(std::memory_order_relaxed);
+        while (bits != 0) {
+            uint64_t bit = bits & (~bits + 1);
+            uint64_t old = word.fetch_and(~bit, std::memory_order_acquire);
+            if (old & bit) {
+                if ((old & ~bit) == 0) {
+                    mark_empty(leaf);
+                }
+                id = leaf * 64 + uint32_t(std::countr_zero(bit));
+                return true;
+            }
+            bits = old & ~bit;   // another thread took it: retry with what is left
+        }
+        mark_empty(leaf);
+        return false;
+    }
+
+    void mark_empty(uint32_t leaf) noexcept {
+        std::atomic<uint64_t>& summary = mSummary[leaf / 64];
+        uint64_t mask = uint64_t{1} << (leaf % 64);
+        if (!(summary.load(std::memory_order_relaxed) & mask)) {
+            return;
+        }
+        summary.fetch_and(~mask, std::memory_order_seq_cst);
+        if (mLeaves[leaf].load(std::memory_order_seq_cst) != 0) {
+            summary.fetch_or(mask, std::memory_order_seq_cst);   // a release raced with the clear
+        }
+    }
+
+    const uint32_t mCapacity;
+    const uint32_t mLeafCount;
+    const uint32_t mSummaryCount;
+    std::unique_ptr<std::atomic<uint64_t>[]> mLeaves;
+    std::unique_ptr<std::atomic<uint64_t>[]> mSummary;
+};
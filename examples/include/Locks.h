@@ -0,0 +1,427 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace lock_detail {
+
+constexpr size_t CACHE_LINE = std::hardware_destructive_interference_size;
+
+// Spins before a waiter yields its time slice (spin locks only)
+constexpr uint32_t SPINS_BEFORE_YIELD = 1024;
+
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+/**
+ * @brief Pause, and yield once every SPINS_BEFORE_YIELD calls so a
+ *        preempted lock holder can run.
+ */
+inline void spin_wait(uint32_t& spins) noexcept {
+    if (++spins % SPINS_BEFORE_YIELD == 0) {
+        std::this_thread::yield();
+    } else {
+        cpu_relax();
+    }
+}
+
+/**
+ * @brief Sleep while *word == expected (returns early on wake or signal).
+ */
+inline void futex_wait(std::atomic<uint32_t>& word, uint32_t expected) noexcept {
+#if defined(__linux__)
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+    word.wait(expected, std::memory_order_relaxed);
+#endif
+}
+
+inline void futex_wake_one(std::atomic<uint32_t>& word) noexcept {
+#if defined(__linux__)
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+    word.notify_one();
+#endif
+}
+
+}  // namespace lock_detail
+
+/**
+ * @brief Spin-then-futex mutex with an adaptive spin budget.
+ *
+ * The lock word is 0 (free), 1 (held) or 2 (held, sleepers possible).
+ * An uncontended lock/unlock is one CAS and one RMW with no syscall. A
+ * contended lock first spins, because critical sections are usually
+ * shorter than a sleep/wake round trip, and only then marks the word 2 and
+ * sleeps on a futex; unlock() issues the wake syscall only if the word was
+ * 2. The spin budget follows how long recent acquisitions actually spun
+ * (as in glibc's adaptive mutex), and is halved whenever spinning fails,
+ * so a lock held for long goes to the futex after a few spins and a short
+ * one stops sleeping.
+ *
+ * Features:
+ * - Meets Lockable: works with std::lock_guard / std::unique_lock
+ * - No syscall unless a waiter actually sleeps
+ *
+ * Usage Constraints:
+ * - Not recursive; unlock only from the owning thread
+ */
+class AdaptiveMutex {
+public:
+    static constexpr uint32_t MAX_SPINS = 2000;
+
+    void lock() noexcept {
+        uint32_t expected = 0;
+        if (mState.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return;
+        }
+        lock_contended();
+    }
+
+    bool try_lock() noexcept {
+        uint32_t expected = 0;
+        return mState.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept {
+        if (mState.exchange(0, std::memory_order_release) == 2) {
+            lock_detail::futex_wake_one(mState);
+        }
+    }
+
+    /**
+     * @brief Get the current spin average; the next contended lock spins up to 2x + 10.
+     *
+     * Note: Approximate; intended for monitoring.
+     */
+    uint32_t spin_average() const noexcept {
+        return mSpinAverage.load(std::memory_order_relaxed);
+    }
+
+private:
+    void lock_contended() noexcept {
+        // Spin up to twice the recent average, read-only until the lock looks free
+        uint32_t average = mSpinAverage.load(std::memory_order_relaxed);
+        uint32_t limit = 2 * average + 10 < MAX_SPINS ? 2 * average + 10 : MAX_SPINS;
+        uint32_t spins = 0;
+        while (spins < limit) {
+            ++spins;
+            if (mState.load(std::memory_order_relaxed) == 0) {
+                uint32_t expected = 0;
+                if (mState.compare_exchange_weak(expected, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    mSpinAverage.store(average + (int32_t(spins) - int32_t(average)) / 8, std::memory_order_relaxed);
+                    return;
+                }
+            }
+            lock_detail::cpu_relax();
+        }
+        // Spinning did not pay off: the lock is held for long, spin less next time
+        mSpinAverage.store(average / 2, std::memory_order_relaxed);
+
+        // Sleep: taking the lock as 2 keeps the wake-up chain going for other sleepers
+        while (mState.exchange(2, std::memory_order_acquire) != 0) {
+            lock_detail::futex_wait(mState, 2);
+        }
+    }
+
+    alignas(lock_detail::CACHE_LINE) std::atomic<uint32_t> mState{0};
+    std::atomic<uint32_t> mSpinAverage{0};   ///< Heuristic only, races are harmless
+};
+
+/**
+ * @brief Fair (FIFO) ticket spinlock.
+ *
+ * lock() takes a ticket with one fetch_add and waits until the serving
+ * counter reaches it; unlock() advances the counter with a plain store.
+ * The two counters live on separate cache lines so arriving threads do
+ * not disturb the line the waiters poll. Waiters back off in proportion
+ * to their distance from the head of the queue.
+ *
+ * Features:
+ * - Strict FIFO: no starvation under contention
+ * - Meets Lockable
+ *
+ * Usage Constraints:
+ * - Spins (yielding occasionally); for short critical sections on
+ *   dedicated cores. A preempted waiter stalls everyone behind it.
+ */
+class TicketLock {
+public:
+    void lock() noexcept {
+        uint32_t ticket = mNext.fetch_add(1, std::memory_order_relaxed);
+        uint32_t spins = 0;
+        while (true) {
+            uint32_t serving = mServing.load(std::memory_order_acquire);
+            if (serving == ticket) {
+                return;
+            }
+            for (uint32_t i = ticket - serving; i > 1; --i) {
+                lock_detail::cpu_relax();   // proportional backoff
+            }
+            lock_detail::spin_wait(spins);
+        }
+    }
+
+    bool try_lock() noexcept {
+        uint32_t serving = mServing.load(std::memory_order_acquire);
+        uint32_t expected = serving;
+        return mNext.compare_exchange_strong(expected, serving + 1, std::memory_order_acquire,
+                                             std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept {
+        // Only the owner writes mServing
+        mServing.store(mServing.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Get the number of threads holding or waiting for the lock (a snapshot).
+     */
+    uint32_t queue_depth() const noexcept {
+        return mNext.load(std::memory_order_relaxed) - mServing.load(std::memory_order_relaxed);
+    }
+
+private:
+    alignas(lock_detail::CACHE_LINE) std::atomic<uint32_t> mNext{0};
+    alignas(lock_detail::CACHE_LINE) std::atomic<uint32_t> mServing{0};
+};
+
+/**
+ * @brief MCS queue lock: each waiter spins on its own cache line.
+ *
+ * Waiters form a linked queue through per-thread nodes; a waiter polls
+ * only the flag in its own node, and unlock() hands the lock to the
+ * successor by writing that one flag. Contention therefore costs one
+ * cache-line transfer per hand-off regardless of the number of waiters,
+ * where a ticket or test-and-set lock invalidates every waiter's line.
+ *
+ * Nodes are either passed explicitly (lock(Node&)/unlock(Node&), e.g. a
+ * Node on the stack), or taken from a small per-thread array by the plain
+ * lock()/unlock() so the lock also meets Lockable.
+ *
+ * Features:
+ * - FIFO hand-off, one exchange to enqueue
+ * - Local spinning: no shared line is polled while waiting
+ *
+ * Usage Constraints:
+ * - A node must stay alive and unused until its unlock() returns
+ * - Plain lock() supports up to MAX_HELD MCS locks held at once per thread
+ */
+class McsLock {
+public:
+    static constexpr size_t MAX_HELD = 8;
+
+    struct alignas(lock_detail::CACHE_LINE) Node {
+        std::atomic<Node*> next{nullptr};
+        std::atomic<bool> locked{false};
+    };
+
+    void lock(Node& node) noexcept {
+        node.next.store(nullptr, std::memory_order_relaxed);
+        node.locked.store(true, std::memory_order_relaxed);
+        Node* prev = mTail.exchange(&node, std::memory_order_acq_rel);
+        if (prev) {
+            prev->next.store(&node, std::memory_order_release);
+            uint32_t spins = 0;
+            while (node.locked.load(std::memory_order_acquire)) {
+                lock_detail::spin_wait(spins);
+            }
+        }
+    }
+
+    bool try_lock(Node& node) noexcept {
+        node.next.store(nullptr, std::memory_order_relaxed);
+        Node* expected = nullptr;
+        return mTail.compare_exchange_strong(expected, &node, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock(Node& node) noexcept {
+        Node* next = node.next.load(std::memory_order_acquire);
+        if (!next) {
+            Node* expected = &node;
+            if (mTail.compare_exchange_strong(expected, nullptr, std::memory_order_release,
+                                              std::memory_order_relaxed)) {
+                return;   // no successor
+            }
+            // A successor swapped the tail but has not linked itself yet
+            uint32_t spins = 0;
+            while (!(next = node.next.load(std::memory_order_acquire))) {
+                lock_detail::spin_wait(spins);
+            }
+        }
+        next->locked.store(false, std::memory_order_release);
+    }
+
+    void lock() noexcept {
+        Node& node = acquire_node();
+        lock(node);
+        mOwner = &node;   // protected by the lock itself
+    }
+
+    bool try_lock() noexcept {
+        Node& node = acquire_node();
+        if (!try_lock(node)) {
+            release_node(node);
+            return false;
+        }
+        mOwner = &node;
+        return true;
+    }
+
+    void unlock() noexcept {
+        Node* node = mOwner;
+        unlock(*node);
+        release_node(*node);
+    }
+
+private:
+    struct ThreadNodes {
+        std::array<Node, MAX_HELD> nodes;
+        uint32_t used = 0;   ///< Bit per node
+    };
+
+    static ThreadNodes& thread_nodes() noexcept {
+        thread_local ThreadNodes nodes;
+        return nodes;
+    }
+
+    static Node& acquire_node() noexcept {
+        ThreadNodes& pool = thread_nodes();
+        int free = __builtin_ctz(~pool.used);
+        assert(size_t(free) < MAX_HELD && "more than MAX_HELD McsLocks held by one thread");
+        pool.used |= 1u << free;
+        return pool.nodes[size_t(free)];
+    }
+
+    static void release_node(Node& node) noexcept {
+        ThreadNodes& pool = thread_nodes();
+        pool.used &= ~(1u << (&node - pool.nodes.data()));
+    }
+
+    alignas(lock_detail::CACHE_LINE) std::atomic<Node*> mTail{nullptr};
+    Node* mOwner = nullptr;
+};
+
+/**
+ * @brief Reader-writer lock for read-mostly data, with per-slot reader counts.
+ *
+ * A single shared reader counter makes every read_lock a cache-line
+ * transfer, which is what limits std::shared_mutex on read-mostly data.
+ * Here readers announce themselves on one of READER_SLOTS cache lines
+ * (chosen per thread), so concurrent readers on different slots touch
+ * nothing in common. A writer takes the writer mutex, raises the writer
+ * flag and waits for every slot to drain; readers that see the flag step
+ * back and wait, so writers are not starved.
+ *
+ * Features:
+ * - Read lock/unlock: two RMWs on a thread-private line when no writer
+ * - Writer preference
+ * - Meets SharedLockable (std::shared_lock) and Lockable (std::scoped_lock)
+ *
+ * Usage Constraints:
+ * - Writes cost O(READER_SLOTS) and spin; use for read-mostly state
+ * - Not recursive; a reader must not upgrade
+ */
+class RwLock {
+public:
+    static constexpr size_t READER_SLOTS = 16;
+
+    void lock_shared() noexcept {
+        std::atomic<int64_t>& slot = mReaders[reader_slot()].count;
+        while (true) {
+            // seq_cst pairs with the writer: it sees our count or we see its flag
+            slot.fetch_add(1, std::memory_order_seq_cst);
+            if (!mWriter.load(std::memory_order_seq_cst)) {
+                return;
+            }
+            slot.fetch_sub(1, std::memory_order_release);
+            uint32_t spins = 0;
+            while (mWriter.load(std::memory_order_acquire)) {
+                lock_detail::spin_wait(spins);
+            }
+        }
+    }
+
+    bool try_lock_shared() noexcept {
+        std::atomic<int64_t>& slot = mReaders[reader_slot()].count;
+        slot.fetch_add(1, std::memory_order_seq_cst);
+        if (!mWriter.load(std::memory_order_seq_cst)) {
+            return true;
+        }
+        slot.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+
+    void unlock_shared() noexcept {
+        // A thread keeps its slot, so this is the slot lock_shared() used
+        mReaders[reader_slot()].count.fetch_sub(1, std::memory_order_release);
+    }
+
+    void lock() noexcept {
+        mWriterMutex.lock();
+        mWriter.store(true, std::memory_order_seq_cst);
+        for (auto& slot : mReaders) {
+            uint32_t spins = 0;
+            while (slot.count.load(std::memory_order_seq_cst) != 0) {
+                lock_detail::spin_wait(spins);
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Take the write lock only if no writer holds it and no reader is in.
+     *
+     * Readers that arrive while the flag is raised step back as for lock(),
+     * so a failed attempt only delays them briefly.
+     */
+    bool try_lock() noexcept {
+        if (!mWriterMutex.try_lock()) {
+            return false;
+        }
+        mWriter.store(true, std::memory_order_seq_cst);
+        for (auto& slot : mReaders) {
+            if (slot.count.load(std::memory_order_seq_cst) != 0) {
+                mWriter.store(false, std::memory_order_release);
+                mWriterMutex.unlock();
+                return false;
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return true;
+    }
+
+    void unlock() noexcept {
+        mWriter.store(false, std::memory_order_release);
+        mWriterMutex.unlock();
+    }
+
+private:
+    struct alignas(lock_detail::CACHE_LINE) ReaderSlot {
+        std::atomic<int64_t> count{0};
+    };
+
+    static size_t reader_slot() noexcept {
+        static std::atomic<uint32_t> nextSlot{0};
+        thread_local size_t slot = nextSlot.fetch_add(1, std::memory_order_relaxed) % READER_SLOTS;
+        return slot;
+    }
+
+    std::array<ReaderSlot, READER_SLOTS> mReaders{};
+    alignas(lock_detail::CACHE_LINE) std::atomic<bool> mWriter{false};
+    AdaptiveMutex mWriterMutex;
+};
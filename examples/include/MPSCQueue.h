@@ -92,6 +92,54 @@ public:
         return true;
     }
 
+    /*
+     * Pop up to maxItems values, handing each one to fn(T&&) in FIFO order.
+     * Must only be called by the single consumer thread.
+     *
+     * Walks the linked nodes that are already published and frees the
+     * consumed dummies as it goes; head_ is written once at the end.
+     * Returns the number of values consumed (0 if the queue is empty).
+     */
+    template<typename F>
+    size_t pop_batch(F &&fn, size_t maxItems) noexcept {
+        auto head = head_;
+        size_t count = 0;
+        while (count < maxItems) {
+            auto next = head->next.load(std::memory_order_acquire);
+            if (!next) {
+                break;  // no more published nodes
+            }
+            fn(std::move(next->data));
+            delete head;
+            head = next;
+            ++count;
+        }
+        head_ = head;
+        return count;
+    }
+
+    /*
+     * Discard leading values for which pred(const T&) is true.
+     * Must only be called by the single consumer thread.
+     *
+     * Stops at the first value that does not match, or at the end of the
+     * published nodes. Returns the number of values discarded.
+     */
+    template<typename Pred>
+    size_t discard_front(Pred &&pred) noexcept {
+        size_t count = 0;
+        while (true) {
+            auto next = head_->next.load(std::memory_order_acquire);
+            if (!next || !pred(static_cast<const T &>(next->data))) {
+                break;
+            }
+            delete head_;
+            head_ = next;
+            ++count;
+        }
+        return count;
+    }
+
     /*
      * Returns true if the queue is empty.
      * Only safe to call from the consumer thread.
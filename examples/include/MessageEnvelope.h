@@ -0,0 +1,240 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace envelope_detail {
+
+/**
+ * @brief Slot alignment: the largest power of two dividing SIZE, at most a
+ *        cache line, so a cache-line envelope never straddles two lines.
+ */
+constexpr size_t slot_alignment(size_t size) noexcept {
+    size_t align = size & (~size + 1);
+    return align < std::hardware_destructive_interference_size ? align
+                                                                : std::hardware_destructive_interference_size;
+}
+
+}  // namespace envelope_detail
+
+/**
+ * @brief Hot-first dispatch order for BasicEnvelope::visit_ordered().
+ *
+ * List the most frequent alternatives first (e.g. quotes before trades
+ * before admin messages); each is tested with one predictable compare
+ * before falling back to the dispatch table.
+ */
+template<typename... Hot>
+struct DispatchOrder {};
+
+/**
+ * @brief A fixed-size tagged union for carrying many message kinds in one queue.
+ *
+ * Replaces std::variant as the element type of SPSCRingBuffer/MPSCQueue when
+ * one queue carries heterogeneous traffic: a one-byte type tag followed by
+ * inline storage, sized as a whole to SIZE bytes (a cache line by default),
+ * so every slot is one line and is copied with a plain memcpy.
+ *
+ * @tparam SIZE Total size of the envelope in bytes.
+ * @tparam Ts Message alternatives. Must be trivially copyable and fit in
+ *         the inline storage.
+ *
+ * Features:
+ * - Compact: one tag byte plus alignment, no per-alternative padding beyond SIZE
+ * - Compile-time dispatch table: visit() is one indexed indirect call
+ * - Frequency-ordered dispatch: visit_ordered<DispatchOrder<...>>() tests
+ *   the hot alternatives inline before the table
+ * - Trivially copyable itself, so queues copy slots without calling anything
+ *
+ * Usage Constraints:
+ * - A default-constructed envelope is empty(); visiting it aborts the process
+ * - At most 255 alternatives, each listed once
+ */
+template<size_t SIZE, typename... Ts>
+class alignas(envelope_detail::slot_alignment(SIZE)) BasicEnvelope {
+    static_assert(sizeof...(Ts) >= 1 && sizeof...(Ts) < 255, "1 to 254 alternatives");
+    static_assert((std::is_trivially_copyable_v<Ts> && ...),
+                  "alternatives must be trivially copyable so slots can be memcpy'd");
+
+public:
+    /// Alignment of the inline storage: the strictest alternative
+    static constexpr size_t STORAGE_ALIGN = std::max({alignof(Ts)...});
+    /// Bytes available for a message after the tag
+    static constexpr size_t INLINE_CAPACITY = SIZE - STORAGE_ALIGN;
+    /// Tag of an empty envelope
+    static constexpr uint8_t NONE = 0xFF;
+
+    static_assert(SIZE % STORAGE_ALIGN == 0 && SIZE > STORAGE_ALIGN, "SIZE must be a multiple of the storage alignment");
+    static_assert(((sizeof(Ts) <= INLINE_CAPACITY) && ...), "an alternative does not fit in the inline storage");
+
+    /**
+     * @brief Tag value of alternative T (its position in Ts).
+     */
+    template<typename T>
+    static constexpr uint8_t index_of() noexcept {
+        static_assert((std::is_same_v<T, Ts> || ...), "T is not an alternative of this envelope");
+        constexpr bool matches[] = {std::is_same_v<T, Ts>...};
+        uint8_t index = 0;
+        while (!matches[index]) ++index;
+        return index;
+    }
+
+    BasicEnvelope() noexcept = default;
+
+    /**
+     * @brief Construct holding a message.
+     */
+    template<typename T>
+        requires (std::is_same_v<std::remove_cvref_t<T>, Ts> || ...)
+    BasicEnvelope(const T& message) noexcept {   // NOLINT: implicit, so push(Quote{...}) works
+        emplace<T>(message);
+    }
+
+    /**
+     * @brief Replace the held message.
+     */
+    template<typename T, typename... Args>
+    T& emplace(Args&&... args) noexcept {
+        mTag = index_of<T>();
+        return *::new (static_cast<void*>(mStorage)) T{std::forward<Args>(args)...};
+    }
+
+    uint8_t index() const noexcept {
+        return mTag;
+    }
+
+    bool empty() const noexcept {
+        return mTag == NONE;
+    }
+
+    template<typename T>
+    bool holds() const noexcept {
+        return mTag == index_of<T>();
+    }
+
+    /**
+     * @brief Get the message as T, or nullptr if it holds something else.
+     */
+    template<typename T>
+    T* get_if() noexcept {
+        return holds<T>() ? get<T>() : nullptr;
+    }
+
+    template<typename T>
+    const T* get_if() const noexcept {
+        return holds<T>() ? get<T>() : nullptr;
+    }
+
+    /**
+     * @brief Unchecked access; the caller knows the tag.
+     */
+    template<typename T>
+    T* get() noexcept {
+        return std::launder(reinterpret_cast<T*>(mStorage));
+    }
+
+    template<typename T>
+    const T* get() const noexcept {
+        return std::launder(reinterpret_cast<const T*>(mStorage));
+    }
+
+    /**
+     * @brief Call f with the held message through a compile-time table.
+     *
+     * @param f Callable accepting every alternative; all overloads must
+     *          return the same type.
+     * @return Whatever f returns. Aborts if the envelope is empty().
+     *
+     * Time Complexity: O(1), one indirect call
+     */
+    template<typename F>
+    decltype(auto) visit(F&& f) {
+        return dispatch<BasicEnvelope>(*this, f);
+    }
+
+    template<typename F>
+    decltype(auto) visit(F&& f) const {
+        return dispatch<const BasicEnvelope>(*this, f);
+    }
+
+    /**
+     * @brief Visit, testing the listed hot alternatives first.
+     *
+     * @tparam Order A DispatchOrder<Hot...>, most frequent first.
+     *
+     * A few compares on the tag predict far better than an indirect call
+     * when traffic is dominated by one or two message kinds, and let the
+     * compiler inline the hot handlers.
+     */
+    template<typename Order, typename F>
+    decltype(auto) visit_ordered(F&& f) {
+        return OrderedDispatch<Order>::template run<BasicEnvelope>(*this, f);
+    }
+
+    template<typename Order, typename F>
+    decltype(auto) visit_ordered(F&& f) const {
+        return OrderedDispatch<Order>::template run<const BasicEnvelope>(*this, f);
+    }
+
+private:
+    using First = std::tuple_element_t<0, std::tuple<Ts...>>;
+
+    template<typename Self, typename F, typename T>
+    using Alternative = std::conditional_t<std::is_const_v<Self>, const T, T>;
+
+    template<typename Self, typename F, typename R, typename T>
+    static R invoke(Self& self, F& f) {
+        return f(*self.template get<T>());
+    }
+
+    template<typename Self, typename F>
+    static decltype(auto) dispatch(Self& self, F& f) {
+        using R = std::invoke_result_t<F&, Alternative<Self, F, First>&>;
+        static_assert((std::is_same_v<R, std::invoke_result_t<F&, Alternative<Self, F, Ts>&>> && ...),
+                      "the visitor must return the same type for every alternative");
+        static constexpr R (*TABLE[])(Self&, F&) = {&invoke<Self, F, R, Alternative<Self, F, Ts>>...};
+        // NONE would index past the table; a popped but never filled slot ends here
+        if (self.mTag == NONE) [[unlikely]] {
+            std::abort();
+        }
+        return TABLE[self.mTag](self, f);
+    }
+
+    template<typename Order>
+    struct OrderedDispatch;
+
+    template<typename... Hot>
+    struct OrderedDispatch<DispatchOrder<Hot...>> {
+        template<typename Self, typename F>
+        static decltype(auto) run(Self& self, F& f) {
+            return step<Self, F, Hot...>(self, f);
+        }
+
+        template<typename Self, typename F, typename H, typename... Rest>
+        static decltype(auto) step(Self& self, F& f) {
+            if (self.mTag == index_of<H>()) [[likely]] {
+                return f(*self.template get<Alternative<Self, F, H>>());
+            }
+            if constexpr (sizeof...(Rest) > 0) {
+                return step<Self, F, Rest...>(self, f);
+            } else {
+                return dispatch(self, f);
+            }
+        }
+    };
+
+    uint8_t mTag = NONE;
+    alignas(STORAGE_ALIGN) unsigned char mStorage[INLINE_CAPACITY];
+};
+
+/**
+ * @brief Cache-line sized envelope (the common case).
+ */
+template<typename... Ts>
+using MessageEnvelope = BasicEnvelope<std::hardware_destructive_interference_size, Ts...>;
@@ -0,0 +1,361 @@
+#pragma once
+
+#include "FixedPoint.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+/**
+ * @brief 32-bit reference to an order: 20-bit slot index, 12-bit generation.
+ *
+ * Trivially copyable and small enough to ride in any queue message or in
+ * the ClOrdID echoed back by the exchange. The generation is checked on
+ * every lookup, so a handle kept past its order's release (or past an
+ * arena reset) is detected instead of silently aliasing a newer order.
+ * Generation 0 is never issued, so a default handle is always invalid.
+ */
+class OrderHandle {
+public:
+    static constexpr uint32_t INDEX_BITS = 20;
+    static constexpr uint32_t GENERATION_BITS = 32 - INDEX_BITS;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_MASK = (1u << GENERATION_BITS) - 1;
+
+    constexpr OrderHandle() noexcept = default;
+
+    constexpr OrderHandle(uint32_t index, uint32_t generation) noexcept
+        : mRaw((generation << INDEX_BITS) | (index & INDEX_MASK)) {}
+
+    static constexpr OrderHandle from_raw(uint32_t raw) noexcept {
+        OrderHandle handle;
+        handle.mRaw = raw;
+        return handle;
+    }
+
+    constexpr uint32_t raw() const noexcept { return mRaw; }
+    constexpr uint32_t index() const noexcept { return mRaw & INDEX_MASK; }
+    constexpr uint32_t generation() const noexcept { return mRaw >> INDEX_BITS; }
+    constexpr explicit operator bool() const noexcept { return mRaw != 0; }
+
+    friend constexpr bool operator==(OrderHandle, OrderHandle) noexcept = default;
+
+private:
+    uint32_t mRaw = 0;
+};
+
+/**
+ * @brief Order lifecycle states.
+ */
+enum class OrderState : uint8_t {
+    PENDING_NEW,        ///< Sent, not yet acknowledged
+    NEW,
+    PARTIALLY_FILLED,
+    PENDING_CANCEL,     ///< Cancel sent, order may still fill
+    FILLED,             ///< Terminal
+    CANCELLED,          ///< Terminal
+    REJECTED,           ///< Terminal
+};
+
+/**
+ * @brief Result of an in-place state transition.
+ */
+enum class OrderUpdate : uint8_t {
+    OK,
+    STALE_HANDLE,         ///< Order was released or the arena reset
+    INVALID_TRANSITION,   ///< Event not allowed in the current state
+    OVERFILL,             ///< Fill exceeds the leaves quantity
+};
+
+/**
+ * @brief Order record, stored and updated in place in its arena slot.
+ */
+struct Order {
+    uint64_t clOrdId = 0;
+    uint64_t exchangeOrderId = 0;
+    uint32_t instrument = 0;
+    bool buy = false;
+    OrderState state = OrderState::PENDING_NEW;
+    Price price;
+    Quantity qty;
+    Quantity filled;
+    Notional filledNotional;   ///< Sum of fill qty * fill price
+
+    Quantity leaves() const noexcept { return is_terminal() ? Quantity() : qty - filled; }
+
+    bool is_terminal() const noexcept { return state >= OrderState::FILLED; }
+};
+
+/**
+ * @brief Per-session arena of orders addressed by generation-checked handles.
+ *
+ * All orders of a session live in one array allocated at construction, so
+ * creating an order is a high-water bump or a free-list pop, never a heap
+ * allocation, and an order is a single cache-line-sized record rather than
+ * a node in a map. Lifecycle events update the record in place after
+ * checking the handle and the transition.
+ *
+ * reset() ends the session in O(1): it only rewinds the high-water mark
+ * and drops the free list. Slot generations are left untouched and bumped
+ * on the next allocation, which is what invalidates every handle from the
+ * previous session without walking the array.
+ *
+ * Features:
+ * - create/get/transition/release are O(1) with no allocation
+ * - Stale handles (released, reused or pre-reset) are reported, not aliased
+ * - Transitions follow the usual order state machine, including fills that
+ *   race a pending cancel
+ *
+ * Usage Constraints:
+ * - Not thread-safe: one owning thread (the session's) creates, updates
+ *   and releases; other threads exchange handles with it through queues
+ * - Capacity is fixed, at most 2^20 orders live at once per session
+ * - Generations wrap after 4095 reuses of a slot. Fresh slots are handed
+ *   out before freed ones and the free list is FIFO, so a released handle
+ *   only aliases again after about 4095 times the number of free slots
+ *   creates; with an almost full arena the window shrinks towards 4095
+ */
+class OrderArena {
+public:
+    /**
+     * @brief Construct an arena for up to capacity live orders.
+     */
+    explicit OrderArena(size_t capacity)
+        : mCapacity(capacity < OrderHandle::INDEX_MASK + 1 ? uint32_t(capacity) : OrderHandle::INDEX_MASK + 1),
+          mSlots(std::make_unique<Slot[]>(mCapacity)) {}
+
+    OrderArena(const OrderArena&) = delete;
+    OrderArena& operator=(const OrderArena&) = delete;
+
+    /**
+     * @brief Create an order in PENDING_NEW.
+     *
+     * @return OrderHandle Handle to the new order, or a null handle if the
+     *         arena is full.
+     *
+     * Time Complexity: O(1)
+     */
+    OrderHandle create(uint64_t clOrdId, uint32_t instrument, bool buy, Price price, Quantity qty) noexcept {
+        // Fresh slots first, then the oldest freed one: reuse of any one slot
+        // (and with it generation wrap) is spread over the whole arena
+        uint32_t index;
+        if (mHighWater < mCapacity) {
+            index = mHighWater++;
+        } else if (mFreeHead != NONE) {
+            index = mFreeHead;
+            mFreeHead = mSlots[index].nextFree;
+            if (mFreeHead == NONE) {
+                mFreeTail = NONE;
+            }
+        } else {
+            return OrderHandle();
+        }
+
+        Slot& slot = mSlots[index];
+        slot.generation = uint16_t((slot.generation + 1) & OrderHandle::GENERATION_MASK);
+        if (slot.generation == 0) {
+            slot.generation = 1;
+        }
+        slot.nextFree = LIVE;
+        slot.order = Order{};
+        slot.order.clOrdId = clOrdId;
+        slot.order.instrument = instrument;
+        slot.order.buy = buy;
+        slot.order.price = price;
+        slot.order.qty = qty;
+        ++mLive;
+        return OrderHandle(index, slot.generation);
+    }
+
+    /**
+     * @brief Look up an order.
+     *
+     * @return Order* The order, or nullptr if the handle is stale.
+     */
+    Order* get(OrderHandle handle) noexcept {
+        uint32_t index = handle.index();
+        if (index >= mHighWater) {
+            return nullptr;
+        }
+        Slot& slot = mSlots[index];
+        return slot.nextFree == LIVE && slot.generation == handle.generation() ? &slot.order : nullptr;
+    }
+
+    const Order* get(OrderHandle handle) const noexcept {
+        return const_cast<OrderArena*>(this)->get(handle);
+    }
+
+    /**
+     * @brief Exchange acknowledged the order: PENDING_NEW -> NEW.
+     */
+    OrderUpdate on_ack(OrderHandle handle, uint64_t exchangeOrderId) noexcept {
+        Order* order = get(handle);
+        if (!order) return OrderUpdate::STALE_HANDLE;
+        if (order->state != OrderState::PENDING_NEW) return OrderUpdate::INVALID_TRANSITION;
+        order->exchangeOrderId = exchangeOrderId;
+        order->state = OrderState::NEW;
+        return OrderUpdate::OK;
+    }
+
+    /**
+     * @brief Exchange rejected the order: PENDING_NEW -> REJECTED.
+     */
+    OrderUpdate on_reject(OrderHandle handle) noexcept {
+        Order* order = get(handle);
+        if (!order) return OrderUpdate::STALE_HANDLE;
+        if (order->state != OrderState::PENDING_NEW) return OrderUpdate::INVALID_TRANSITION;
+        order->state = OrderState::REJECTED;
+        return OrderUpdate::OK;
+    }
+
+    /**
+     * @brief Apply a fill: to PARTIALLY_FILLED or FILLED. A partial fill
+     *        while a cancel is pending leaves the order PENDING_CANCEL.
+     */
+    OrderUpdate on_fill(OrderHandle handle, Quantity qty, Price price) noexcept {
+        Order* order = get(handle);
+        if (!order) return OrderUpdate::STALE_HANDLE;
+        if (order->state == OrderState::PENDING_NEW || order->is_terminal()) {
+            return OrderUpdate::INVALID_TRANSITION;
+        }
+        if (qty.raw() <= 0 || qty > order->leaves()) return OrderUpdate::OVERFILL;
+
+        order->filled += qty;
+        order->filledNotional += price * qty;
+        if (order->filled == order->qty) {
+            order->state = OrderState::FILLED;
+        } else if (order->state != OrderState::PENDING_CANCEL) {
+            order->state = OrderState::PARTIALLY_FILLED;
+        }
+        return OrderUpdate::OK;
+    }
+
+    /**
+     * @brief Cancel sent: NEW or PARTIALLY_FILLED -> PENDING_CANCEL.
+     */
+    OrderUpdate on_cancel_request(OrderHandle handle) noexcept {
+        Order* order = get(handle);
+        if (!order) return OrderUpdate::STALE_HANDLE;
+        if (order->state != OrderState::NEW && order->state != OrderState::PARTIALLY_FILLED) {
+            return OrderUpdate::INVALID_TRANSITION;
+        }
+        order->state = OrderState::PENDING_CANCEL;
+        return OrderUpdate::OK;
+    }
+
+    /**
+     * @brief Cancel rejected: PENDING_CANCEL -> NEW or PARTIALLY_FILLED.
+     */
+    OrderUpdate on_cancel_reject(OrderHandle handle) noexcept {
+        Order* order = get(handle);
+        if (!order) return OrderUpdate::STALE_HANDLE;
+        if (order->state != OrderState::PENDING_CANCEL) return OrderUpdate::INVALID_TRANSITION;
+        order->state = order->filled.raw() > 0 ? OrderState::PARTIALLY_FILLED : OrderState::NEW;
+        return OrderUpdate::OK;
+    }
+
+    /**
+     * @brief Order cancelled (requested or unsolicited) -> CANCELLED.
+     */
+    OrderUpdate on_cancelled(OrderHandle handle) noexcept {
+        Order* order = get(handle);
+        if (!order) return OrderUpdate::STALE_HANDLE;
+        if (order->state == OrderState::PENDING_NEW || order->is_terminal()) {
+            return OrderUpdate::INVALID_TRANSITION;
+        }
+        order->state = OrderState::CANCELLED;
+        return OrderUpdate::OK;
+    }
+
+    /**
+     * @brief Return the order's slot to the arena; the handle becomes stale.
+     *
+     * @return false if the handle was already stale.
+     */
+    bool release(OrderHandle handle) noexcept {
+        if (!get(handle)) {
+            return false;
+        }
+        uint32_t index = handle.index();
+        mSlots[index].nextFree = NONE;
+        if (mFreeTail != NONE) {
+            mSlots[mFreeTail].nextFree = index;
+        } else {
+            mFreeHead = index;
+        }
+        mFreeTail = index;
+        --mLive;
+        return true;
+    }
+
+    /**
+     * @brief Drop every order, invalidating all outstanding handles.
+     *
+     * Time Complexity: O(1)
+     */
+    void reset() noexcept {
+        mHighWater = 0;
+        mFreeHead = NONE;
+        mFreeTail = NONE;
+        mLive = 0;
+    }
+
+    size_t size() const noexcept {
+        return mLive;
+    }
+
+    size_t capacity() const noexcept {
+        return mCapacity;
+    }
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr uint32_t LIVE = UINT32_MAX - 1;   ///< nextFree of a slot holding an order
+
+    /**
+     * @brief One order plus its bookkeeping on exactly one cache line.
+     */
+    struct alignas(std::hardware_destructive_interference_size) Slot {
+        Order order;
+        uint32_t nextFree = NONE;   ///< Free-list link, or LIVE
+        uint16_t generation = 0;
+    };
+    static_assert(sizeof(Slot) <= std::hardware_destructive_interference_size,
+                  "an order slot must fit in one cache line");
+
+    const uint32_t mCapacity;
+    std::unique_ptr<Slot[]> mSlots;
+    uint32_t mHighWater = 0;   ///< Slots at or above this index are unused this session
+    uint32_t mFreeHead = NONE;   ///< Oldest released slot, reused first
+    uint32_t mFreeTail = NONE;   ///< Newest released slot
+    uint32_t mLive = 0;
+};
+
+/**
+ * @brief One OrderArena per trading session.
+ *
+ * Sessions are dense ids; each arena is owned by that session's thread and
+ * reset independently at session end.
+ */
+class OrderStore {
+public:
+    OrderStore(size_t sessions, size_t capacityPerSession) {
+        mArenas.reserve(sessions);
+        for (size_t i = 0; i < sessions; ++i) {
+            mArenas.push_back(std::make_unique<OrderArena>(capacityPerSession));
+        }
+    }
+
+    OrderArena& session(uint32_t session) noexcept {
+        return *mArenas[session];
+    }
+
+    size_t session_count() const noexcept {
+        return mArenas.size();
+    }
+
+private:
+    std::vector<std::unique_ptr<OrderArena>> mArenas;
+};
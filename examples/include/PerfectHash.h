@@ -0,0 +1,351 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Key hashing for the perfect hash tables.
+ *
+ * Integral keys (instrument ids) are mixed with the murmur3 finaliser,
+ * string keys (symbols) with FNV-1a followed by the same finaliser. Both are
+ * constexpr so compile-time tables hash exactly like runtime ones.
+ */
+template<typename K, typename Enable = void>
+struct PerfectHashKey;
+
+template<typename K>
+struct PerfectHashKey<K, std::enable_if_t<std::is_integral_v<K>>> {
+    static constexpr uint64_t hash(K key, uint64_t seed) noexcept {
+        return mix(uint64_t(key) ^ seed);
+    }
+
+    static constexpr uint64_t mix(uint64_t h) noexcept {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+};
+
+template<>
+struct PerfectHashKey<std::string_view> {
+    static constexpr uint64_t hash(std::string_view key, uint64_t seed) noexcept {
+        uint64_t h = 0xcbf29ce484222325ull ^ seed;
+        for (char c : key) {
+            h ^= uint8_t(c);
+            h *= 0x100000001b3ull;
+        }
+        return PerfectHashKey<uint64_t>::mix(h);
+    }
+};
+
+template<>
+struct PerfectHashKey<std::string> : PerfectHashKey<std::string_view> {};
+
+namespace perfect_hash_detail {
+
+constexpr size_t NOT_FOUND = ~size_t{0};
+constexpr size_t KEYS_PER_BUCKET = 4;   ///< Average bucket size (lambda)
+constexpr uint32_t MAX_PILOT = 1u << 20;
+constexpr int MAX_SEEDS = 16;
+
+/**
+ * @brief Table geometry for n keys: buckets and slots (load factor ~0.95).
+ */
+constexpr size_t bucket_count(size_t n) noexcept {
+    return n / KEYS_PER_BUCKET + 1;
+}
+
+constexpr size_t table_size(size_t n) noexcept {
+    return n + n / 20 + 1;
+}
+
+/**
+ * @brief Map a 64-bit value uniformly onto [0, range) without a division.
+ */
+constexpr size_t fastrange(uint64_t x, size_t range) noexcept {
+    return size_t((unsigned __int128)x * range >> 64);
+}
+
+constexpr size_t bucket_of(uint64_t hash, size_t buckets) noexcept {
+    return fastrange(hash, buckets);
+}
+
+constexpr size_t slot_of(uint64_t hash, uint32_t pilot, size_t tableSize) noexcept {
+    return fastrange(PerfectHashKey<uint64_t>::mix(hash ^ (0x9e3779b97f4a7c15ull * (pilot + 1))),
+                     tableSize);
+}
+
+/**
+ * @brief PTHash-style pilot search.
+ *
+ * Keys are grouped into buckets by hash; buckets are placed largest first,
+ * and each gets the smallest pilot that sends all its keys to free slots.
+ *
+ * @param hashes Key hashes, one per key.
+ * @param pilots Receives one pilot per bucket (size bucket_count(n)).
+ * @param slots Receives the slot of every key (size n).
+ * @return false if two keys share a hash or a bucket found no pilot.
+ *
+ * constexpr: used both by PerfectHashIndex::build() and make_perfect_hash().
+ */
+template<typename Pilots, typename Slots>
+constexpr bool search_pilots(const std::vector<uint64_t>& hashes, Pilots& pilots, Slots& slots) {
+    size_t n = hashes.size();
+    size_t buckets = bucket_count(n);
+    size_t tableSize = table_size(n);
+
+    // Key indices grouped by bucket, buckets ordered by size (largest first)
+    std::vector<std::pair<size_t, size_t>> byBucket(n);   // (bucket, key)
+    for (size_t i = 0; i < n; ++i) {
+        byBucket[i] = {bucket_of(hashes[i], buckets), i};
+    }
+    // Within a bucket, order by hash so identical hashes end up adjacent
+    std::sort(byBucket.begin(), byBucket.end(), [&](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first < b.first : hashes[a.second] < hashes[b.second];
+    });
+
+    std::vector<std::pair<size_t, size_t>> runs;           // (size, first entry)
+    for (size_t i = 0; i < n;) {
+        size_t j = i;
+        while (j < n && byBucket[j].first == byBucket[i].first) {
+            if (j > i && hashes[byBucket[j].second] == hashes[byBucket[j - 1].second]) {
+                return false;   // identical hashes can never be separated
+            }
+            ++j;
+        }
+        runs.push_back({j - i, i});
+        i = j;
+    }
+    std::sort(runs.begin(), runs.end(), [](const auto& a, const auto& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    });
+
+    std::vector<bool> taken(tableSize, false);
+    for (size_t b = 0; b < buckets; ++b) {
+        pilots[b] = 0;
+    }
+
+    for (const auto& [size, first] : runs) {
+        bool placed = false;
+        for (uint32_t pilot = 0; pilot < MAX_PILOT && !placed; ++pilot) {
+            size_t k = 0;
+            for (; k < size; ++k) {
+                size_t key = byBucket[first + k].second;
+                size_t slot = slot_of(hashes[key], pilot, tableSize);
+                if (taken[slot]) {
+                    break;
+                }
+                taken[slot] = true;   // also catches clashes within the bucket
+                slots[key] = slot;
+            }
+            if (k == size) {
+                pilots[byBucket[first].first] = pilot;
+                placed = true;
+            } else {
+                for (size_t u = 0; u < k; ++u) {   // roll back the partial placement
+                    taken[slots[byBucket[first + u].second]] = false;
+                }
+            }
+        }
+        if (!placed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace perfect_hash_detail
+
+/**
+ * @brief Perfect hash index over a key set known at session start.
+ *
+ * Maps each key of a fixed universe (instrument ids, symbols) to its position
+ * in the key list given to build(), with no collisions: a lookup reads one
+ * pilot word and one table entry, and compares a single key.
+ *
+ * @tparam Key Key type: an integral type or std::string.
+ *
+ * Features:
+ * - Two memory accesses per lookup: pilot[bucket], then entry[slot]
+ * - Verified: keys outside the universe return NOT_FOUND
+ * - Heterogeneous lookup: std::string keys can be found by std::string_view
+ * - Build is O(n log n) expected (buckets sorted by size, then PTHash-style
+ *   pilot search), intended for init
+ *
+ * Usage Constraints:
+ * - build() once, before the index is shared; lookups are then read-only and
+ *   safe from any number of threads
+ */
+template<typename Key>
+class PerfectHashIndex {
+public:
+    static constexpr size_t NOT_FOUND = perfect_hash_detail::NOT_FOUND;
+
+    /**
+     * @brief Build the index; key i is found at index i.
+     *
+     * @return false if the keys contain duplicates (or, vanishingly unlikely,
+     *         no pilot assignment was found for any seed).
+     */
+    bool build(const std::vector<Key>& keys) {
+        using namespace perfect_hash_detail;
+        size_t n = keys.size();
+        std::vector<uint64_t> hashes(n);
+        std::vector<size_t> slots(n);
+
+        for (int attempt = 0; attempt < MAX_SEEDS; ++attempt) {
+            uint64_t seed = PerfectHashKey<uint64_t>::mix(attempt + 1);
+            for (size_t i = 0; i < n; ++i) {
+                hashes[i] = PerfectHashKey<Key>::hash(keys[i], seed);
+            }
+            mPilots.assign(bucket_count(n), 0);
+            if (search_pilots(hashes, mPilots, slots)) {
+                mEntries.assign(table_size(n), Entry{Key{}, NOT_FOUND});
+                for (size_t i = 0; i < n; ++i) {
+                    mEntries[slots[i]] = Entry{keys[i], i};
+                }
+                mSeed = seed;
+                mSize = n;
+                return true;
+            }
+        }
+        mPilots.clear();
+        mEntries.clear();
+        mSize = 0;
+        return false;   // duplicate keys
+    }
+
+    /**
+     * @brief Look up a key.
+     *
+     * @return size_t The key's index in the build() list, or NOT_FOUND.
+     *
+     * Thread Safety: Safe from any number of threads once built.
+     */
+    template<typename Q>
+    size_t find(const Q& key) const noexcept {
+        if (mSize == 0) {
+            return NOT_FOUND;
+        }
+        const Entry& entry = mEntries[slot(PerfectHashKey<Key>::hash(key, mSeed))];
+        return entry.index != NOT_FOUND && entry.key == key ? entry.index : NOT_FOUND;
+    }
+
+    /**
+     * @brief Get the number of keys.
+     */
+    size_t size() const noexcept {
+        return mSize;
+    }
+
+    /**
+     * @brief Get the memory used by pilots and entries, in bytes.
+     */
+    size_t memory_bytes() const noexcept {
+        return mPilots.size() * sizeof(uint32_t) + mEntries.size() * sizeof(Entry);
+    }
+
+private:
+    struct Entry {
+        Key key;
+        size_t index;   ///< Position in the build() list, NOT_FOUND for free slots
+    };
+
+    size_t slot(uint64_t hash) const noexcept {
+        using namespace perfect_hash_detail;
+        uint32_t pilot = mPilots[bucket_of(hash, mPilots.size())];
+        return slot_of(hash, pilot, mEntries.size());
+    }
+
+    std::vector<uint32_t> mPilots;
+    std::vector<Entry> mEntries;
+    uint64_t mSeed = 0;
+    size_t mSize = 0;
+};
+
+/**
+ * @brief Perfect hash table generated entirely at compile time.
+ *
+ * Produced by make_perfect_hash() for universes known when compiling; the
+ * object is a literal type, so a `constexpr` instance lives in read-only data
+ * and needs no construction at startup.
+ *
+ * @tparam Key uint64_t-like integral or std::string_view.
+ * @tparam N Number of keys.
+ */
+template<typename Key, size_t N>
+struct StaticPerfectHash {
+    static constexpr size_t NOT_FOUND = perfect_hash_detail::NOT_FOUND;
+    static constexpr size_t BUCKETS = perfect_hash_detail::bucket_count(N);
+    static constexpr size_t SLOTS = perfect_hash_detail::table_size(N);
+
+    struct Entry {
+        Key key{};
+        size_t index = NOT_FOUND;
+    };
+
+    std::array<uint32_t, BUCKETS> pilots{};
+    std::array<Entry, SLOTS> entries{};
+    uint64_t seed = 0;
+
+    /**
+     * @brief Look up a key; usable in constant expressions.
+     *
+     * @return size_t The key's index in the make_perfect_hash() list, or NOT_FOUND.
+     */
+    template<typename Q>
+    constexpr size_t find(const Q& key) const noexcept {
+        using namespace perfect_hash_detail;
+        uint64_t hash = PerfectHashKey<Key>::hash(key, seed);
+        uint32_t pilot = pilots[bucket_of(hash, BUCKETS)];
+        const Entry& entry = entries[slot_of(hash, pilot, SLOTS)];
+        return entry.index != NOT_FOUND && entry.key == key ? entry.index : NOT_FOUND;
+    }
+
+    static constexpr size_t size() noexcept {
+        return N;
+    }
+};
+
+/**
+ * @brief Build a StaticPerfectHash in a constant expression.
+ *
+ * Usage:
+ *     static constexpr auto kInstruments = make_perfect_hash<std::string_view>(
+ *         std::array<std::string_view, 3>{"AAPL", "MSFT", "NVDA"});
+ *
+ * Fails to compile (the constant evaluation reaches a throw) if the keys
+ * contain duplicates.
+ */
+template<typename Key, size_t N>
+consteval StaticPerfectHash<Key, N> make_perfect_hash(const std::array<Key, N>& keys) {
+    using namespace perfect_hash_detail;
+    StaticPerfectHash<Key, N> table{};
+    std::vector<uint64_t> hashes(N);
+    std::array<size_t, N> slots{};
+
+    for (int attempt = 0; attempt < MAX_SEEDS; ++attempt) {
+        uint64_t seed = PerfectHashKey<uint64_t>::mix(attempt + 1);
+        for (size_t i = 0; i < N; ++i) {
+            hashes[i] = PerfectHashKey<Key>::hash(keys[i], seed);
+        }
+        if (search_pilots(hashes, table.pilots, slots)) {
+            for (size_t i = 0; i < N; ++i) {
+                table.entries[slots[i]] = {keys[i], i};
+            }
+            table.seed = seed;
+            return table;
+        }
+    }
+    throw "make_perfect_hash: duplicate keys";
+}
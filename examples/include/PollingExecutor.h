@@ -0,0 +1,402 @@
+#pragma once
+
+#include "SPSCRingBuffer.h"
+
+#include <array>
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace coro_detail {
+
+/**
+ * @brief Per-thread pool of coroutine frames in 64-byte size classes.
+ *
+ * Frames up to MAX_POOLED bytes come from free lists refilled from 64 KB
+ * chunks; larger frames fall back to operator new. Freed frames go back to
+ * the freeing thread's list, which for executor tasks is the executor's
+ * thread, so after warm-up spawning a task allocates nothing.
+ */
+class FramePool {
+public:
+    static constexpr size_t GRANULE = 64;
+    static constexpr size_t MAX_POOLED = 1024;
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    void* allocate(size_t bytes) {
+        if (bytes > MAX_POOLED) {
+            return ::operator new(bytes);
+        }
+        size_t cls = size_class(bytes);
+        FreeFrame* frame = mFree[cls];
+        if (frame) {
+            mFree[cls] = frame->next;
+        } else {
+            size_t size = (cls + 1) * GRANULE;
+            if (mChunks.empty() || mChunkUsed + size > CHUNK_SIZE) {
+                mChunks.push_back(std::make_unique<std::byte[]>(CHUNK_SIZE));
+                mChunkUsed = 0;
+            }
+            frame = reinterpret_cast<FreeFrame*>(mChunks.back().get() + mChunkUsed);
+            mChunkUsed += size;
+        }
+        ++mInUse;
+        return frame;
+    }
+
+    void deallocate(void* ptr, size_t bytes) noexcept {
+        if (bytes > MAX_POOLED) {
+            ::operator delete(ptr);
+            return;
+        }
+        size_t cls = size_class(bytes);
+        auto* frame = static_cast<FreeFrame*>(ptr);
+        frame->next = mFree[cls];
+        mFree[cls] = frame;
+        --mInUse;
+    }
+
+    /**
+     * @brief Get the number of pooled frames allocated and not yet freed on this thread.
+     */
+    int64_t in_use() const noexcept {
+        return mInUse;
+    }
+
+    /**
+     * @brief Get the number of chunks this thread's pool has reserved.
+     */
+    size_t chunks() const noexcept {
+        return mChunks.size();
+    }
+
+private:
+    struct FreeFrame {
+        FreeFrame* next;
+    };
+
+    static size_t size_class(size_t bytes) noexcept {
+        return (bytes + GRANULE - 1) / GRANULE - (bytes != 0);
+    }
+
+    std::array<FreeFrame*, MAX_POOLED / GRANULE> mFree{};
+    std::vector<std::unique_ptr<std::byte[]>> mChunks;
+    size_t mChunkUsed = 0;
+    int64_t mInUse = 0;
+};
+
+inline FramePool& frame_pool() noexcept {
+    thread_local FramePool pool;
+    return pool;
+}
+
+}  // namespace coro_detail
+
+class PollingExecutor;
+
+/**
+ * @brief Fire-and-forget coroutine run by a PollingExecutor.
+ *
+ * A Task does nothing until passed to PollingExecutor::spawn(); its frame
+ * is destroyed when the coroutine returns. Frames come from the calling
+ * thread's coro_detail::FramePool.
+ *
+ * Usage Constraints:
+ * - Exceptions escaping the coroutine terminate the process
+ */
+class Task {
+public:
+    struct promise_type {
+        PollingExecutor* executor = nullptr;
+
+        Task get_return_object() noexcept {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        // Defined after PollingExecutor: retires the task, then lets the frame be destroyed
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+            void await_resume() noexcept {}
+        };
+
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+
+        static void* operator new(size_t bytes) { return coro_detail::frame_pool().allocate(bytes); }
+        static void operator delete(void* ptr, size_t bytes) noexcept {
+            coro_detail::frame_pool().deallocate(ptr, bytes);
+        }
+    };
+
+    Task(Task&& other) noexcept : mHandle(std::exchange(other.mHandle, {})) {}
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    Task& operator=(Task&&) = delete;
+
+    ~Task() {
+        if (mHandle) {
+            mHandle.destroy();   // never spawned
+        }
+    }
+
+private:
+    friend class PollingExecutor;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : mHandle(handle) {}
+
+    std::coroutine_handle<promise_type> mHandle;
+};
+
+/**
+ * @brief A suspended coroutine waiting for a non-blocking operation.
+ *
+ * Lives inside the awaiter, i.e. inside the coroutine frame, so
+ * suspending links it into the executor's list without allocating.
+ */
+struct PollWaiter {
+    bool (*try_complete)(PollWaiter*) noexcept;
+    std::coroutine_handle<> handle;
+    PollWaiter* next = nullptr;
+};
+
+/**
+ * @brief Single-threaded executor that resumes coroutines from a polling loop.
+ *
+ * Coroutines suspended on a ring (async_pop/async_push) or on yield() are
+ * kept in an intrusive list. Each poll() retries every waiter's operation
+ * once and resumes those that completed, so one pinned thread can drive
+ * many multi-step protocol flows (login, recovery, resend) written as
+ * straight-line code, with no thread per flow and no locks.
+ *
+ * Features:
+ * - Suspension is allocation-free: waiters are part of the awaiter
+ * - Operations that can complete immediately never suspend
+ * - Task frames come from a per-thread pool (coro_detail::FramePool)
+ * - Waiters are retried in FIFO order
+ *
+ * Usage Constraints:
+ * - spawn(), poll() and run() from the executor thread only; tasks run on
+ *   that thread and may only await on rings it consumes (async_pop) or
+ *   produces (async_push)
+ * - Tasks still suspended when the executor is destroyed are destroyed
+ *   with it
+ */
+class PollingExecutor {
+public:
+    PollingExecutor() = default;
+
+    ~PollingExecutor() {
+        for (PollWaiter* waiter = mHead; waiter;) {
+            PollWaiter* next = waiter->next;
+            waiter->handle.destroy();
+            waiter = next;
+        }
+    }
+
+    PollingExecutor(const PollingExecutor&) = delete;
+    PollingExecutor& operator=(const PollingExecutor&) = delete;
+
+    /**
+     * @brief Get the executor running on this thread (inside poll()), or nullptr.
+     */
+    static PollingExecutor* current() noexcept {
+        return tCurrent;
+    }
+
+    /**
+     * @brief Start a task: it runs until its first suspension right away.
+     */
+    void spawn(Task task) {
+        auto handle = std::exchange(task.mHandle, {});
+        handle.promise().executor = this;
+        ++mLive;
+        Scope scope(this);
+        handle.resume();
+    }
+
+    /**
+     * @brief Retry every waiting operation once and resume the completed ones.
+     *
+     * @return size_t Number of coroutines resumed.
+     *
+     * Time Complexity: O(waiting coroutines)
+     */
+    size_t poll() {
+        Scope scope(this);
+        // Detach the list: coroutines resumed below may suspend again and
+        // must not be retried in the same pass
+        PollWaiter* waiter = std::exchange(mHead, nullptr);
+        mTail = nullptr;
+        size_t resumed = 0;
+        while (waiter) {
+            PollWaiter* next = waiter->next;
+            waiter->next = nullptr;
+            if (waiter->try_complete(waiter)) {
+                ++resumed;
+                waiter->handle.resume();
+            } else {
+                enqueue(waiter);
+            }
+            waiter = next;
+        }
+        return resumed;
+    }
+
+    /**
+     * @brief Poll until stop is set or no task is left.
+     */
+    void run(const std::atomic<bool>& stop) {
+        while (mLive > 0 && !stop.load(std::memory_order_relaxed)) {
+            if (poll() == 0) {
+                cpu_relax();
+            }
+        }
+    }
+
+    /**
+     * @brief Awaitable that resumes the coroutine on the next poll().
+     */
+    auto yield() noexcept {
+        struct YieldAwaiter {
+            PollingExecutor* executor;
+            PollWaiter waiter{[](PollWaiter*) noexcept { return true; }, {}};
+
+            bool await_ready() noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) noexcept {
+                waiter.handle = handle;
+                executor->enqueue(&waiter);
+            }
+            void await_resume() noexcept {}
+        };
+        return YieldAwaiter{this};
+    }
+
+    /**
+     * @brief Get the number of spawned tasks that have not finished.
+     */
+    size_t live_tasks() const noexcept {
+        return mLive;
+    }
+
+    /**
+     * @brief Link a suspended waiter (used by awaiters).
+     */
+    void enqueue(PollWaiter* waiter) noexcept {
+        waiter->next = nullptr;
+        if (mTail) {
+            mTail->next = waiter;
+        } else {
+            mHead = waiter;
+        }
+        mTail = waiter;
+    }
+
+private:
+    friend struct Task::promise_type::FinalAwaiter;
+
+    struct Scope {
+        PollingExecutor* previous;
+        explicit Scope(PollingExecutor* executor) noexcept : previous(std::exchange(tCurrent, executor)) {}
+        ~Scope() { tCurrent = previous; }
+    };
+
+    static void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    static inline thread_local PollingExecutor* tCurrent = nullptr;
+
+    PollWaiter* mHead = nullptr;
+    PollWaiter* mTail = nullptr;
+    size_t mLive = 0;
+};
+
+inline void Task::promise_type::FinalAwaiter::await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+    --handle.promise().executor->mLive;
+    handle.destroy();
+}
+
+namespace coro_detail {
+
+/**
+ * @brief Awaiter for a non-blocking operation: tries it once, otherwise
+ *        suspends on the current executor until a poll() completes it.
+ */
+template<typename Derived>
+struct PollAwaiter {
+    PollWaiter waiter{[](PollWaiter* w) noexcept {
+        // The waiter is the first member of the awaiter
+        return static_cast<Derived*>(reinterpret_cast<PollAwaiter*>(w))->try_once();
+    }, {}};
+
+    bool await_ready() noexcept {
+        return static_cast<Derived*>(this)->try_once();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept {
+        waiter.handle = handle;
+        PollingExecutor::current()->enqueue(&waiter);
+    }
+};
+
+template<typename T, size_t CAPACITY>
+struct PopAwaiter : PollAwaiter<PopAwaiter<T, CAPACITY>> {
+    SPSCRingBuffer<T, CAPACITY>& ring;
+    T value{};
+
+    explicit PopAwaiter(SPSCRingBuffer<T, CAPACITY>& r) noexcept : ring(r) {}
+
+    bool try_once() noexcept { return ring.pop(value); }
+    T await_resume() noexcept { return std::move(value); }
+};
+
+template<typename T, size_t CAPACITY>
+struct PushAwaiter : PollAwaiter<PushAwaiter<T, CAPACITY>> {
+    SPSCRingBuffer<T, CAPACITY>& ring;
+    T value;
+
+    PushAwaiter(SPSCRingBuffer<T, CAPACITY>& r, T v) noexcept : ring(r), value(std::move(v)) {}
+
+    bool try_once() noexcept { return ring.push(value); }
+    void await_resume() noexcept {}
+};
+
+}  // namespace coro_detail
+
+/**
+ * @brief Awaitable pop: `T item = co_await async_pop(ring);`
+ *
+ * Completes immediately if the ring has data, otherwise suspends until a
+ * poll() of the current executor finds some.
+ *
+ * Thread Safety: The executor thread must be the ring's only consumer.
+ */
+template<typename T, size_t CAPACITY>
+coro_detail::PopAwaiter<T, CAPACITY> async_pop(SPSCRingBuffer<T, CAPACITY>& ring) noexcept {
+    return coro_detail::PopAwaiter<T, CAPACITY>(ring);
+}
+
+/**
+ * @brief Awaitable push: `co_await async_push(ring, item);`
+ *
+ * Completes immediately if the ring has room, otherwise suspends until a
+ * poll() of the current executor manages the push (backpressure).
+ *
+ * Thread Safety: The executor thread must be the ring's only producer.
+ */
+template<typename T, size_t CAPACITY>
+coro_detail::PushAwaiter<T, CAPACITY> async_push(SPSCRingBuffer<T, CAPACITY>& ring, T value) noexcept {
+    return coro_detail::PushAwaiter<T, CAPACITY>(ring, std::move(value));
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "Qsbr.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+/**
+ * @brief RCU-style read-mostly publication of reference data.
+ *
+ * Symbol tables, risk limits and fee schedules are read on every order but
+ * change a few times a day. Published<T> keeps the current version behind a
+ * single atomic pointer: readers take it with a plain acquire load, writers
+ * build a complete new version off to the side and swap it in, and the old
+ * version is handed to a QsbrDomain that deletes it after a grace period.
+ *
+ * @tparam T The published type. Versions are immutable once published.
+ *
+ * Features:
+ * - Reader cost: one acquire load (a plain mov on x86), no RMW, no lock
+ * - Readers always see one complete version, never a mix of two
+ * - Writers are serialised among themselves and never block readers
+ * - Reclamation through quiescent states; see QsbrDomain
+ *
+ * Usage Constraints:
+ * - Reader threads hold a QsbrDomain::Reader on the same domain and must not
+ *   use a pointer from read() after their next quiescent() call
+ * - The domain must outlive the Published object
+ */
+template<typename T>
+class Published {
+public:
+    /**
+     * @brief Construct with an initial version.
+     *
+     * @param domain Reclamation domain for replaced versions.
+     * @param initial The first version; must not be null.
+     */
+    Published(QsbrDomain& domain, std::unique_ptr<T> initial) noexcept
+        : mDomain(domain), mCurrent(initial.release()) {}
+
+    /**
+     * @brief Delete the current version.
+     *
+     * Note: Assumes no reader is accessing the object during destruction.
+     * Replaced versions still pending are freed by the domain.
+     */
+    ~Published() noexcept {
+        delete mCurrent.load(std::memory_order_relaxed);
+    }
+
+    Published(const Published&) = delete;
+    Published& operator=(const Published&) = delete;
+
+    /**
+     * @brief Get the current version.
+     *
+     * @return const T* Valid until the calling reader's next quiescent state.
+     *
+     * Thread Safety: Safe from any registered reader, lock-free and RMW-free.
+     *
+     * Memory ordering:
+     * - acquire load: pairs with the release in publish(), so the whole
+     *   version is visible before its pointer
+     */
+    const T* read() const noexcept {
+        return mCurrent.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Swap in a new version and retire the old one.
+     *
+     * @param next The new version; must not be null.
+     *
+     * Thread Safety: Safe from multiple writer threads.
+     *
+     * Time Complexity: O(1) plus opportunistic reclamation of earlier versions
+     */
+    void publish(std::unique_ptr<T> next) {
+        std::lock_guard<std::mutex> lock(mWriteMutex);
+        swap_in(next.release());
+    }
+
+    /**
+     * @brief Copy the current version, modify the copy and publish it.
+     *
+     * @param fn Callable invoked as fn(T& copy) on a private copy.
+     *
+     * The read-copy-update runs under the writer mutex, so concurrent
+     * update() calls never lose each other's changes.
+     *
+     * Thread Safety: Safe from multiple writer threads.
+     */
+    template<typename F>
+    void update(F&& fn) {
+        std::lock_guard<std::mutex> lock(mWriteMutex);
+        auto next = std::make_unique<T>(*mCurrent.load(std::memory_order_relaxed));
+        fn(*next);
+        swap_in(next.release());
+    }
+
+    /**
+     * @brief Get the reclamation domain.
+     */
+    QsbrDomain& domain() noexcept {
+        return mDomain;
+    }
+
+private:
+    // Cache line size to keep the hot pointer away from writer state
+    static constexpr size_t CACHE_LINE = std::hardware_destructive_interference_size;
+
+    void swap_in(T* next) {
+        T* previous = mCurrent.exchange(next, std::memory_order_acq_rel);
+        mDomain.retire(previous);
+    }
+
+    QsbrDomain& mDomain;
+
+    // The current version, read by every reader
+    alignas(CACHE_LINE) std::atomic<T*> mCurrent;
+
+    // Serialises writers
+    alignas(CACHE_LINE) std::mutex mWriteMutex;
+};
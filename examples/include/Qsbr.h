@@ -0,0 +1,271 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Quiescent-state-based reclamation (QSBR) domain.
+ *
+ * Readers dereference shared pointers without any synchronisation and
+ * periodically announce a quiescent state: a point where they hold no
+ * references into shared data (e.g. between two events in their loop).
+ * Writers unlink an object, retire() it, and the domain frees it once
+ * every online reader has passed a quiescent state after the unlink.
+ *
+ * Features:
+ * - Reader cost: quiescent() is one load and one store, no RMW, no fence
+ * - Non-blocking retire(): reclamation is batched and opportunistic
+ * - Blocking synchronize() for writers that want an explicit grace period
+ * - Idle readers go offline() so they never hold up reclamation
+ *
+ * Grace Periods:
+ * - The domain keeps a global epoch, bumped by every retire()
+ * - quiescent() copies the global epoch into the reader's slot
+ * - An object retired at epoch E is freed once every online slot is >= E
+ *
+ * Usage Constraints:
+ * - Up to MAX_READERS reader threads, each holding one Reader handle
+ * - A thread must not touch shared objects while offline, and must not keep
+ *   references across a quiescent() call
+ * - Never call synchronize() from an online reader (it would wait for itself)
+ */
+class QsbrDomain {
+    struct Slot;
+
+public:
+    static constexpr size_t MAX_READERS = 64;
+
+    /**
+     * @brief Per-thread reader registration (RAII).
+     *
+     * A new handle starts online. Destroying it takes the reader offline and
+     * releases its slot.
+     */
+    class Reader {
+    public:
+        explicit Reader(QsbrDomain& domain) noexcept : mDomain(&domain) {
+            mSlot = domain.register_reader();
+            if (mSlot) {
+                online();
+            }
+        }
+
+        ~Reader() noexcept {
+            if (mSlot) {
+                offline();
+                mSlot->used.store(false, std::memory_order_release);
+            }
+        }
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        /**
+         * @brief Check whether a slot could be obtained.
+         */
+        bool is_registered() const noexcept {
+            return mSlot != nullptr;
+        }
+
+        /**
+         * @brief Announce that this thread holds no references into shared data.
+         *
+         * release: our earlier reads of retired objects are finished
+         * acquire: later loads see every pointer swapped before the epoch bump
+         */
+        void quiescent() noexcept {
+            uint64_t epoch = mDomain->mEpoch.load(std::memory_order_acquire);
+            mSlot->epoch.store(epoch, std::memory_order_release);
+        }
+
+        /**
+         * @brief Stop taking part in grace periods (e.g. before blocking or sleeping).
+         */
+        void offline() noexcept {
+            mSlot->epoch.store(OFFLINE, std::memory_order_release);
+        }
+
+        /**
+         * @brief Resume reading after offline().
+         *
+         * The fence orders our slot store before any following pointer load,
+         * pairing with the fence in min_epoch(): either the writer sees us
+         * online, or we see its new pointer.
+         */
+        void online() noexcept {
+            mSlot->epoch.store(mDomain->mEpoch.load(std::memory_order_acquire),
+                               std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+    private:
+        QsbrDomain* mDomain;
+        Slot* mSlot = nullptr;
+    };
+
+    QsbrDomain() = default;
+
+    /**
+     * @brief Free everything still retired.
+     *
+     * Note: Assumes no reader is accessing shared objects during destruction.
+     */
+    ~QsbrDomain() noexcept {
+        for (auto& retired : mRetired) {
+            retired.deleter(retired.ptr);
+        }
+    }
+
+    QsbrDomain(const QsbrDomain&) = delete;
+    QsbrDomain& operator=(const QsbrDomain&) = delete;
+
+    /**
+     * @brief Defer deletion of an object that is no longer reachable for new readers.
+     *
+     * @param ptr The unlinked object; deleted with `delete` after a grace period.
+     *
+     * Thread Safety: Safe from any thread, including online readers.
+     * Writers are serialised on an internal mutex; readers are never blocked.
+     */
+    template<typename T>
+    void retire(T* ptr) {
+        retire(ptr, [](void* p) { delete static_cast<T*>(p); });
+    }
+
+    /**
+     * @brief Defer a type-erased deleter call.
+     */
+    void retire(void* ptr, void (*deleter)(void*)) {
+        // seq_cst: the unlink that preceded this call is ordered before the bump
+        uint64_t epoch = mEpoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+        std::lock_guard<std::mutex> lock(mMutex);
+        mRetired.push_back(Retired{ptr, deleter, epoch});
+        reclaim_locked();
+    }
+
+    /**
+     * @brief Free every retired object whose grace period has elapsed.
+     *
+     * @return size_t Number of objects freed.
+     */
+    size_t reclaim() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return reclaim_locked();
+    }
+
+    /**
+     * @brief Wait until every online reader has passed a quiescent state, then reclaim.
+     *
+     * Thread Safety: Must not be called from an online reader thread.
+     */
+    void synchronize() {
+        uint64_t target = mEpoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+        while (min_epoch() < target) {
+            std::this_thread::yield();
+        }
+        reclaim();
+    }
+
+    /**
+     * @brief Get the number of objects waiting for a grace period.
+     */
+    size_t pending() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mRetired.size();
+    }
+
+    /**
+     * @brief Get the number of registered readers.
+     */
+    size_t readers() const noexcept {
+        size_t count = 0;
+        for (const auto& slot : mSlots) {
+            count += slot.used.load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+private:
+    // Cache line size to prevent false sharing between reader slots
+    static constexpr size_t CACHE_LINE = std::hardware_destructive_interference_size;
+
+    static constexpr uint64_t OFFLINE = 0;  ///< Slot epoch of an offline reader
+
+    /**
+     * @brief Per-reader slot: last observed epoch, or OFFLINE.
+     */
+    struct alignas(CACHE_LINE) Slot {
+        std::atomic<uint64_t> epoch{OFFLINE};
+        std::atomic<bool> used{false};
+    };
+
+    /**
+     * @brief An object waiting for its grace period.
+     */
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+        uint64_t epoch;
+    };
+
+    Slot* register_reader() noexcept {
+        for (auto& slot : mSlots) {
+            bool expected = false;
+            if (!slot.used.load(std::memory_order_relaxed) &&
+                slot.used.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Lowest epoch over all online readers (the current epoch if none).
+     */
+    uint64_t min_epoch() const noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint64_t min = mEpoch.load(std::memory_order_relaxed);
+        for (const auto& slot : mSlots) {
+            uint64_t epoch = slot.epoch.load(std::memory_order_acquire);
+            if (epoch != OFFLINE && epoch < min) {
+                min = epoch;
+            }
+        }
+        return min;
+    }
+
+    size_t reclaim_locked() {
+        if (mRetired.empty()) {
+            return 0;
+        }
+        uint64_t safe = min_epoch();
+        size_t freed = 0;
+        size_t kept = 0;
+        for (auto& retired : mRetired) {
+            if (retired.epoch <= safe) {
+                retired.deleter(retired.ptr);
+                ++freed;
+            } else {
+                mRetired[kept++] = retired;
+            }
+        }
+        mRetired.resize(kept);
+        return freed;
+    }
+
+    // Global epoch, starts above OFFLINE
+    alignas(CACHE_LINE) std::atomic<uint64_t> mEpoch{1};
+
+    // One slot per registered reader thread
+    std::array<Slot, MAX_READERS> mSlots{};
+
+    // Retired objects, only touched by writers
+    mutable std::mutex mMutex;
+    std::vector<Retired> mRetired;
+};
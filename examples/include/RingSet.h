@@ -0,0 +1,348 @@
+#pragma once
+
+#include "SPSCRingBuffer.h"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief A set of SPSC ring buffers polled through a doorbell bitmap.
+ *
+ * A consumer that owns many input rings (e.g. one per strategy) wastes most
+ * of its cycles loading the tail of rings that are empty. RingSet keeps one
+ * doorbell bit per ring: a producer rings the bell when its ring goes from
+ * idle to active, and the consumer only visits rings whose bit is set,
+ * finding them with countr_zero (tzcnt on x86 with BMI enabled).
+ *
+ * @tparam T The type of elements stored in each ring.
+ * @tparam CAPACITY Capacity of each ring. Must be a power of two.
+ * @tparam NUM_RINGS Number of rings in the set.
+ * @tparam RINGS_PER_SHARD Rings sharing one doorbell word. Each word sits on
+ *                         its own cache line so that producers of different
+ *                         shards never bounce the same line.
+ *
+ * Features:
+ * - Idle polling touches NUM_RINGS / RINGS_PER_SHARD cache lines instead of NUM_RINGS
+ * - No RMW or hardware fence per push: fetch_or only runs when the bit is clear
+ * - No lost wakeups: doorbells are only cleared behind a process-wide barrier
+ * - Per-ring FIFO order is preserved
+ *
+ * Doorbell Protocol:
+ * - Producer: push into ring, compiler fence, load doorbell word, fetch_or if bit clear
+ * - Consumer poll: drain every flagged ring with plain acquire loads; bits stay set
+ * - Consumer quiesce: clear the bits of empty rings, membarrier, re-check
+ *   those rings and ring again for any that are no longer empty
+ * Quiescing is the store-buffering pattern: either the producer sees the
+ * cleared bit and rings again, or the consumer's re-check sees the new
+ * tail. Both may happen, which only costs a spurious visit to an empty ring.
+ *
+ * Fences are asymmetric: the push path only stops the compiler from
+ * reordering the tail store past the doorbell load, and quiesce() runs
+ * membarrier(MEMBARRIER_CMD_PRIVATE_EXPEDITED). That syscall takes a few
+ * microseconds and sends an IPI to every CPU currently running a thread of
+ * this process, including unrelated pinned threads, so it must stay rare.
+ * poll() only quiesces after a run of consecutive polls that found nothing
+ * (see the constructor), i.e. when traffic has stopped and the consumer is
+ * about to idle: under steady load no barrier is issued at all. Call
+ * quiesce() directly before parking the consumer. Where membarrier is
+ * unavailable (non-Linux, old kernels, seccomp) both sides fall back to a
+ * seq_cst thread fence, which is a locked instruction on every push on x86.
+ *
+ * Usage Constraints:
+ * - Each ring has exactly ONE producer thread calling push(ring, ...)
+ * - Exactly ONE consumer thread calls poll()
+ * - The object is large (NUM_RINGS rings); allocate it on the heap
+ */
+template<typename T, std::size_t CAPACITY, std::size_t NUM_RINGS,
+         std::size_t RINGS_PER_SHARD = 8>
+class RingSet {
+    static_assert(NUM_RINGS >= 1, "RingSet needs at least one ring");
+    static_assert(RINGS_PER_SHARD >= 1 && RINGS_PER_SHARD <= 64,
+                  "A doorbell word holds at most 64 rings");
+
+public:
+    /**
+     * @brief Construct an empty set and register for expedited membarrier.
+     *
+     * @param idlePollsBeforeQuiesce Consecutive polls that deliver nothing
+     *        while doorbells are set before poll() calls quiesce(). Larger
+     *        values mean fewer barriers and more visits to empty rings.
+     */
+    explicit RingSet(size_t idlePollsBeforeQuiesce = 64) noexcept
+        : mUseMembarrier(register_membarrier()),
+          mIdlePollLimit(idlePollsBeforeQuiesce ? idlePollsBeforeQuiesce : 1) {}
+
+    /**
+     * @brief Push an item onto one ring (copy version).
+     *
+     * @param ring Index of the ring, in [0, NUM_RINGS).
+     * @param item The item to push.
+     * @return true if the item was pushed.
+     * @return false if that ring is full.
+     *
+     * Thread Safety: May ONLY be called by the producer that owns this ring.
+     */
+    bool push(size_t ring, const T& item) noexcept {
+        if (!mRings[ring].push(item)) {
+            return false;
+        }
+        ring_doorbell(ring);
+        return true;
+    }
+
+    /**
+     * @brief Push an item onto one ring (move version).
+     *
+     * @param ring Index of the ring, in [0, NUM_RINGS).
+     * @param item The item to move onto the ring.
+     * @return true if the item was pushed.
+     * @return false if that ring is full.
+     */
+    bool push(size_t ring, T&& item) noexcept {
+        if (!mRings[ring].push(std::move(item))) {
+            return false;
+        }
+        ring_doorbell(ring);
+        return true;
+    }
+
+    /**
+     * @brief Visit every ring whose doorbell is set and drain it.
+     *
+     * @param fn Callable invoked as fn(size_t ring, T&& item).
+     * @param maxPerRing Upper bound on items taken from one ring per call.
+     * @return size_t Total number of items consumed.
+     *
+     * Doorbells stay set after draining, so a busy ring costs no RMW or
+     * barrier on either side; they are cleared by quiesce().
+     *
+     * Thread Safety: May ONLY be called by the single consumer thread.
+     *
+     * Time Complexity: O(shards + flagged rings + items)
+     */
+    template<typename F>
+    size_t poll(F&& fn, size_t maxPerRing = CAPACITY) noexcept {
+        size_t total = 0;
+        bool flagged = false;
+        for (size_t shard = 0; shard < NUM_SHARDS; ++shard) {
+            // Acquire pairs with the producer's fetch_or: a newly rung ring's items are visible
+            uint64_t pending = mDoorbells[shard].bits.load(std::memory_order_acquire);
+            flagged |= pending != 0;
+            while (pending) {
+                unsigned bit = std::countr_zero(pending);
+                pending &= pending - 1;  // clear lowest set bit
+
+                size_t ring = shard * RINGS_PER_SHARD + bit;
+                total += mRings[ring].pop_batch(
+                        [&](T&& item) { fn(ring, std::move(item)); }, maxPerRing);
+            }
+        }
+
+        if (total != 0 || !flagged) {
+            mIdlePolls = 0;
+        } else if (++mIdlePolls >= mIdlePollLimit) {
+            quiesce();
+        }
+        return total;
+    }
+
+    /**
+     * @brief Clear the doorbells of empty rings behind one barrier.
+     *
+     * @return true if every doorbell is clear afterwards, i.e. the consumer
+     *         may park until a producer rings again.
+     *
+     * Thread Safety: May ONLY be called by the single consumer thread.
+     *
+     * Time Complexity: O(shards + flagged rings), plus one membarrier
+     * syscall if any doorbell was cleared
+     */
+    bool quiesce() noexcept {
+        mIdlePolls = 0;
+
+        std::array<uint64_t, NUM_SHARDS> cleared;
+        bool anyCleared = false;
+        for (size_t shard = 0; shard < NUM_SHARDS; ++shard) {
+            uint64_t pending = mDoorbells[shard].bits.load(std::memory_order_relaxed);
+            uint64_t idle = 0;
+            while (pending) {
+                unsigned bit = std::countr_zero(pending);
+                pending &= pending - 1;
+                if (mRings[shard * RINGS_PER_SHARD + bit].empty()) {
+                    idle |= uint64_t{1} << bit;
+                }
+            }
+            cleared[shard] = idle;
+            if (idle) {
+                mDoorbells[shard].bits.fetch_and(~idle, std::memory_order_seq_cst);
+                anyCleared = true;
+            }
+        }
+        if (!anyCleared) {
+            return !any();
+        }
+
+        heavy_fence();
+
+        // A producer that saw its bit still set has its tail visible by now
+        for (size_t shard = 0; shard < NUM_SHARDS; ++shard) {
+            uint64_t pending = cleared[shard];
+            uint64_t refill = 0;
+            while (pending) {
+                unsigned bit = std::countr_zero(pending);
+                pending &= pending - 1;
+                if (!mRings[shard * RINGS_PER_SHARD + bit].empty()) {
+                    refill |= uint64_t{1} << bit;
+                }
+            }
+            if (refill) {
+                mDoorbells[shard].bits.fetch_or(refill, std::memory_order_relaxed);
+            }
+        }
+        return !any();
+    }
+
+    /**
+     * @brief Check whether any doorbell is set.
+     *
+     * Note: Approximate; intended for idle detection and monitoring.
+     */
+    bool any() const noexcept {
+        for (const auto& doorbell : mDoorbells) {
+            if (doorbell.bits.load(std::memory_order_relaxed) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Get the number of rings whose doorbell is currently set.
+     *
+     * Note: Approximate; intended for monitoring.
+     */
+    size_t active_rings() const noexcept {
+        size_t count = 0;
+        for (const auto& doorbell : mDoorbells) {
+            count += std::popcount(doorbell.bits.load(std::memory_order_relaxed));
+        }
+        return count;
+    }
+
+    /**
+     * @brief Check whether quiesce() uses membarrier instead of per-push fences.
+     */
+    bool uses_membarrier() const noexcept {
+        return mUseMembarrier;
+    }
+
+    /**
+     * @brief Get the number of rings in the set.
+     */
+    static constexpr size_t size() noexcept {
+        return NUM_RINGS;
+    }
+
+private:
+    static constexpr size_t CACHE_LINE = std::hardware_destructive_interference_size;
+    static constexpr size_t NUM_SHARDS = (NUM_RINGS + RINGS_PER_SHARD - 1) / RINGS_PER_SHARD;
+
+    /**
+     * @brief One shard of the doorbell bitmap, alone on its cache line.
+     */
+    struct alignas(CACHE_LINE) Doorbell {
+        std::atomic<uint64_t> bits{0};
+    };
+
+    /**
+     * @brief Register the process for private expedited membarrier, once.
+     *
+     * @return true if the command is supported and registration succeeded.
+     */
+    static bool register_membarrier() noexcept {
+#if defined(__linux__) && defined(SYS_membarrier)
+        static const bool registered = []() {
+            long cmds = ::syscall(SYS_membarrier, MEMBARRIER_CMD_QUERY, 0, 0);
+            if (cmds < 0 || (cmds & MEMBARRIER_CMD_PRIVATE_EXPEDITED) == 0) {
+                return false;
+            }
+            return ::syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+        }();
+        return registered;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Consumer side of the doorbell barrier pair.
+     *
+     * After membarrier returns, every running producer has passed a full
+     * barrier, so a tail store that preceded its doorbell load is visible to
+     * the re-check that follows. A failed call falls back to the fence, which
+     * is only sufficient if producers fence too; registration failures are
+     * caught at construction, so this path is not expected to be taken.
+     */
+    void heavy_fence() const noexcept {
+#if defined(__linux__) && defined(SYS_membarrier)
+        if (mUseMembarrier &&
+            ::syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0) == 0) {
+            return;
+        }
+#endif
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    /**
+     * @brief Flag a ring as active after a successful push.
+     *
+     * The fence orders the tail store of the push before the doorbell load;
+     * the consumer's clear + membarrier mirrors it. With membarrier only
+     * the compiler is fenced; the fetch_or runs only when the consumer has
+     * cleared the bit, i.e. once per idle-to-active transition.
+     */
+    void ring_doorbell(size_t ring) noexcept {
+        auto& word = mDoorbells[ring / RINGS_PER_SHARD].bits;
+        uint64_t mask = uint64_t{1} << (ring % RINGS_PER_SHARD);
+
+        if (mUseMembarrier) {
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+        } else {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        if ((word.load(std::memory_order_relaxed) & mask) == 0) {
+            word.fetch_or(mask, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief Doorbell bitmap, one cache line per shard.
+     *
+     * Written by producers on idle-to-active transitions, cleared by quiesce().
+     */
+    std::array<Doorbell, NUM_SHARDS> mDoorbells{};
+
+    /**
+     * @brief The rings themselves; each one carries its own head/tail padding.
+     */
+    std::array<SPSCRingBuffer<T, CAPACITY>, NUM_RINGS> mRings;
+
+    /**
+     * @brief Whether the asymmetric barrier pair is in use; fixed at construction.
+     */
+    const bool mUseMembarrier;
+
+    const size_t mIdlePollLimit;   ///< Empty polls with doorbells set before quiescing
+    size_t mIdlePolls = 0;         ///< Consumer-only
+};
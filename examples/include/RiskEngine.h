@@ -0,0 +1,280 @@
+#pragma once
+
+#include "MPSCQueue.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+/**
+ * @brief An order as seen by the pre-trade risk stage.
+ *
+ * Instruments and accounts are dense ids (e.g. from SymbolTable), prices
+ * are integer ticks, so every check is integer math over flat arrays.
+ */
+struct RiskOrder {
+    uint64_t orderId;
+    uint32_t account;
+    uint32_t instrument;
+    int64_t price;   ///< Limit price in ticks
+    int64_t qty;     ///< Positive quantity
+    bool buy;
+};
+
+/**
+ * @brief Execution-report delta applied by the position-keeping thread.
+ *
+ * An order's quantity leaves the "working" state either by filling or by
+ * being cancelled/rejected downstream.
+ */
+struct RiskExecution {
+    uint32_t account;
+    uint32_t instrument;
+    int64_t orderPrice;     ///< Price the order was checked at (releases its notional)
+    int64_t filledQty;      ///< Newly filled quantity (changes the position)
+    int64_t cancelledQty;   ///< Quantity that will never fill
+    bool buy;
+};
+
+/**
+ * @brief Outcome of a risk check.
+ */
+enum class RiskResult : uint8_t {
+    ACCEPTED,
+    UNKNOWN_INSTRUMENT,
+    UNKNOWN_ACCOUNT,
+    ORDER_QTY,          ///< Above the instrument's max order size
+    PRICE_BAND,         ///< Outside the instrument's fat-finger band
+    POSITION,           ///< Worst-case position would exceed the limit
+    ORDER_NOTIONAL,     ///< Above the account's max order notional
+    ACCOUNT_EXPOSURE,   ///< Working notional would exceed the account limit
+    HALTED,             ///< Account kill switch is on
+};
+
+/**
+ * @brief Static per-instrument limits.
+ */
+struct InstrumentLimits {
+    int64_t maxOrderQty = 0;
+    int64_t maxPosition = 0;   ///< Absolute net position limit
+    int64_t minPrice = 0;      ///< Price band, inclusive
+    int64_t maxPrice = 0;
+};
+
+/**
+ * @brief Static per-account limits.
+ */
+struct AccountLimits {
+    int64_t maxOrderNotional = 0;
+    int64_t maxWorkingNotional = 0;   ///< Notional of orders sent but not yet filled or cancelled
+};
+
+/**
+ * @brief Pre-trade risk checks over flat arrays with single-writer accounting.
+ *
+ * Every quantity is owned by exactly one thread, so nothing is locked and
+ * nothing is read-modify-written atomically:
+ * - The checking thread owns what it sent: per-instrument sent buy/sell
+ *   quantity and per-account sent notional (plain arrays)
+ * - The execution thread owns what came back: per-instrument filled
+ *   position and done (filled + cancelled) buy/sell quantity, per-account
+ *   done notional (atomics it stores and the checker loads)
+ *
+ * Working quantity is sent - done, and the position check uses the worst
+ * case: a buy is accepted only if position + working buys + qty stays
+ * within the limit, whatever happens to the working orders.
+ *
+ * Features:
+ * - A check is a handful of loads and compares on two array entries
+ * - check_batch() drains an MPSCQueue run and checks it in one pass
+ * - Per-account kill switch settable from any thread
+ * - Stale reads are safe: the execution thread only ever reduces working
+ *   quantity, so the checker can only over-estimate risk
+ *
+ * Usage Constraints:
+ * - check()/check_batch() from one checking thread only
+ * - apply() from one execution-report thread only
+ * - Set limits before trading starts
+ */
+class RiskEngine {
+public:
+    /**
+     * @brief Construct with fixed universes (ids are [0, count)).
+     */
+    RiskEngine(size_t instruments, size_t accounts)
+        : mInstrumentCount(instruments),
+          mAccountCount(accounts),
+          mInstruments(std::make_unique<InstrumentState[]>(instruments)),
+          mInstrumentFills(std::make_unique<InstrumentFills[]>(instruments)),
+          mAccounts(std::make_unique<AccountState[]>(accounts)),
+          mAccountFills(std::make_unique<AccountFills[]>(accounts)) {}
+
+    void set_instrument_limits(uint32_t instrument, const InstrumentLimits& limits) noexcept {
+        mInstruments[instrument].limits = limits;
+    }
+
+    void set_account_limits(uint32_t account, const AccountLimits& limits) noexcept {
+        mAccounts[account].limits = limits;
+    }
+
+    /**
+     * @brief Turn an account's kill switch on or off.
+     *
+     * Thread Safety: Safe to call from any thread.
+     */
+    void halt(uint32_t account, bool halted = true) noexcept {
+        mAccountFills[account].halted.store(halted, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Check one order; if accepted, count it as working.
+     *
+     * @return RiskResult::ACCEPTED or the first limit breached.
+     *
+     * Thread Safety: Checking thread only.
+     *
+     * Time Complexity: O(1)
+     */
+    RiskResult check(const RiskOrder& order) noexcept {
+        if (order.instrument >= mInstrumentCount) [[unlikely]] {
+            return RiskResult::UNKNOWN_INSTRUMENT;
+        }
+        if (order.account >= mAccountCount) [[unlikely]] {
+            return RiskResult::UNKNOWN_ACCOUNT;
+        }
+        InstrumentState& instrument = mInstruments[order.instrument];
+        AccountState& account = mAccounts[order.account];
+        const InstrumentFills& fills = mInstrumentFills[order.instrument];
+        const AccountFills& accountFills = mAccountFills[order.account];
+
+        if (accountFills.halted.load(std::memory_order_relaxed)) {
+            return RiskResult::HALTED;
+        }
+        if (order.qty <= 0 || order.qty > instrument.limits.maxOrderQty) {
+            return RiskResult::ORDER_QTY;
+        }
+        if (order.price < instrument.limits.minPrice || order.price > instrument.limits.maxPrice) {
+            return RiskResult::PRICE_BAND;
+        }
+
+        // acquire on "done" first: a fill seen as done is also seen in the position
+        if (order.buy) {
+            int64_t working = instrument.sentBuy - fills.doneBuy.load(std::memory_order_acquire);
+            int64_t position = fills.position.load(std::memory_order_relaxed);
+            if (position + working + order.qty > instrument.limits.maxPosition) {
+                return RiskResult::POSITION;
+            }
+        } else {
+            int64_t working = instrument.sentSell - fills.doneSell.load(std::memory_order_acquire);
+            int64_t position = fills.position.load(std::memory_order_relaxed);
+            if (position - working - order.qty < -instrument.limits.maxPosition) {
+                return RiskResult::POSITION;
+            }
+        }
+
+        int64_t notional = order.price * order.qty;
+        if (notional > account.limits.maxOrderNotional) {
+            return RiskResult::ORDER_NOTIONAL;
+        }
+        int64_t working = account.sentNotional - accountFills.doneNotional.load(std::memory_order_relaxed);
+        if (working + notional > account.limits.maxWorkingNotional) {
+            return RiskResult::ACCOUNT_EXPOSURE;
+        }
+
+        // Accepted: count as working until the execution thread reports it done
+        (order.buy ? instrument.sentBuy : instrument.sentSell) += order.qty;
+        account.sentNotional += notional;
+        return RiskResult::ACCEPTED;
+    }
+
+    /**
+     * @brief Drain up to maxItems orders from a queue and check them.
+     *
+     * @param queue Strategy-to-gateway queue (this thread is its consumer).
+     * @param onResult Callable invoked as onResult(const RiskOrder&, RiskResult).
+     * @return size_t Number of orders checked.
+     *
+     * Thread Safety: Checking thread only.
+     */
+    template<typename F>
+    size_t check_batch(MPSCQueue<RiskOrder>& queue, F&& onResult, size_t maxItems) noexcept {
+        return queue.pop_batch([&](RiskOrder&& order) {
+            onResult(static_cast<const RiskOrder&>(order), check(order));
+        }, maxItems);
+    }
+
+    /**
+     * @brief Apply an execution report: move quantity from working to done
+     *        and update the filled position.
+     *
+     * Thread Safety: Execution-report thread only.
+     */
+    void apply(const RiskExecution& execution) noexcept {
+        InstrumentFills& fills = mInstrumentFills[execution.instrument];
+        AccountFills& account = mAccountFills[execution.account];
+        int64_t done = execution.filledQty + execution.cancelledQty;
+
+        // Single writer: plain load + store, no locked instructions. The
+        // position is stored before "done" (release) so the checker never
+        // sees quantity leave "working" before it shows up in the position.
+        int64_t delta = execution.buy ? execution.filledQty : -execution.filledQty;
+        fills.position.store(fills.position.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+        std::atomic<int64_t>& side = execution.buy ? fills.doneBuy : fills.doneSell;
+        side.store(side.load(std::memory_order_relaxed) + done, std::memory_order_release);
+        account.doneNotional.store(account.doneNotional.load(std::memory_order_relaxed) + done * execution.orderPrice,
+                                   std::memory_order_release);
+    }
+
+    /**
+     * @brief Filled net position of an instrument.
+     */
+    int64_t position(uint32_t instrument) const noexcept {
+        return mInstrumentFills[instrument].position.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Working (sent, not yet done) notional of an account.
+     *
+     * Thread Safety: Checking thread only (reads its own sent notional).
+     */
+    int64_t working_notional(uint32_t account) const noexcept {
+        return mAccounts[account].sentNotional -
+               mAccountFills[account].doneNotional.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t CACHE_LINE = std::hardware_destructive_interference_size;
+
+    // Owned by the checking thread
+    struct InstrumentState {
+        InstrumentLimits limits;
+        int64_t sentBuy = 0;
+        int64_t sentSell = 0;
+    };
+
+    struct AccountState {
+        AccountLimits limits;
+        int64_t sentNotional = 0;
+    };
+
+    // Owned by the execution thread, read by the checking thread
+    struct InstrumentFills {
+        std::atomic<int64_t> position{0};
+        std::atomic<int64_t> doneBuy{0};
+        std::atomic<int64_t> doneSell{0};
+    };
+
+    struct alignas(CACHE_LINE) AccountFills {
+        std::atomic<int64_t> doneNotional{0};
+        std::atomic<bool> halted{false};
+    };
+
+    const size_t mInstrumentCount;
+    const size_t mAccountCount;
+    std::unique_ptr<InstrumentState[]> mInstruments;
+    std::unique_ptr<InstrumentFills[]> mInstrumentFills;
+    std::unique_ptr<AccountState[]> mAccounts;
+    std::unique_ptr<AccountFills[]> mAccountFills;
+};
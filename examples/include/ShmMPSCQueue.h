@@ -0,0 +1,535 @@
+#pragma once
+
+#include "Tsc.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace shm_detail {
+
+/**
+ * @brief Get a process's start time (field 22 of /proc/<pid>/stat, in clock
+ *        ticks since boot), or 0 if it cannot be read.
+ *
+ * A pid is reused once its process is reaped; (pid, start time) is not.
+ */
+inline uint64_t process_start_time(int32_t pid) noexcept {
+    char path[32];
+    std::snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return 0;
+    }
+    char buffer[512];
+    ssize_t n = ::read(fd, buffer, sizeof(buffer) - 1);
+    ::close(fd);
+    if (n <= 0) {
+        return 0;
+    }
+    buffer[n] = '\0';
+
+    // The command name (field 2) may contain spaces and ')': count fields after the last ')'
+    const char* p = std::strrchr(buffer, ')');
+    if (!p) {
+        return 0;
+    }
+    for (int field = 2; field < 22 && *p; ++p) {
+        field += *p == ' ';
+    }
+    uint64_t ticks = 0;
+    for (; *p >= '0' && *p <= '9'; ++p) {
+        ticks = ticks * 10 + uint64_t(*p - '0');
+    }
+    return ticks;
+}
+
+}  // namespace shm_detail
+
+/**
+ * @brief Shared-memory layout of a ShmMPSCQueue.
+ *
+ * Everything is addressed by index, never by pointer, so every process can
+ * map the segment at a different address. Each slot carries one state word
+ * that encodes the position it is valid for, its phase and its owner:
+ *
+ *     state = position << 16 | epoch << 8 | phase << 6 | owner
+ *
+ * - FREE(p):         slot may be claimed for position p
+ * - CLAIMED(p, o):   producer o owns position p and is writing it
+ * - PUBLISHED(p, o): position p is ready for the consumer
+ *
+ * The owner is an index into the producer registration table; the epoch
+ * (low 8 bits of the entry's registration count) tells a claim made by the
+ * current holder of that entry from one left behind by a dead predecessor.
+ * Each entry also records its process's start time, so a pid reused by an
+ * unrelated process is not mistaken for the registered producer.
+ *
+ * @tparam T Trivially copyable message type.
+ * @tparam CAPACITY Number of slots. Must be a power of two.
+ */
+template<typename T, std::size_t CAPACITY>
+struct ShmMPSCLayout {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Shared-memory messages must be trivially copyable");
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0 && CAPACITY >= 2,
+                  "CAPACITY must be a power of two >= 2");
+
+    static constexpr uint64_t MAGIC = 0x48465453484d5143ull;  // "HFTSHMQC"
+    static constexpr uint32_t VERSION = 2;
+    static constexpr size_t CACHE_LINE = 64;
+    static constexpr uint32_t MAX_PRODUCERS = 64;
+
+    static constexpr uint64_t FREE = 0;
+    static constexpr uint64_t CLAIMED = 1;
+    static constexpr uint64_t PUBLISHED = 2;
+
+    static constexpr uint64_t make(uint64_t pos, uint64_t phase, uint64_t owner,
+                                   uint64_t epoch = 0) noexcept {
+        return (pos << 16) | ((epoch & 0xFF) << 8) | (phase << 6) | owner;
+    }
+    static constexpr uint64_t position(uint64_t state) noexcept { return state >> 16; }
+    static constexpr uint64_t epoch(uint64_t state) noexcept { return (state >> 8) & 0xFF; }
+    static constexpr uint64_t phase(uint64_t state) noexcept { return (state >> 6) & 3; }
+    static constexpr uint32_t owner(uint64_t state) noexcept { return state & 63; }
+
+    // Registration entry word: pid in the low half, registration count in the high half
+    static constexpr uint64_t entry(int32_t pid, uint32_t count) noexcept {
+        return (uint64_t(count) << 32) | uint32_t(pid);
+    }
+    static constexpr int32_t pid(uint64_t entry) noexcept { return int32_t(uint32_t(entry)); }
+    static constexpr uint32_t count(uint64_t entry) noexcept { return uint32_t(entry >> 32); }
+
+    // Identity word: low 24 bits of the registration count above a 40-bit process start time
+    static constexpr uint64_t identity(uint32_t count, uint64_t startTime) noexcept {
+        return (uint64_t(count & 0xFFFFFF) << 40) | (startTime & ((uint64_t{1} << 40) - 1));
+    }
+
+    /**
+     * @brief One message slot, alone on its cache line(s).
+     */
+    struct alignas(CACHE_LINE) Slot {
+        std::atomic<uint64_t> state;
+        T data;
+    };
+
+    /**
+     * @brief Producer registration entry: pid of the attached process (0 if free)
+     * and how many times the entry was taken, plus that process's start time.
+     */
+    struct alignas(CACHE_LINE) Producer {
+        std::atomic<uint64_t> entry;
+        std::atomic<uint64_t> identity;   ///< identity(count, start time), written after entry
+    };
+
+    /**
+     * @brief Check whether the process registered in an entry still exists.
+     *
+     * kill(pid, 0) alone cannot tell a reused pid from the original process;
+     * the recorded start time can. An identity not yet written for this
+     * registration (count mismatch) falls back to kill() only.
+     */
+    static bool alive(const Producer& producer, uint64_t entry) noexcept {
+        int32_t process = pid(entry);
+        if (process == 0 || (::kill(process, 0) != 0 && errno == ESRCH)) {
+            return false;
+        }
+        uint64_t recorded = producer.identity.load(std::memory_order_acquire);
+        if (recorded >> 40 != (count(entry) & 0xFFFFFF)) {
+            return true;
+        }
+        uint64_t startTime = shm_detail::process_start_time(process);
+        return startTime == 0 || identity(count(entry), startTime) == recorded;
+    }
+
+    uint64_t magic;
+    uint32_t version;
+    uint32_t slotSize;
+    uint64_t capacity;
+
+    // Claim hint for producers; slots are claimed by CAS on their own state
+    alignas(CACHE_LINE) std::atomic<uint64_t> tail;
+
+    Producer producers[MAX_PRODUCERS];
+    Slot slots[CAPACITY];
+};
+
+/**
+ * @brief Producer side of an inter-process bounded MPSC queue.
+ *
+ * Strategy processes attach as producers and send orders to one gateway
+ * process (the ShmMPSCConsumer). Unlike MPSCQueue there is no `new` and no
+ * raw pointer: slots are pre-mapped and linked by position only.
+ *
+ * Features:
+ * - Bounded, pre-mapped slot array; push never allocates
+ * - Per-slot state words: a slot is claimed with one CAS on its own line
+ * - Two-phase claim()/publish() for writing in place
+ * - Registration table with liveness: a crashed producer's claimed slot is
+ *   reclaimed by the consumer instead of blocking the queue forever
+ *
+ * Usage Constraints:
+ * - At most MAX_PRODUCERS (64) attached producer objects at a time
+ * - A producer object is used by one thread
+ */
+template<typename T, std::size_t CAPACITY>
+class ShmMPSCProducer {
+    using Layout = ShmMPSCLayout<T, CAPACITY>;
+
+public:
+    /**
+     * @brief Attach to an existing queue and register as a producer.
+     *
+     * @param name POSIX shm name used by the consumer.
+     *
+     * Check is_open() afterwards; attaching fails if the segment is missing,
+     * has a different layout, or all producer entries are taken by live processes.
+     */
+    explicit ShmMPSCProducer(const std::string& name) noexcept {
+        int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != sizeof(Layout)) {
+            ::close(fd);
+            return;
+        }
+        void* addr = ::mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            return;
+        }
+
+        auto layout = static_cast<Layout*>(addr);
+        if (layout->magic != Layout::MAGIC || layout->version != Layout::VERSION ||
+            layout->slotSize != sizeof(typename Layout::Slot) || layout->capacity != CAPACITY) {
+            ::munmap(addr, sizeof(Layout));
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (!register_self(layout)) {
+            ::munmap(addr, sizeof(Layout));
+            return;
+        }
+        mLayout = layout;
+    }
+
+    /**
+     * @brief Deregister and unmap.
+     */
+    ~ShmMPSCProducer() noexcept {
+        if (mLayout) {
+            mLayout->producers[mId].entry.store(Layout::entry(0, mCount), std::memory_order_release);
+            ::munmap(mLayout, sizeof(Layout));
+        }
+    }
+
+    ShmMPSCProducer(const ShmMPSCProducer&) = delete;
+    ShmMPSCProducer& operator=(const ShmMPSCProducer&) = delete;
+
+    /**
+     * @brief Check whether the producer is attached.
+     */
+    bool is_open() const noexcept {
+        return mLayout != nullptr;
+    }
+
+    /**
+     * @brief Claim the next slot for writing in place.
+     *
+     * @return T* Slot payload to fill, or nullptr if the queue is full.
+     *
+     * Every successful claim() must be followed by publish() from the same
+     * producer before the next claim().
+     */
+    T* claim() noexcept {
+        uint64_t pos = mLayout->tail.load(std::memory_order_relaxed);
+        while (true) {
+            auto& slot = mLayout->slots[pos & (CAPACITY - 1)];
+            uint64_t state = slot.state.load(std::memory_order_acquire);
+            uint64_t slotPos = Layout::position(state);
+
+            if (slotPos == pos && Layout::phase(state) == Layout::FREE) {
+                if (slot.state.compare_exchange_weak(state, Layout::make(pos, Layout::CLAIMED, mId, mCount),
+                                                     std::memory_order_acquire,
+                                                     std::memory_order_relaxed)) {
+                    // Move the hint on; losing this CAS just means someone helped
+                    uint64_t expected = pos;
+                    mLayout->tail.compare_exchange_strong(expected, pos + 1, std::memory_order_relaxed);
+                    mClaimed = &slot;
+                    mClaimedPos = pos;
+                    return &slot.data;
+                }
+                continue;  // lost the race for this slot, re-read it
+            }
+
+            if (slotPos < pos) {
+                return nullptr;  // previous lap not consumed yet: queue is full
+            }
+            // Claimed for pos by someone else, or already past it (consumed, or
+            // reclaimed after its claimer died before moving the hint): either
+            // way pos is taken, so help the hint forward
+            mLayout->tail.compare_exchange_strong(pos, pos + 1, std::memory_order_relaxed);
+            pos = mLayout->tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Publish the slot returned by the last claim().
+     */
+    void publish() noexcept {
+        mClaimed->state.store(Layout::make(mClaimedPos, Layout::PUBLISHED, mId, mCount),
+                              std::memory_order_release);
+        mClaimed = nullptr;
+    }
+
+    /**
+     * @brief Copy a message into the queue.
+     *
+     * @return true if the message was enqueued.
+     * @return false if the queue is full.
+     */
+    bool push(const T& message) noexcept {
+        T* slot = claim();
+        if (!slot) {
+            return false;
+        }
+        std::memcpy(static_cast<void*>(slot), &message, sizeof(T));
+        publish();
+        return true;
+    }
+
+    /**
+     * @brief Get this producer's registration index.
+     */
+    uint32_t id() const noexcept {
+        return mId;
+    }
+
+private:
+    /**
+     * @brief Take a free registration entry, or one left behind by a dead process.
+     */
+    bool register_self(Layout* layout) noexcept {
+        int32_t self = static_cast<int32_t>(::getpid());
+        for (uint32_t i = 0; i < Layout::MAX_PRODUCERS; ++i) {
+            auto& entry = layout->producers[i].entry;
+            uint64_t current = entry.load(std::memory_order_acquire);
+            int32_t pid = Layout::pid(current);
+            bool stale = pid != 0 && !Layout::alive(layout->producers[i], current);
+            uint32_t count = Layout::count(current) + 1;
+            if ((pid == 0 || stale) &&
+                entry.compare_exchange_strong(current, Layout::entry(self, count),
+                                              std::memory_order_acq_rel)) {
+                layout->producers[i].identity.store(
+                        Layout::identity(count, shm_detail::process_start_time(self)),
+                        std::memory_order_release);
+                mId = i;
+                mCount = count;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Layout* mLayout = nullptr;
+    typename Layout::Slot* mClaimed = nullptr;
+    uint64_t mClaimedPos = 0;
+    uint32_t mId = 0;
+    uint32_t mCount = 0;    ///< Registration count of our entry (claim epoch)
+};
+
+/**
+ * @brief Consumer side (gateway) of an inter-process bounded MPSC queue.
+ *
+ * Creates the segment and pops messages in position order. If the slot at
+ * the head stays CLAIMED for longer than the stall timeout, the consumer
+ * checks whether the owning producer process is still alive; if it is gone
+ * the slot is skipped and counted in abandoned().
+ *
+ * Usage Constraints:
+ * - Exactly ONE consumer per queue name, used by one thread
+ */
+template<typename T, std::size_t CAPACITY>
+class ShmMPSCConsumer {
+    using Layout = ShmMPSCLayout<T, CAPACITY>;
+
+public:
+    /**
+     * @brief Create a fresh queue segment.
+     *
+     * Any previous segment of that name is unlinked first rather than
+     * truncated, so producers still mapping it keep a valid (stale) mapping
+     * instead of faulting; they must re-attach to reach the new queue.
+     *
+     * @param name POSIX shm name, e.g. "/gw.orders".
+     * @param stallTimeoutNs How long a CLAIMED head slot may block before the
+     *                       owner's liveness is checked.
+     *
+     * Check is_open() afterwards.
+     */
+    explicit ShmMPSCConsumer(const std::string& name, uint64_t stallTimeoutNs = 1000000) noexcept
+        : mStallTicks(Tsc::from_ns(stallTimeoutNs)) {
+        ::shm_unlink(name.c_str());
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) {
+            return;
+        }
+        if (::ftruncate(fd, static_cast<off_t>(sizeof(Layout))) != 0) {
+            ::close(fd);
+            return;
+        }
+        void* addr = ::mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            return;
+        }
+
+        // ftruncate zero-fills: only non-zero fields need initialising
+        auto layout = static_cast<Layout*>(addr);
+        for (size_t i = 0; i < CAPACITY; ++i) {
+            layout->slots[i].state.store(Layout::make(i, Layout::FREE, 0), std::memory_order_relaxed);
+        }
+        layout->version = Layout::VERSION;
+        layout->slotSize = sizeof(typename Layout::Slot);
+        layout->capacity = CAPACITY;
+
+        // Magic last: producers only attach to a fully initialised segment
+        std::atomic_thread_fence(std::memory_order_release);
+        layout->magic = Layout::MAGIC;
+        mLayout = layout;
+    }
+
+    /**
+     * @brief Unmap the segment. The name stays until unlink() is called.
+     */
+    ~ShmMPSCConsumer() noexcept {
+        if (mLayout) {
+            ::munmap(mLayout, sizeof(Layout));
+        }
+    }
+
+    ShmMPSCConsumer(const ShmMPSCConsumer&) = delete;
+    ShmMPSCConsumer& operator=(const ShmMPSCConsumer&) = delete;
+
+    /**
+     * @brief Check whether the segment was created and mapped.
+     */
+    bool is_open() const noexcept {
+        return mLayout != nullptr;
+    }
+
+    /**
+     * @brief Pop the next message.
+     *
+     * @param message Receives the message.
+     * @return true if a message was popped.
+     * @return false if the queue is empty or the head is still being written.
+     */
+    bool pop(T& message) noexcept {
+        while (true) {
+            auto& slot = mLayout->slots[mHead & (CAPACITY - 1)];
+            uint64_t state = slot.state.load(std::memory_order_acquire);
+            if (Layout::position(state) != mHead || Layout::phase(state) == Layout::FREE) {
+                return false;  // nothing claimed at the head yet
+            }
+
+            if (Layout::phase(state) == Layout::PUBLISHED) {
+                std::memcpy(&message, &slot.data, sizeof(T));
+                release_head(slot);
+                return true;
+            }
+
+            // CLAIMED: the owner is still writing, or died while writing
+            if (!reclaim_if_abandoned(slot, state)) {
+                return false;
+            }
+        }
+    }
+
+    /**
+     * @brief Get the number of slots skipped because their producer died.
+     */
+    uint64_t abandoned() const noexcept {
+        return mAbandoned;
+    }
+
+    /**
+     * @brief Get the number of attached producers.
+     */
+    uint32_t producers() const noexcept {
+        uint32_t count = 0;
+        for (const auto& producer : mLayout->producers) {
+            count += Layout::pid(producer.entry.load(std::memory_order_relaxed)) != 0;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Remove the shm name; existing mappings stay valid.
+     */
+    static void unlink(const std::string& name) noexcept {
+        ::shm_unlink(name.c_str());
+    }
+
+private:
+    /**
+     * @brief Hand the head slot back to producers for the next lap.
+     */
+    void release_head(typename Layout::Slot& slot) noexcept {
+        slot.state.store(Layout::make(mHead + CAPACITY, Layout::FREE, 0), std::memory_order_release);
+        ++mHead;
+        mStallSince = 0;
+    }
+
+    /**
+     * @brief Skip a CLAIMED head slot whose owner process no longer exists.
+     *
+     * Liveness is only checked after the slot blocked the head for the stall
+     * timeout, so a healthy producer never pays for a kill(pid, 0) or a
+     * /proc read.
+     */
+    bool reclaim_if_abandoned(typename Layout::Slot& slot, uint64_t state) noexcept {
+        uint64_t now = Tsc::now();
+        if (mStallSince == 0) {
+            mStallSince = now;
+            return false;
+        }
+        if (now - mStallSince < mStallTicks) {
+            return false;
+        }
+
+        // The claimer is gone if its entry was released or re-taken, or its process exited
+        const auto& producer = mLayout->producers[Layout::owner(state)];
+        uint64_t entry = producer.entry.load(std::memory_order_acquire);
+        bool dead = (Layout::count(entry) & 0xFF) != Layout::epoch(state) || !Layout::alive(producer, entry);
+        if (!dead) {
+            mStallSince = now;  // owner alive but slow: wait another timeout
+            return false;
+        }
+
+        ++mAbandoned;
+        release_head(slot);
+        return true;
+    }
+
+    Layout* mLayout = nullptr;
+    uint64_t mHead = 0;          ///< Consumer position, process-local
+    uint64_t mStallTicks;        ///< Stall timeout in TSC ticks
+    uint64_t mStallSince = 0;    ///< When the head slot was first seen CLAIMED
+    uint64_t mAbandoned = 0;
+};
@@ -0,0 +1,412 @@
+#pragma once
+
+#include "Qsbr.h"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Ordered map with one writer and lock-free readers, as a skiplist.
+ *
+ * Meant for sparse price ladders: keys are prices ordered best-first by
+ * Compare (std::greater for bids, std::less for asks), values are level
+ * aggregates small enough for a lock-free std::atomic (a Quantity, or a
+ * packed quantity/count word).
+ *
+ * The writer links a new node bottom-up with release stores, so a reader
+ * sees it at level 0 before it appears in the express lanes; it unlinks
+ * top-down and never changes an unlinked node's own next pointers, so a
+ * reader standing on it still walks forward correctly. Unlinked nodes go
+ * back to the pool only after a QSBR grace period (see Qsbr.h), instead of
+ * being deleted while a reader may still hold them.
+ *
+ * Nodes come from a bump-allocated pool with one free list per height,
+ * and each node's tower of next pointers follows its key and value in the
+ * same allocation: a search reads the key and the pointer it follows from
+ * one cache line, and three quarters of all nodes (height 1) are 32 bytes
+ * for 8-byte keys and values.
+ *
+ * @tparam K Key type (trivially copyable, e.g. Price).
+ * @tparam V Value type (trivially copyable and lock-free atomic).
+ * @tparam Compare Strict weak order; the first key is the "best".
+ * @tparam MAX_LEVEL Maximum tower height (p = 1/4 per level).
+ *
+ * Features:
+ * - find()/for_each()/for_each_from() are lock-free and never write shared
+ *   memory
+ * - insert_or_assign() of an existing key is a single atomic store
+ * - Retired nodes are handed to the domain in batches, so the domain's
+ *   mutex is taken once per RETIRE_BATCH erases
+ *
+ * Usage Constraints:
+ * - One writer thread calls insert_or_assign()/erase()/flush_retired()
+ * - Reader threads hold an online QsbrDomain::Reader for the domain and
+ *   must not keep node references across quiescent()
+ * - Destroy before the domain, from a thread that is not an online
+ *   reader, after other threads have stopped using the map (the destructor
+ *   waits for a grace period if erased nodes are still pending)
+ */
+template<typename K, typename V, typename Compare = std::less<K>, int MAX_LEVEL = 16>
+class SkipListMap {
+    static_assert(std::is_trivially_copyable_v<K> && std::is_trivially_destructible_v<K>,
+                  "SkipListMap keys must be trivially copyable");
+    static_assert(std::atomic<V>::is_always_lock_free, "SkipListMap values must be lock-free atomics");
+    static_assert(MAX_LEVEL >= 1 && MAX_LEVEL <= 32, "MAX_LEVEL must be in [1, 32]");
+
+public:
+    static constexpr size_t RETIRE_BATCH = 64;
+
+    /**
+     * @brief Construct an empty map whose nodes are reclaimed through domain.
+     */
+    explicit SkipListMap(QsbrDomain& domain, Compare compare = Compare())
+        : mDomain(domain), mCompare(compare) {
+        mHead = allocate_node(MAX_LEVEL);
+    }
+
+    ~SkipListMap() {
+        flush_retired();
+        if (mOutstanding > 0) {
+            mDomain.synchronize();   // every batch we retired is now back in mReturned
+            drain_returned();
+        }
+    }
+
+    SkipListMap(const SkipListMap&) = delete;
+    SkipListMap& operator=(const SkipListMap&) = delete;
+
+    /**
+     * @brief Insert a key or update its value.
+     *
+     * @return true if the key was inserted, false if it was updated.
+     *
+     * Thread Safety: Writer thread only.
+     *
+     * Time Complexity: O(log n) expected
+     */
+    bool insert_or_assign(const K& key, V value) {
+        std::array<Node*, MAX_LEVEL> preds;
+        Node* found = find_preds(key, preds);
+        if (found) {
+            found->value.store(value, std::memory_order_release);
+            return false;
+        }
+
+        int height = random_height();
+        Node* node = allocate_node(height);
+        node->key = key;
+        node->value.store(value, std::memory_order_relaxed);
+        for (int level = 0; level < height; ++level) {
+            node->next(level).store(preds[size_t(level)]->next(level).load(std::memory_order_relaxed),
+                                    std::memory_order_relaxed);
+        }
+        // Bottom-up: once visible at level 0 the node is in the map
+        for (int level = 0; level < height; ++level) {
+            preds[size_t(level)]->next(level).store(node, std::memory_order_release);
+        }
+        mSize.store(mSize.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Remove a key.
+     *
+     * @return true if the key was present.
+     *
+     * Thread Safety: Writer thread only.
+     *
+     * Time Complexity: O(log n) expected
+     */
+    bool erase(const K& key) {
+        std::array<Node*, MAX_LEVEL> preds;
+        Node* node = find_preds(key, preds);
+        if (!node) {
+            return false;
+        }
+        // Top-down, leaving the node's own pointers intact for readers on it
+        for (int level = node->height - 1; level >= 0; --level) {
+            preds[size_t(level)]->next(level).store(node->next(level).load(std::memory_order_relaxed),
+                                                    std::memory_order_release);
+        }
+        mSize.store(mSize.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+
+        mPending.push_back(node);
+        if (mPending.size() >= RETIRE_BATCH) {
+            flush_retired();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Hand erased nodes still held by the writer to the QSBR domain.
+     *
+     * Thread Safety: Writer thread only.
+     */
+    void flush_retired() {
+        if (mPending.empty()) {
+            return;
+        }
+        auto* batch = new RetiredBatch{this, nullptr, std::move(mPending)};
+        mPending.clear();
+        ++mOutstanding;
+        mDomain.retire(batch, &SkipListMap::on_grace_period);
+    }
+
+    /**
+     * @brief Look up a key.
+     *
+     * @param value Receives the value if found.
+     * @return true if the key is present.
+     *
+     * Thread Safety: Writer or online reader threads.
+     *
+     * Time Complexity: O(log n) expected
+     */
+    bool find(const K& key, V& value) const noexcept {
+        const Node* node = mHead;
+        for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+            const Node* next = node->next(level).load(std::memory_order_acquire);
+            while (next && mCompare(next->key, key)) {
+                node = next;
+                next = node->next(level).load(std::memory_order_acquire);
+            }
+            if (next && !mCompare(key, next->key)) {
+                value = next->value.load(std::memory_order_acquire);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Visit entries from the best key, in order, while fn returns true.
+     *
+     * @param fn Callable as bool fn(const K& key, V value).
+     * @return size_t Number of entries visited.
+     *
+     * Thread Safety: Writer or online reader threads. Entries inserted or
+     * erased during the walk may or may not be seen; order is always kept.
+     *
+     * Time Complexity: O(visited)
+     */
+    template<typename F>
+    size_t for_each(F&& fn) const {
+        return walk(mHead->next(0).load(std::memory_order_acquire), fn);
+    }
+
+    /**
+     * @brief Visit entries starting at the first key not ordered before key.
+     *
+     * Time Complexity: O(log n + visited) expected
+     */
+    template<typename F>
+    size_t for_each_from(const K& key, F&& fn) const {
+        const Node* node = mHead;
+        for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+            const Node* next = node->next(level).load(std::memory_order_acquire);
+            while (next && mCompare(next->key, key)) {
+                node = next;
+                next = node->next(level).load(std::memory_order_acquire);
+            }
+        }
+        return walk(node->next(0).load(std::memory_order_acquire), fn);
+    }
+
+    /**
+     * @brief Get the best entry.
+     *
+     * @return false if the map is empty.
+     */
+    bool front(K& key, V& value) const noexcept {
+        const Node* first = mHead->next(0).load(std::memory_order_acquire);
+        if (!first) {
+            return false;
+        }
+        key = first->key;
+        value = first->value.load(std::memory_order_acquire);
+        return true;
+    }
+
+    size_t size() const noexcept {
+        return mSize.load(std::memory_order_relaxed);
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Get the bytes reserved by the node pool.
+     */
+    size_t memory_usage() const noexcept {
+        return mChunks.size() * CHUNK_SIZE;
+    }
+
+private:
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    /**
+     * @brief Key, value and height, followed in memory by height next pointers.
+     */
+    struct alignas(alignof(std::atomic<void*>)) Node {
+        K key;
+        std::atomic<V> value;
+        uint8_t height;
+
+        std::atomic<Node*>& next(int level) noexcept {
+            return reinterpret_cast<std::atomic<Node*>*>(reinterpret_cast<char*>(this) + sizeof(Node))[level];
+        }
+
+        const std::atomic<Node*>& next(int level) const noexcept {
+            return reinterpret_cast<const std::atomic<Node*>*>(reinterpret_cast<const char*>(this) +
+                                                               sizeof(Node))[level];
+        }
+    };
+
+    /**
+     * @brief Erased nodes waiting for one grace period, then queued for reuse.
+     */
+    struct RetiredBatch {
+        SkipListMap* owner;
+        RetiredBatch* next;
+        std::vector<Node*> nodes;
+    };
+
+    // Chunks come from plain new[], so nodes can be no more aligned than that
+    static_assert(alignof(Node) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "key or value alignment too large for the node pool");
+
+    /**
+     * @brief Bytes a node of this height takes in a chunk, rounded up so the
+     *        next node bumped after it is aligned for an over-aligned key.
+     */
+    static constexpr size_t node_bytes(int height) noexcept {
+        size_t bytes = sizeof(Node) + size_t(height) * sizeof(std::atomic<Node*>);
+        return (bytes + alignof(Node) - 1) & ~(alignof(Node) - 1);
+    }
+
+    /**
+     * @brief Domain deleter: may run on any thread that triggers
+     *        reclamation, so it only pushes the batch onto a lock-free list.
+     */
+    static void on_grace_period(void* ptr) {
+        auto* batch = static_cast<RetiredBatch*>(ptr);
+        SkipListMap* owner = batch->owner;
+        batch->next = owner->mReturned.load(std::memory_order_relaxed);
+        while (!owner->mReturned.compare_exchange_weak(batch->next, batch, std::memory_order_release,
+                                                       std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Move every returned batch's nodes onto the per-height free lists.
+     */
+    void drain_returned() {
+        RetiredBatch* batch = mReturned.exchange(nullptr, std::memory_order_acquire);
+        while (batch) {
+            for (Node* node : batch->nodes) {
+                node->next(0).store(mFree[node->height - 1], std::memory_order_relaxed);
+                mFree[node->height - 1] = node;
+            }
+            RetiredBatch* next = batch->next;
+            delete batch;
+            --mOutstanding;
+            batch = next;
+        }
+    }
+
+    Node* allocate_node(int height) {
+        Node*& free = mFree[size_t(height - 1)];
+        if (!free && mReturned.load(std::memory_order_relaxed)) {
+            drain_returned();
+        }
+        Node* node;
+        if (free) {
+            node = free;
+            free = node->next(0).load(std::memory_order_relaxed);
+        } else {
+            size_t bytes = node_bytes(height);
+            if (mChunks.empty() || mChunkUsed + bytes > CHUNK_SIZE) {
+                mChunks.push_back(std::make_unique<std::byte[]>(CHUNK_SIZE));
+                mChunkUsed = 0;
+            }
+            node = reinterpret_cast<Node*>(mChunks.back().get() + mChunkUsed);
+            mChunkUsed += bytes;
+            ::new (node) Node{};
+            for (int level = 0; level < height; ++level) {
+                ::new (&node->next(level)) std::atomic<Node*>(nullptr);
+            }
+        }
+        node->height = uint8_t(height);
+        for (int level = 0; level < height; ++level) {
+            node->next(level).store(nullptr, std::memory_order_relaxed);
+        }
+        return node;
+    }
+
+    /**
+     * @brief Find the last node before key on every level.
+     *
+     * @return Node* The node holding key, or nullptr.
+     */
+    Node* find_preds(const K& key, std::array<Node*, MAX_LEVEL>& preds) noexcept {
+        Node* node = mHead;
+        for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+            Node* next = node->next(level).load(std::memory_order_relaxed);
+            while (next && mCompare(next->key, key)) {
+                node = next;
+                next = node->next(level).load(std::memory_order_relaxed);
+            }
+            preds[size_t(level)] = node;
+        }
+        Node* candidate = node->next(0).load(std::memory_order_relaxed);
+        return candidate && !mCompare(key, candidate->key) ? candidate : nullptr;
+    }
+
+    template<typename F>
+    size_t walk(const Node* node, F& fn) const {
+        size_t visited = 0;
+        while (node) {
+            ++visited;
+            if (!fn(static_cast<const K&>(node->key), node->value.load(std::memory_order_acquire))) {
+                break;
+            }
+            node = node->next(0).load(std::memory_order_acquire);
+        }
+        return visited;
+    }
+
+    /**
+     * @brief Geometric height with p = 1/4 from a xorshift generator.
+     */
+    int random_height() noexcept {
+        mRandom ^= mRandom << 13;
+        mRandom ^= mRandom >> 7;
+        mRandom ^= mRandom << 17;
+        int height = 1 + std::countr_zero(mRandom | (uint64_t{1} << 62)) / 2;
+        return height < MAX_LEVEL ? height : MAX_LEVEL;
+    }
+
+    QsbrDomain& mDomain;
+    Compare mCompare;
+    Node* mHead = nullptr;
+    std::atomic<size_t> mSize{0};
+
+    // Writer-only pool state
+    std::vector<std::unique_ptr<std::byte[]>> mChunks;
+    size_t mChunkUsed = 0;
+    std::array<Node*, MAX_LEVEL> mFree{};
+    std::vector<Node*> mPending;
+    size_t mOutstanding = 0;   ///< Batches retired and not yet returned
+    uint64_t mRandom = 0x9E3779B97F4A7C15ull;
+
+    // Batches past their grace period, pushed by whichever thread reclaimed them
+    std::atomic<RetiredBatch*> mReturned{nullptr};
+};
@@ -0,0 +1,318 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief A fixed-width, zero-padded symbol.
+ *
+ * Replaces std::string for tickers in messages: the bytes live inline, so a
+ * message holding a symbol is trivially copyable and moves through
+ * SPSCRingBuffer/MPSCQueue as a plain memcpy with no allocation.
+ *
+ * @tparam N Width in bytes: 8 (equities, futures) or 16 (options, OSI roots).
+ *
+ * Features:
+ * - Equality is one 64-bit compare (N = 8) or one SSE2 byte compare (N = 16)
+ * - Ordering matches std::string_view ordering of the unpadded text
+ * - constexpr construction from string literals
+ *
+ * Usage Constraints:
+ * - Text longer than N bytes is truncated; check fits() at the boundary
+ * - Text must not contain NUL bytes (NUL is the padding)
+ */
+template<size_t N>
+class alignas(N) FixedSymbol {
+    static_assert(N == 8 || N == 16, "FixedSymbol supports 8- and 16-byte widths");
+    static_assert(std::endian::native == std::endian::little,
+                  "FixedSymbol packs bytes little-endian into its words");
+
+public:
+    static constexpr size_t WIDTH = N;
+
+    constexpr FixedSymbol() noexcept = default;
+
+    /**
+     * @brief Construct from text, zero-padding (or truncating) to N bytes.
+     */
+    constexpr explicit FixedSymbol(std::string_view text) noexcept {
+        size_t length = text.size() < N ? text.size() : N;
+        for (size_t i = 0; i < length; ++i) {
+            mWords[i / 8] |= uint64_t(uint8_t(text[i])) << (8 * (i % 8));
+        }
+    }
+
+    /**
+     * @brief Check whether text can be stored without truncation.
+     */
+    static constexpr bool fits(std::string_view text) noexcept {
+        return text.size() <= N && text.find('\0') == std::string_view::npos;
+    }
+
+    /**
+     * @brief Get the text without padding.
+     */
+    std::string_view view() const noexcept {
+        return std::string_view(data(), size());
+    }
+
+    const char* data() const noexcept {
+        return reinterpret_cast<const char*>(mWords.data());
+    }
+
+    /**
+     * @brief Get the text length (position of the first padding byte).
+     */
+    constexpr size_t size() const noexcept {
+        for (size_t w = 0; w < WORDS; ++w) {
+            if (mWords[w] >> 56 == 0) {   // padding starts in this word
+                return 8 * w + (mWords[w] ? (64 - std::countl_zero(mWords[w]) + 7) / 8 : 0);
+            }
+        }
+        return N;
+    }
+
+    constexpr bool empty() const noexcept {
+        return mWords[0] == 0;
+    }
+
+    /**
+     * @brief Raw 64-bit word w of the padded text (for hashing and packing).
+     */
+    constexpr uint64_t word(size_t w) const noexcept {
+        return mWords[w];
+    }
+
+    /**
+     * @brief Hash suitable for FlatHashMap and friends.
+     */
+    constexpr uint64_t hash() const noexcept {
+        uint64_t h = mWords[0];
+        if constexpr (WORDS == 2) {
+            h ^= std::rotl(mWords[1], 29) * 0x9e3779b97f4a7c15ull;
+        }
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    friend constexpr bool operator==(const FixedSymbol& a, const FixedSymbol& b) noexcept {
+        if constexpr (WORDS == 1) {
+            return a.mWords[0] == b.mWords[0];
+        } else {
+#if defined(__SSE2__)
+            if (!std::is_constant_evaluated()) {
+                __m128i x = _mm_load_si128(reinterpret_cast<const __m128i*>(a.mWords.data()));
+                __m128i y = _mm_load_si128(reinterpret_cast<const __m128i*>(b.mWords.data()));
+                return _mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) == 0xFFFF;
+            }
+#endif
+            return ((a.mWords[0] ^ b.mWords[0]) | (a.mWords[1] ^ b.mWords[1])) == 0;
+        }
+    }
+
+    /**
+     * @brief Lexicographic order: byte-swapped words compare like the text.
+     */
+    friend constexpr std::strong_ordering operator<=>(const FixedSymbol& a, const FixedSymbol& b) noexcept {
+        for (size_t w = 0; w < WORDS; ++w) {
+            if (a.mWords[w] != b.mWords[w]) {
+                return __builtin_bswap64(a.mWords[w]) <=> __builtin_bswap64(b.mWords[w]);
+            }
+        }
+        return std::strong_ordering::equal;
+    }
+
+private:
+    static constexpr size_t WORDS = N / 8;
+
+    std::array<uint64_t, WORDS> mWords{};
+};
+
+using Symbol8 = FixedSymbol<8>;
+using Symbol16 = FixedSymbol<16>;
+
+static_assert(std::is_trivially_copyable_v<Symbol8> && sizeof(Symbol8) == 8);
+static_assert(std::is_trivially_copyable_v<Symbol16> && sizeof(Symbol16) == 16);
+
+/**
+ * @brief Lock-free intern table mapping fixed-width symbols to dense 32-bit ids.
+ *
+ * Ids are handed out in order of first intern (0, 1, 2, ...) so they can
+ * index per-instrument arrays directly. Interning is meant for the ingress
+ * edge (gateway, feed handler); the hot path then carries the id or the
+ * FixedSymbol itself.
+ *
+ * @tparam N Symbol width (8 or 16).
+ * @tparam CAPACITY Maximum number of distinct symbols.
+ *
+ * Features:
+ * - Lock-free lookups; interning claims a slot with one CAS
+ * - Open addressing over 2 * CAPACITY slots (load factor <= 0.5)
+ * - Reverse lookup id -> symbol in O(1)
+ *
+ * Slot State:
+ * - EMPTY: never used
+ * - BUSY: claimed, symbol being written (others wait for this short window)
+ * - READY: symbol and id are published
+ *
+ * Usage Constraints:
+ * - Any number of threads may call intern()/find()/symbol() concurrently
+ * - Symbols are never removed; size the table for the whole session
+ * - Once CAPACITY ids are used, new symbols get INVALID_ID and take no slot
+ * - The object is large for big universes; allocate it on the heap
+ */
+template<size_t N, size_t CAPACITY>
+class SymbolTable {
+    static_assert(CAPACITY >= 1 && CAPACITY < (size_t{1} << 31),
+                  "CAPACITY must fit in a 31-bit id");
+
+public:
+    using Symbol = FixedSymbol<N>;
+
+    static constexpr uint32_t INVALID_ID = ~uint32_t{0};
+
+    /**
+     * @brief Get the id of a symbol, assigning the next id on first sight.
+     *
+     * @return uint32_t The id, or INVALID_ID if the table is full.
+     *
+     * Thread Safety: Safe to call from multiple threads concurrently. Two
+     * threads interning the same new symbol get the same id.
+     */
+    uint32_t intern(const Symbol& symbol) noexcept {
+        size_t index = symbol.hash() & (SLOTS - 1);
+        for (size_t probe = 0; probe < SLOTS;) {
+            Slot& slot = mSlots[index];
+            uint32_t state = slot.state.load(std::memory_order_acquire);
+
+            if (state == EMPTY) {
+                // Not in the table: once every id is used, fail without taking a slot
+                if (mNextId.load(std::memory_order_relaxed) >= CAPACITY) {
+                    return INVALID_ID;
+                }
+                if (!slot.state.compare_exchange_strong(state, BUSY, std::memory_order_acquire,
+                                                        std::memory_order_acquire)) {
+                    continue;   // lost the race, re-examine this slot
+                }
+                uint32_t id = mNextId.fetch_add(1, std::memory_order_relaxed);
+                if (id >= CAPACITY) {
+                    // Raced past the check above: at most one slot per racing thread
+                    id = INVALID_ID;
+                } else {
+                    mSymbols[id] = symbol;
+                }
+                slot.symbol = symbol;
+                slot.id = id;
+                slot.state.store(READY, std::memory_order_release);
+                return id;
+            }
+
+            while (state == BUSY) {
+                cpu_relax();
+                state = slot.state.load(std::memory_order_acquire);
+            }
+            if (slot.symbol == symbol) {
+                return slot.id;
+            }
+            index = (index + 1) & (SLOTS - 1);
+            ++probe;
+        }
+        return INVALID_ID;
+    }
+
+    /**
+     * @brief Get the id of a symbol without interning it.
+     *
+     * @return uint32_t The id, or INVALID_ID if the symbol is unknown.
+     *
+     * Thread Safety: Safe to call from multiple threads concurrently.
+     */
+    uint32_t find(const Symbol& symbol) const noexcept {
+        size_t index = symbol.hash() & (SLOTS - 1);
+        for (size_t probe = 0; probe < SLOTS; ++probe) {
+            const Slot& slot = mSlots[index];
+            uint32_t state = slot.state.load(std::memory_order_acquire);
+            if (state == EMPTY) {
+                return INVALID_ID;
+            }
+            while (state == BUSY) {
+                cpu_relax();
+                state = slot.state.load(std::memory_order_acquire);
+            }
+            if (slot.symbol == symbol) {
+                return slot.id;
+            }
+            index = (index + 1) & (SLOTS - 1);
+        }
+        return INVALID_ID;
+    }
+
+    /**
+     * @brief Get the symbol of an id returned by intern().
+     */
+    const Symbol& symbol(uint32_t id) const noexcept {
+        return mSymbols[id];
+    }
+
+    /**
+     * @brief Get the number of distinct symbols interned.
+     */
+    size_t size() const noexcept {
+        size_t next = mNextId.load(std::memory_order_relaxed);
+        return next < CAPACITY ? next : CAPACITY;
+    }
+
+    static constexpr size_t capacity() noexcept {
+        return CAPACITY;
+    }
+
+private:
+    // Cache line size to keep the id counter away from the slots
+    static constexpr size_t CACHE_LINE = std::hardware_destructive_interference_size;
+
+    static constexpr uint32_t EMPTY = 0;
+    static constexpr uint32_t BUSY = 1;
+    static constexpr uint32_t READY = 2;
+
+    /**
+     * @brief Slot count: next power of two >= 2 * CAPACITY.
+     */
+    static constexpr size_t SLOTS = [] {
+        size_t slots = 1;
+        while (slots < 2 * CAPACITY) slots <<= 1;
+        return slots;
+    }();
+
+    struct Slot {
+        std::atomic<uint32_t> state{EMPTY};
+        uint32_t id = INVALID_ID;
+        Symbol symbol;
+    };
+
+    static void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    // Next id to hand out
+    alignas(CACHE_LINE) std::atomic<uint32_t> mNextId{0};
+
+    alignas(CACHE_LINE) std::array<Slot, SLOTS> mSlots{};
+
+    // Reverse map, written once per id before the slot is published
+    std::array<Symbol, CAPACITY> mSymbols{};
+};
@@ -0,0 +1,350 @@
+#pragma once
+
+#include "MPSCQueue.h"
+#include "Tsc.h"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief Intrusive hook for timers managed by a TimerWheel.
+ *
+ * Embed by inheritance in the object that owns the timeout (an order, a
+ * session, a throttle window), so scheduling never allocates:
+ *
+ *     struct Order : TimerNode { uint64_t id; ... };
+ *     TimerWheel<Order> wheel(Tsc::from_ns(100'000));
+ *     wheel.schedule(order, Tsc::now() + Tsc::from_ns(5'000'000'000));
+ *
+ * Usage Constraints:
+ * - A node belongs to at most one wheel and must outlive its scheduling
+ * - Not copyable: the wheel links the node's own address
+ */
+class TimerNode {
+public:
+    TimerNode() noexcept = default;
+    TimerNode(const TimerNode&) = delete;
+    TimerNode& operator=(const TimerNode&) = delete;
+
+    /**
+     * @brief Check whether the timer is currently armed.
+     */
+    bool scheduled() const noexcept {
+        return mNext != nullptr;
+    }
+
+    /**
+     * @brief Deadline in TSC ticks of the last schedule() call.
+     */
+    uint64_t deadline() const noexcept {
+        return mDeadline;
+    }
+
+private:
+    template<typename T>
+    friend class TimerWheel;
+
+    TimerNode* mPrev = nullptr;
+    TimerNode* mNext = nullptr;   ///< nullptr when not scheduled
+    uint64_t mDeadline = 0;       ///< TSC ticks
+    uint64_t mExpiry = 0;         ///< Wheel tick at which the timer fires
+    uint16_t mList = 0;           ///< Index of the list the node is linked into
+};
+
+/**
+ * @brief Hashed hierarchical timer wheel driven by the TSC.
+ *
+ * Six levels of 64 slots each; level l covers 64^(l+1) wheel ticks, so the
+ * wheel spans 2^36 ticks (timers beyond are parked at the top level and
+ * re-placed when it turns). Each level keeps a 64-bit occupancy mask, so
+ * advance() jumps straight to the next occupied slot on any level instead
+ * of stepping tick by tick.
+ *
+ * @tparam T Timer type; must derive from TimerNode.
+ *
+ * Features:
+ * - O(1) schedule, reschedule and cancel (intrusive doubly linked slots)
+ * - Batch expiry: advance() fires everything due in one pass, in tick order
+ * - Never fires early; fires at most one resolution after the deadline
+ *   (plus however late advance() is called)
+ * - Other threads arm and cancel timers through an MPSCQueue inbox that the
+ *   owning thread drains at the start of every advance()
+ *
+ * Usage Constraints:
+ * - schedule()/cancel()/advance() from the owning thread only
+ * - post_schedule()/post_cancel() from any thread; they take effect at the
+ *   next advance() and the node must stay alive until then
+ * - Callbacks may schedule or cancel any timer, including the one firing
+ */
+template<typename T>
+class TimerWheel {
+    static_assert(std::is_base_of_v<TimerNode, T>, "T must derive from TimerNode");
+
+public:
+    static constexpr unsigned LEVEL_BITS = 6;
+    static constexpr unsigned SLOTS = 1u << LEVEL_BITS;
+    static constexpr unsigned LEVELS = 6;
+
+    /**
+     * @brief Construct a wheel.
+     *
+     * @param resolutionTicks Length of one wheel tick in TSC ticks (see
+     *        Tsc::from_ns()); rounded up to a power of two.
+     * @param nowTsc Current time; the wheel starts at this tick.
+     */
+    explicit TimerWheel(uint64_t resolutionTicks, uint64_t nowTsc = Tsc::now()) noexcept
+        : mShift(unsigned(std::bit_width(resolutionTicks > 1 ? resolutionTicks - 1 : 0))),
+          mTick(nowTsc >> mShift) {
+        for (auto& list : mLists) {
+            list.mPrev = &list;
+            list.mNext = &list;
+        }
+    }
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * @brief Arm (or re-arm) a timer.
+     *
+     * @param timer The timer; if already scheduled it is moved.
+     * @param deadlineTsc Absolute deadline in TSC ticks.
+     *
+     * Thread Safety: Owning thread only.
+     *
+     * Time Complexity: O(1)
+     */
+    void schedule(T& timer, uint64_t deadlineTsc) noexcept {
+        TimerNode& node = timer;
+        if (node.scheduled()) {
+            unlink(node);
+        } else {
+            ++mSize;
+        }
+        node.mDeadline = deadlineTsc;
+        // Round up so a timer never fires before its deadline
+        node.mExpiry = (deadlineTsc >> mShift) + ((deadlineTsc & (resolution() - 1)) != 0);
+        if (node.mExpiry <= mTick) {
+            link(node, DUE_LIST);   // already due: fires at the next advance()
+        } else {
+            place(node);
+        }
+    }
+
+    /**
+     * @brief Disarm a timer.
+     *
+     * @return true if it was scheduled.
+     *
+     * Thread Safety: Owning thread only.
+     *
+     * Time Complexity: O(1)
+     */
+    bool cancel(T& timer) noexcept {
+        TimerNode& node = timer;
+        if (!node.scheduled()) {
+            return false;
+        }
+        unlink(node);
+        --mSize;
+        return true;
+    }
+
+    /**
+     * @brief Ask the owning thread to arm a timer.
+     *
+     * Thread Safety: Safe to call from multiple threads concurrently.
+     */
+    bool post_schedule(T& timer, uint64_t deadlineTsc) noexcept {
+        return mInbox.push(Command{&timer, deadlineTsc, false});
+    }
+
+    /**
+     * @brief Ask the owning thread to disarm a timer.
+     *
+     * Thread Safety: Safe to call from multiple threads concurrently.
+     */
+    bool post_cancel(T& timer) noexcept {
+        return mInbox.push(Command{&timer, 0, true});
+    }
+
+    /**
+     * @brief Apply pending inbox commands, then fire every timer due by now.
+     *
+     * @param onExpire Callable invoked as onExpire(T&) for each expired
+     *                 timer, in expiry order. The timer is already
+     *                 disarmed and may be rescheduled from the callback.
+     * @param nowTsc Current time in TSC ticks.
+     * @return size_t Number of timers fired.
+     *
+     * Thread Safety: Owning thread only.
+     *
+     * Time Complexity: O(fired + cascaded + occupied slots passed)
+     */
+    template<typename F>
+    size_t advance(F&& onExpire, uint64_t nowTsc = Tsc::now()) noexcept {
+        drain_inbox();
+
+        size_t fired = fire(DUE_LIST, onExpire);
+        uint64_t target = nowTsc >> mShift;
+        while (mTick < target) {
+            uint64_t next = next_event(target);
+            mTick = next;
+            if ((next & (SLOTS - 1)) == 0) {
+                cascade(next);
+            }
+            fired += fire(next & (SLOTS - 1), onExpire);
+            fired += fire(DUE_LIST, onExpire);   // rescheduled at or before now by a callback
+        }
+        return fired;
+    }
+
+    /**
+     * @brief Get the number of armed timers (excluding unprocessed inbox commands).
+     */
+    size_t size() const noexcept {
+        return mSize;
+    }
+
+    bool empty() const noexcept {
+        return mSize == 0;
+    }
+
+    /**
+     * @brief Length of one wheel tick in TSC ticks.
+     */
+    uint64_t resolution() const noexcept {
+        return uint64_t{1} << mShift;
+    }
+
+private:
+    struct Command {
+        T* timer;
+        uint64_t deadline;
+        bool cancel;
+    };
+
+    static constexpr uint16_t DUE_LIST = LEVELS * SLOTS;
+    static constexpr uint64_t SPAN = uint64_t{1} << (LEVEL_BITS * LEVELS);
+
+    void link(TimerNode& node, uint16_t list) noexcept {
+        TimerNode& head = mLists[list];
+        node.mList = list;
+        node.mPrev = head.mPrev;
+        node.mNext = &head;
+        head.mPrev->mNext = &node;
+        head.mPrev = &node;
+        if (list < DUE_LIST) {
+            mOccupied[list / SLOTS] |= uint64_t{1} << (list % SLOTS);
+        }
+    }
+
+    void unlink(TimerNode& node) noexcept {
+        node.mPrev->mNext = node.mNext;
+        node.mNext->mPrev = node.mPrev;
+        uint16_t list = node.mList;
+        if (list < DUE_LIST && mLists[list].mNext == &mLists[list]) {
+            mOccupied[list / SLOTS] &= ~(uint64_t{1} << (list % SLOTS));
+        }
+        node.mPrev = nullptr;
+        node.mNext = nullptr;
+    }
+
+    /**
+     * @brief Link a node into the level that covers its distance from now.
+     */
+    void place(TimerNode& node) noexcept {
+        uint64_t expiry = node.mExpiry;
+        uint64_t delta = expiry - mTick;
+        if (delta >= SPAN) {
+            expiry = mTick + SPAN - 1;   // park at the top level, re-placed on cascade
+            delta = SPAN - 1;
+        }
+        unsigned level = delta < SLOTS ? 0 : (unsigned(std::bit_width(delta)) - 1) / LEVEL_BITS;
+        unsigned slot = unsigned(expiry >> (LEVEL_BITS * level)) & (SLOTS - 1);
+        link(node, uint16_t(level * SLOTS + slot));
+    }
+
+    /**
+     * @brief Next tick at which something can happen, capped at target:
+     *        the start of the nearest occupied slot on any level (a level-0
+     *        slot fires there, a higher slot cascades there).
+     */
+    uint64_t next_event(uint64_t target) const noexcept {
+        uint64_t next = target;
+        for (unsigned level = 0; level < LEVELS; ++level) {
+            uint64_t mask = mOccupied[level];
+            if (!mask) {
+                continue;
+            }
+            uint64_t position = mTick >> (LEVEL_BITS * level);
+            unsigned from = unsigned(position + 1) & (SLOTS - 1);
+            uint64_t distance = unsigned(std::countr_zero(std::rotr(mask, int(from))));
+            uint64_t tick = (position + 1 + distance) << (LEVEL_BITS * level);
+            if (tick < next) {
+                next = tick;
+            }
+        }
+        return next;
+    }
+
+    /**
+     * @brief Re-place the slots of higher levels whose span starts at tick,
+     *        top level first so entries can trickle all the way down.
+     */
+    void cascade(uint64_t tick) noexcept {
+        unsigned top = 1;
+        while (top + 1 < LEVELS && (tick & ((uint64_t{1} << (LEVEL_BITS * (top + 1))) - 1)) == 0) {
+            ++top;
+        }
+        for (unsigned level = top; level >= 1; --level) {
+            unsigned slot = unsigned(tick >> (LEVEL_BITS * level)) & (SLOTS - 1);
+            uint16_t list = uint16_t(level * SLOTS + slot);
+            TimerNode& head = mLists[list];
+            while (head.mNext != &head) {
+                TimerNode& node = *head.mNext;
+                unlink(node);
+                place(node);
+            }
+        }
+    }
+
+    /**
+     * @brief Fire every node of a list. The list is re-read after each
+     *        callback, so callbacks may cancel or schedule freely.
+     */
+    template<typename F>
+    size_t fire(uint16_t list, F& onExpire) noexcept {
+        TimerNode& head = mLists[list];
+        size_t fired = 0;
+        while (head.mNext != &head) {
+            TimerNode& node = *head.mNext;
+            unlink(node);
+            --mSize;
+            ++fired;
+            onExpire(static_cast<T&>(node));
+        }
+        return fired;
+    }
+
+    void drain_inbox() noexcept {
+        mInbox.pop_batch([this](Command&& command) {
+            if (command.cancel) {
+                cancel(*command.timer);
+            } else {
+                schedule(*command.timer, command.deadline);
+            }
+        }, ~size_t{0});
+    }
+
+    unsigned mShift;
+    uint64_t mTick;   ///< Last processed wheel tick
+    size_t mSize = 0;
+    std::array<uint64_t, LEVELS> mOccupied{};
+    // One sentinel per slot plus the due list
+    std::array<TimerNode, LEVELS * SLOTS + 1> mLists;
+    MPSCQueue<Command> mInbox;
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "Tsc.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <new>
+
+/**
+ * @brief Lock-free token-bucket rate limiter in a single atomic word.
+ *
+ * Keeps the bucket as a "theoretical arrival time" (GCRA form): the TSC at
+ * which the bucket would be full again. Tokens are never stored or topped
+ * up by a timer; try_acquire() derives the current level from the TSC, so
+ * refill is lazy and exact. The whole state is one 64-bit word updated with
+ * one CAS, which makes the limiter safe for any number of strategy threads
+ * sharing a session without a mutex.
+ *
+ * Refill rate is 1 token per `ticksPerToken` TSC ticks, capacity is
+ * `burst` tokens, and a new bucket starts full.
+ *
+ * Features:
+ * - Non-blocking: try_acquire(n) either takes n tokens or takes nothing
+ * - Rejections are read-only, so a throttled session adds no cache-line
+ *   traffic beyond the load
+ * - Never over-grants under contention: every grant is a successful CAS
+ *   that accounts for all earlier grants
+ * - wait_ticks(n) tells a caller how long until n tokens are available
+ *
+ * Usage Constraints:
+ * - Assumes the invariant TSC of Tsc.h; pass nowTsc explicitly for replay
+ *   or tests
+ * - n must not exceed burst (such requests are always rejected)
+ */
+class TokenBucket {
+public:
+    /**
+     * @brief Construct a full bucket.
+     *
+     * @param ticksPerToken Refill interval in TSC ticks (see Tsc::from_ns()).
+     * @param burst Capacity in tokens (the exchange's window allowance).
+     * @param nowTsc Current time.
+     */
+    TokenBucket(uint64_t ticksPerToken, uint32_t burst, uint64_t nowTsc = Tsc::now()) noexcept
+        : mInterval(ticksPerToken ? ticksPerToken : 1),
+          mTolerance(mInterval * burst),
+          mBurst(burst),
+          mTat(nowTsc) {}
+
+    /**
+     * @brief Get the refill interval for a rate in tokens per second.
+     *
+     * Rounded up to whole ticks, so the granted rate never exceeds
+     * tokensPerSecond (e.g. 6666.7 ticks becomes 6667, not 6666).
+     */
+    static uint64_t interval_for_rate(uint64_t tokensPerSecond) noexcept {
+        double ticks = Tsc::ticks_per_ns() * 1e9 / double(tokensPerSecond ? tokensPerSecond : 1);
+        return static_cast<uint64_t>(std::ceil(ticks));
+    }
+
+    TokenBucket(const TokenBucket&) = delete;
+    TokenBucket& operator=(const TokenBucket&) = delete;
+
+    /**
+     * @brief Take n tokens if available.
+     *
+     * @param n Tokens to take (e.g. messages in a batch).
+     * @param nowTsc Current time.
+     * @return true if all n tokens were taken.
+     * @return false if fewer than n are available; nothing is taken.
+     *
+     * Thread Safety: Safe to call from multiple threads concurrently.
+     *
+     * Memory Ordering: relaxed. The word only orders itself; it does not
+     * publish other data.
+     *
+     * Time Complexity: O(1), lock-free (retries only when another thread's
+     * grant lands between the load and the CAS)
+     */
+    bool try_acquire(uint32_t n = 1, uint64_t nowTsc = Tsc::now()) noexcept {
+        uint64_t cost = mInterval * n;
+        uint64_t tat = mTat.load(std::memory_order_relaxed);
+        while (true) {
+            uint64_t start = tat > nowTsc ? tat : nowTsc;   // lazy refill: an idle bucket is full
+            uint64_t next = start + cost;
+            if (next - nowTsc > mTolerance) {
+                return false;
+            }
+            if (mTat.compare_exchange_weak(tat, next, std::memory_order_relaxed, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    /**
+     * @brief Get the number of tokens currently available.
+     *
+     * Thread Safety: Safe to call concurrently; the value may be stale.
+     * A nowTsc older than another thread's grant reads as an empty bucket.
+     */
+    uint32_t available(uint64_t nowTsc = Tsc::now()) const noexcept {
+        uint64_t tat = mTat.load(std::memory_order_relaxed);
+        uint64_t debt = tat > nowTsc ? tat - nowTsc : 0;
+        if (debt > mTolerance) {
+            debt = mTolerance;
+        }
+        return uint32_t((mTolerance - debt) / mInterval);
+    }
+
+    /**
+     * @brief Get the TSC ticks until n tokens will be available (0 if now).
+     *
+     * Only meaningful for n <= burst; other threads may take the tokens first.
+     */
+    uint64_t wait_ticks(uint32_t n, uint64_t nowTsc = Tsc::now()) const noexcept {
+        uint64_t tat = mTat.load(std::memory_order_relaxed);
+        uint64_t start = tat > nowTsc ? tat : nowTsc;
+        uint64_t next = start + mInterval * n;
+        return next - nowTsc > mTolerance ? next - nowTsc - mTolerance : 0;
+    }
+
+    uint32_t burst() const noexcept {
+        return mBurst;
+    }
+
+    uint64_t ticks_per_token() const noexcept {
+        return mInterval;
+    }
+
+private:
+    // Cache line size to keep the hot word away from neighbouring data
+    static constexpr size_t CACHE_LINE = std::hardware_destructive_interference_size;
+
+    const uint64_t mInterval;    ///< TSC ticks per token
+    const uint64_t mTolerance;   ///< burst * interval
+    const uint32_t mBurst;
+
+    // Theoretical arrival time: TSC at which the bucket is full again
+    alignas(CACHE_LINE) std::atomic<uint64_t> mTat;
+};
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+/**
+ * @brief A wait-free triple buffer for handing large state from one writer to one reader.
+ *
+ * The writer owns a back buffer it can fill at leisure, the reader owns a
+ * front buffer it can read at leisure, and a third "middle" buffer holds the
+ * latest published snapshot. Publishing swaps back and middle, reading swaps
+ * middle and front; both are a single atomic exchange on one index word, so
+ * neither side ever copies, blocks or retries.
+ *
+ * Suited to snapshots too large for a seqlock retry (e.g. a 50 KB position
+ * table): the reader always sees the latest complete version and
+ * intermediate versions it did not ask for are simply overwritten.
+ *
+ * @tparam T The snapshot type. Must be default constructible.
+ *
+ * Features:
+ * - Wait-free: publish() and read() are one atomic exchange each
+ * - Zero copy: the reader works directly on the published buffer
+ * - Always consistent: the reader never sees a partially written snapshot
+ * - Cache-friendly: every buffer starts on its own cache line
+ *
+ * Middle Word:
+ * - bits 0-1: index of the middle buffer
+ * - bit 2: fresh (set by publish(), cleared when the reader takes it)
+ *
+ * Usage Constraints:
+ * - Exactly ONE thread may call back()/publish()
+ * - Exactly ONE thread may call read()/front()/has_update()
+ * - After publish() the back buffer holds an older snapshot, not the one just
+ *   published; a writer that updates its state incrementally should keep its
+ *   working copy elsewhere and use publish(const T&)
+ */
+template<typename T>
+class TripleBuffer {
+    static_assert(std::is_default_constructible_v<T>,
+                  "TripleBuffer buffers must be default constructible");
+
+public:
+    TripleBuffer() = default;
+
+    /**
+     * @brief Construct with every buffer initialised to the same value.
+     */
+    explicit TripleBuffer(const T& initial) {
+        for (auto& buffer : mBuffers) {
+            buffer.value = initial;
+        }
+    }
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * @brief Get the writer's back buffer.
+     *
+     * Thread Safety: May ONLY be called by the writer thread.
+     */
+    T& back() noexcept {
+        return mBuffers[mBack].value;
+    }
+
+    /**
+     * @brief Publish the back buffer as the latest snapshot.
+     *
+     * The previous middle buffer becomes the new back buffer. If the reader
+     * has not taken the previous snapshot yet, it is dropped.
+     *
+     * @return T& The new back buffer.
+     *
+     * Thread Safety: May ONLY be called by the writer thread.
+     *
+     * Time Complexity: O(1), wait-free
+     */
+    T& publish() noexcept {
+        // release: the snapshot is visible before its index
+        // acquire: the reader is done with the buffer we get back
+        uint8_t previous = mMiddle.exchange(mBack | FRESH, std::memory_order_acq_rel);
+        mBack = previous & INDEX_MASK;
+        return mBuffers[mBack].value;
+    }
+
+    /**
+     * @brief Copy a snapshot into the back buffer and publish it.
+     *
+     * Thread Safety: May ONLY be called by the writer thread.
+     */
+    void publish(const T& value) {
+        mBuffers[mBack].value = value;
+        publish();
+    }
+
+    /**
+     * @brief Check whether a snapshot newer than front() has been published.
+     *
+     * Thread Safety: May ONLY be called by the reader thread.
+     */
+    bool has_update() const noexcept {
+        return (mMiddle.load(std::memory_order_relaxed) & FRESH) != 0;
+    }
+
+    /**
+     * @brief Take the latest published snapshot.
+     *
+     * @return const T& The latest snapshot; stays valid and unchanged until
+     *         the next read() call.
+     *
+     * If nothing was published since the last call, the current front buffer
+     * is returned again without touching the shared word.
+     *
+     * Thread Safety: May ONLY be called by the reader thread.
+     *
+     * Time Complexity: O(1), wait-free
+     */
+    const T& read() noexcept {
+        if (has_update()) {
+            uint8_t previous = mMiddle.exchange(mFront, std::memory_order_acq_rel);
+            mFront = previous & INDEX_MASK;
+        }
+        return mBuffers[mFront].value;
+    }
+
+    /**
+     * @brief Get the snapshot returned by the last read() without checking for updates.
+     *
+     * Thread Safety: May ONLY be called by the reader thread.
+     */
+    const T& front() const noexcept {
+        return mBuffers[mFront].value;
+    }
+
+private:
+    // Cache line size to prevent false sharing between buffers and indices
+    static constexpr size_t CACHE_LINE = std::hardware_destructive_interference_size;
+
+    static constexpr uint8_t INDEX_MASK = 3;  ///< Middle word: buffer index
+    static constexpr uint8_t FRESH = 4;       ///< Middle word: unread snapshot
+
+    /**
+     * @brief One snapshot buffer.
+     */
+    struct alignas(CACHE_LINE) Buffer {
+        T value{};
+    };
+
+    std::array<Buffer, 3> mBuffers{};
+
+    // mBack is only accessed by the writer
+    alignas(CACHE_LINE) uint8_t mBack{0};
+
+    // mMiddle is exchanged by both sides
+    alignas(CACHE_LINE) std::atomic<uint8_t> mMiddle{1};
+
+    // mFront is only accessed by the reader
+    alignas(CACHE_LINE) uint8_t mFront{2};
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief Time Stamp Counter helpers for cheap enqueue/expiry timestamps.
+ *
+ * Tsc::now() is a single rdtsc on x86 (a few ns, no syscall, no vDSO call).
+ * Tick rates are calibrated once against std::chrono::steady_clock so that
+ * TTLs and timeouts can be configured in nanoseconds.
+ *
+ * Assumptions:
+ * - Invariant TSC (constant_tsc + nonstop_tsc), synchronised across cores,
+ *   which holds on every server CPU of the last decade
+ * - On non-x86 targets the steady clock in nanoseconds is used instead
+ *
+ * Note: rdtsc is not serialising; timestamps may be reordered by a few
+ * instructions, which is irrelevant at TTL/timeout granularity.
+ */
+class Tsc {
+public:
+    /**
+     * @brief Read the current tick count.
+     */
+    static uint64_t now() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    /**
+     * @brief Get the number of ticks per nanosecond.
+     *
+     * Calibrated on first use (about 10 ms), then cached.
+     */
+    static double ticks_per_ns() noexcept {
+        static const double rate = calibrate();
+        return rate;
+    }
+
+    /**
+     * @brief Convert a duration in nanoseconds to ticks.
+     */
+    static uint64_t from_ns(uint64_t ns) noexcept {
+        return static_cast<uint64_t>(static_cast<double>(ns) * ticks_per_ns());
+    }
+
+    /**
+     * @brief Convert a tick count to nanoseconds.
+     */
+    static uint64_t to_ns(uint64_t ticks) noexcept {
+        return static_cast<uint64_t>(static_cast<double>(ticks) / ticks_per_ns());
+    }
+
+private:
+    static double calibrate() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        using Clock = std::chrono::steady_clock;
+        auto t0 = Clock::now();
+        uint64_t c0 = now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        auto t1 = Clock::now();
+        uint64_t c1 = now();
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+        return ns > 0 ? static_cast<double>(c1 - c0) / static_cast<double>(ns) : 1.0;
+#else
+        return 1.0;
+#endif
+    }
+};
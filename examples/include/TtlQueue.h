@@ -0,0 +1,215 @@
+#pragma once
+
+#include "MPSCQueue.h"
+#include "SPSCRingBuffer.h"
+#include "Tsc.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/**
+ * @brief A value stamped with its enqueue time in TSC ticks.
+ */
+template<typename T>
+struct Stamped {
+    uint64_t tsc;   ///< Tsc::now() at enqueue
+    T value;        ///< The payload
+};
+
+/**
+ * @brief SPSCRingBuffer with time-to-live dropping at pop time.
+ *
+ * Market data that waited too long in a queue is worse than useless. Every
+ * push records Tsc::now(); pop() first discards the expired prefix of the
+ * buffer and then hands back the oldest live item. Because the single
+ * producer stamps in order, the expired entries always form a prefix and
+ * are skipped in bulk with a binary search and one head release.
+ *
+ * @tparam T The type of elements stored in the buffer.
+ * @tparam CAPACITY Ring capacity. Must be a power of two.
+ *
+ * Features:
+ * - One rdtsc per push and per pop
+ * - A stalled consumer jumps straight to live data: O(log n) to skip n stale items
+ * - Dropped items are counted (expired())
+ * - A TTL of 0 ticks is treated as "no TTL"
+ *
+ * Usage Constraints:
+ * - Same as SPSCRingBuffer: one producer thread, one consumer thread
+ */
+template<typename T, std::size_t CAPACITY>
+class TtlRingBuffer {
+public:
+    /**
+     * @brief Construct with a TTL in TSC ticks (see Tsc::from_ns()).
+     */
+    explicit TtlRingBuffer(uint64_t ttlTicks) noexcept : mTtl(ttlTicks) {}
+
+    /**
+     * @brief Push a copy of an item, stamped with the current TSC.
+     *
+     * Thread Safety: May ONLY be called by the single producer thread.
+     */
+    bool push(const T& item) noexcept {
+        return mRing.push(Stamped<T>{Tsc::now(), item});
+    }
+
+    /**
+     * @brief Push a moved item, stamped with the current TSC.
+     */
+    bool push(T&& item) noexcept {
+        return mRing.push(Stamped<T>{Tsc::now(), std::move(item)});
+    }
+
+    /**
+     * @brief Pop the oldest item that has not expired.
+     *
+     * @param item Reference to store the popped item.
+     * @return true if a live item was popped.
+     * @return false if the buffer is empty once expired items are dropped.
+     *
+     * Thread Safety: May ONLY be called by the single consumer thread.
+     */
+    bool pop(T& item) noexcept {
+        discard_expired();
+
+        Stamped<T> stamped;
+        if (!mRing.pop(stamped)) {
+            return false;
+        }
+        item = std::move(stamped.value);
+        return true;
+    }
+
+    /**
+     * @brief Drop every expired item at the front of the buffer.
+     *
+     * @return size_t Number of items dropped by this call.
+     *
+     * Thread Safety: May ONLY be called by the single consumer thread.
+     */
+    size_t discard_expired() noexcept {
+        if (mTtl == 0) {
+            return 0;
+        }
+        uint64_t now = Tsc::now();
+        size_t dropped = mRing.discard_front([&](const Stamped<T>& stamped) {
+            return static_cast<int64_t>(now - stamped.tsc) > static_cast<int64_t>(mTtl);
+        });
+        mExpired += dropped;
+        return dropped;
+    }
+
+    /**
+     * @brief Get the total number of items dropped as expired.
+     *
+     * Note: Consumer-side counter; read it from the consumer thread.
+     */
+    uint64_t expired() const noexcept {
+        return mExpired;
+    }
+
+    /**
+     * @brief Change the TTL (consumer thread only). 0 disables dropping.
+     */
+    void set_ttl(uint64_t ttlTicks) noexcept {
+        mTtl = ttlTicks;
+    }
+
+    bool empty() const noexcept { return mRing.empty(); }
+    size_t size() const noexcept { return mRing.size(); }
+    size_t capacity() const noexcept { return mRing.capacity(); }
+
+private:
+    SPSCRingBuffer<Stamped<T>, CAPACITY> mRing;
+    uint64_t mTtl;          ///< TTL in ticks, consumer side
+    uint64_t mExpired = 0;  ///< Dropped item count, consumer side
+};
+
+/**
+ * @brief MPSCQueue with time-to-live dropping at pop time.
+ *
+ * Same contract as TtlRingBuffer for multiple producers. Stamps taken by
+ * different producers are not strictly ordered in the queue, so expired
+ * items are dropped one by one from the front; each drop only costs the
+ * node free that pop() would have paid anyway.
+ *
+ * @tparam T The type of elements stored in the queue.
+ */
+template<typename T>
+class TtlMPSCQueue {
+public:
+    /**
+     * @brief Construct with a TTL in TSC ticks (see Tsc::from_ns()).
+     */
+    explicit TtlMPSCQueue(uint64_t ttlTicks) noexcept : mTtl(ttlTicks) {}
+
+    /**
+     * @brief Push a copy of a value, stamped with the current TSC.
+     * Safe to call from multiple producer threads concurrently.
+     */
+    bool push(const T& value) noexcept {
+        return mQueue.push(Stamped<T>{Tsc::now(), value});
+    }
+
+    /**
+     * @brief Push a moved value, stamped with the current TSC.
+     */
+    bool push(T&& value) noexcept {
+        return mQueue.push(Stamped<T>{Tsc::now(), std::move(value)});
+    }
+
+    /**
+     * @brief Pop the oldest value that has not expired.
+     * Must only be called by the single consumer thread.
+     */
+    bool pop(T& value) noexcept {
+        discard_expired();
+
+        Stamped<T> stamped;
+        if (!mQueue.pop(stamped)) {
+            return false;
+        }
+        value = std::move(stamped.value);
+        return true;
+    }
+
+    /**
+     * @brief Drop expired values at the front of the queue.
+     *
+     * @return size_t Number of values dropped by this call.
+     */
+    size_t discard_expired() noexcept {
+        if (mTtl == 0) {
+            return 0;
+        }
+        uint64_t now = Tsc::now();
+        size_t dropped = mQueue.discard_front([&](const Stamped<T>& stamped) {
+            return static_cast<int64_t>(now - stamped.tsc) > static_cast<int64_t>(mTtl);
+        });
+        mExpired += dropped;
+        return dropped;
+    }
+
+    /**
+     * @brief Get the total number of values dropped as expired.
+     */
+    uint64_t expired() const noexcept {
+        return mExpired;
+    }
+
+    /**
+     * @brief Change the TTL (consumer thread only). 0 disables dropping.
+     */
+    void set_ttl(uint64_t ttlTicks) noexcept {
+        mTtl = ttlTicks;
+    }
+
+    bool empty() const noexcept { return mQueue.empty(); }
+
+private:
+    MPSCQueue<Stamped<T>> mQueue;
+    uint64_t mTtl;          ///< TTL in ticks, consumer side
+    uint64_t mExpired = 0;  ///< Dropped value count, consumer side
+};
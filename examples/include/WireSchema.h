@@ -0,0 +1,436 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace wire_detail {
+
+/**
+ * @brief A string literal usable as a template argument (field names).
+ */
+template<size_t N>
+struct FieldName {
+    char text[N];
+
+    consteval FieldName(const char (&name)[N]) noexcept {
+        std::copy_n(name, N, text);
+    }
+
+    constexpr std::string_view view() const noexcept {
+        return std::string_view(text, N - 1);
+    }
+};
+
+template<typename T>
+constexpr T byteswap(T value) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return value;
+    } else {
+        using U = std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>;
+        U bits = std::bit_cast<U>(value);
+        if constexpr (sizeof(T) == 2) bits = __builtin_bswap16(bits);
+        if constexpr (sizeof(T) == 4) bits = __builtin_bswap32(bits);
+        if constexpr (sizeof(T) == 8) bits = __builtin_bswap64(bits);
+        return std::bit_cast<T>(bits);
+    }
+}
+
+/**
+ * @brief Unaligned load/store of a scalar in the given byte order.
+ */
+template<std::endian ORDER, typename T>
+inline T load(const std::byte* src) noexcept {
+    T value;
+    std::memcpy(&value, src, sizeof(T));
+    if constexpr (ORDER != std::endian::native) {
+        value = byteswap(value);
+    }
+    return value;
+}
+
+template<std::endian ORDER, typename T>
+inline void store(std::byte* dst, T value) noexcept {
+    if constexpr (ORDER != std::endian::native) {
+        value = byteswap(value);
+    }
+    std::memcpy(dst, &value, sizeof(T));
+}
+
+template<typename T>
+concept Scalar = (std::is_arithmetic_v<T> || std::is_enum_v<T>) &&
+                 (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+/// Wrappers around an integer, e.g. FixedPoint: encoded as raw()
+template<typename T>
+concept RawWrapper = !Scalar<T> && requires(T t) {
+    { t.raw() } -> std::integral;
+    { T::from_raw(t.raw()) } -> std::same_as<T>;
+};
+
+/// Inline byte strings, e.g. FixedSymbol: encoded as WIDTH bytes, no swapping
+template<typename T>
+concept InlineText = requires(const T t) {
+    { T::WIDTH } -> std::convertible_to<size_t>;
+    { t.data() } -> std::convertible_to<const char*>;
+    T(std::string_view());
+};
+
+/**
+ * @brief Encoding of one field type: size on the wire plus load/store.
+ */
+template<typename T>
+struct Codec;
+
+template<Scalar T>
+struct Codec<T> {
+    static constexpr size_t SIZE = sizeof(T);
+
+    template<std::endian ORDER>
+    static T read(const std::byte* src) noexcept {
+        return load<ORDER, T>(src);
+    }
+
+    template<std::endian ORDER>
+    static void write(std::byte* dst, T value) noexcept {
+        store<ORDER>(dst, value);
+    }
+};
+
+template<RawWrapper T>
+struct Codec<T> {
+    using Raw = decltype(std::declval<T>().raw());
+    static constexpr size_t SIZE = sizeof(Raw);
+
+    template<std::endian ORDER>
+    static T read(const std::byte* src) noexcept {
+        return T::from_raw(load<ORDER, Raw>(src));
+    }
+
+    template<std::endian ORDER>
+    static void write(std::byte* dst, T value) noexcept {
+        store<ORDER>(dst, value.raw());
+    }
+};
+
+template<InlineText T>
+struct Codec<T> {
+    static constexpr size_t SIZE = T::WIDTH;
+
+    template<std::endian ORDER>
+    static T read(const std::byte* src) noexcept {
+        const char* text = reinterpret_cast<const char*>(src);
+        return T(std::string_view(text, std::find(text, text + SIZE, '\0') - text));
+    }
+
+    template<std::endian ORDER>
+    static void write(std::byte* dst, const T& value) noexcept {
+        std::memcpy(dst, value.data(), SIZE);
+    }
+};
+
+template<size_t N>
+struct Codec<std::array<char, N>> {
+    static constexpr size_t SIZE = N;
+
+    template<std::endian ORDER>
+    static std::array<char, N> read(const std::byte* src) noexcept {
+        std::array<char, N> value;
+        std::memcpy(value.data(), src, N);
+        return value;
+    }
+
+    template<std::endian ORDER>
+    static void write(std::byte* dst, const std::array<char, N>& value) noexcept {
+        std::memcpy(dst, value.data(), N);
+    }
+};
+
+}  // namespace wire_detail
+
+/**
+ * @brief Schema-wide constants shared by every message of a schema.
+ *
+ * @tparam ID Schema id, checked on decode so foreign bytes are rejected.
+ * @tparam VERSION Current schema version, written by encoders.
+ * @tparam ORDER Wire byte order (little-endian by default, as in SBE).
+ */
+template<uint16_t ID, uint16_t VERSION, std::endian ORDER = std::endian::little>
+struct WireSchema {
+    static constexpr uint16_t SCHEMA_ID = ID;
+    static constexpr uint16_t SCHEMA_VERSION = VERSION;
+    static constexpr std::endian WIRE_ORDER = ORDER;
+};
+
+/**
+ * @brief Describes one field: name, C++ type and the version that added it.
+ *
+ * Supported types: integers, floating point and enums (byte swapped as
+ * needed), integer wrappers with raw()/from_raw() such as FixedPoint, inline
+ * text types with WIDTH/data() such as FixedSymbol, and std::array<char, N>.
+ */
+template<wire_detail::FieldName NAME, typename T, uint16_t SINCE_VERSION = 0>
+struct WireField {
+    using type = T;
+    static constexpr auto name = NAME;
+    static constexpr uint16_t since_version = SINCE_VERSION;
+    static constexpr size_t size = wire_detail::Codec<T>::SIZE;
+};
+
+/**
+ * @brief The 8-byte header in front of every message (SBE layout).
+ */
+struct WireHeader {
+    static constexpr size_t SIZE = 8;
+
+    uint16_t blockLength;   ///< Bytes of fixed fields following the header
+    uint16_t templateId;    ///< Message type within the schema
+    uint16_t schemaId;
+    uint16_t version;       ///< Schema version the encoder was built with
+
+    /**
+     * @brief Read the header of a message without knowing its type (for dispatch).
+     */
+    template<typename Schema>
+    static WireHeader read(const void* buffer) noexcept {
+        const std::byte* p = static_cast<const std::byte*>(buffer);
+        constexpr std::endian ORDER = Schema::WIRE_ORDER;
+        return WireHeader{wire_detail::load<ORDER, uint16_t>(p), wire_detail::load<ORDER, uint16_t>(p + 2),
+                          wire_detail::load<ORDER, uint16_t>(p + 4), wire_detail::load<ORDER, uint16_t>(p + 6)};
+    }
+};
+
+/**
+ * @brief A message type described once at compile time, with zero-copy flyweights.
+ *
+ * Fields are laid out back to back (packed, in declaration order) after a
+ * WireHeader. Offsets are compile-time constants, so Encoder::set<"price">()
+ * and Decoder::get<"price">() compile down to one unaligned load or store,
+ * plus a byte swap when the wire order differs from the host.
+ *
+ * Flyweights wrap raw bytes and never copy the message: point them at an
+ * SPSCRingBuffer slot (Frame, via push_in_place()/pop_batch()), an mmap'd
+ * journal or a socket buffer.
+ *
+ * @tparam Schema A WireSchema.
+ * @tparam TEMPLATE_ID Message type id within the schema.
+ * @tparam Fields WireField descriptors in wire order.
+ *
+ * Versioning (SBE rules):
+ * - New fields are only appended, tagged with the version that added them
+ * - An older decoder skips the unknown tail using the header's blockLength
+ * - A newer decoder reading an older message sees appended fields as absent
+ *   (has() is false, get() returns a value-initialised T)
+ *
+ * Usage Constraints:
+ * - Field names must be unique within a message
+ * - Buffers must hold at least ENCODED_LENGTH bytes for encoding
+ */
+template<typename Schema, uint16_t TEMPLATE_ID, typename... Fields>
+class WireMessage {
+private:
+    // Layout helpers come first: the flyweight signatures below name Field<>
+    struct Layout {
+        size_t index;
+        size_t offset;
+    };
+
+    template<wire_detail::FieldName NAME>
+    static consteval Layout layout() noexcept {
+        constexpr std::array<std::string_view, sizeof...(Fields)> names = {Fields::name.view()...};
+        constexpr std::array<size_t, sizeof...(Fields)> sizes = {Fields::size...};
+        size_t offset = 0;
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (names[i] == NAME.view()) {
+                return Layout{i, offset};
+            }
+            offset += sizes[i];
+        }
+        return Layout{sizeof...(Fields), 0};
+    }
+
+    template<wire_detail::FieldName NAME>
+    struct FieldLookup {
+        static constexpr size_t INDEX = layout<NAME>().index;
+        static_assert(INDEX < sizeof...(Fields), "no field with this name in the message");
+        using type = std::tuple_element_t<INDEX < sizeof...(Fields) ? INDEX : 0, std::tuple<Fields...>>;
+    };
+
+    template<wire_detail::FieldName NAME>
+    using Field = typename FieldLookup<NAME>::type;
+
+public:
+    static constexpr uint16_t ID = TEMPLATE_ID;
+    static constexpr size_t BLOCK_LENGTH = (Fields::size + ... + 0);
+    static constexpr size_t ENCODED_LENGTH = WireHeader::SIZE + BLOCK_LENGTH;
+
+    static_assert(BLOCK_LENGTH <= 0xFFFF, "block length must fit in the 16-bit header field");
+
+    /**
+     * @brief Storage for one encoded message, e.g. as an SPSCRingBuffer element.
+     */
+    struct alignas(8) Frame {
+        std::array<std::byte, ENCODED_LENGTH> bytes;
+
+        void* data() noexcept {
+            return bytes.data();
+        }
+        const void* data() const noexcept {
+            return bytes.data();
+        }
+    };
+
+    /**
+     * @brief Compile-time byte offset of a field within the block.
+     */
+    template<wire_detail::FieldName NAME>
+    static constexpr size_t offset_of() noexcept {
+        return layout<NAME>().offset;
+    }
+
+    /**
+     * @brief Write-side flyweight.
+     */
+    class Encoder {
+    public:
+        /**
+         * @brief Wrap a buffer and write the header.
+         *
+         * @param buffer At least ENCODED_LENGTH writable bytes.
+         */
+        explicit Encoder(void* buffer) noexcept : mBlock(static_cast<std::byte*>(buffer) + WireHeader::SIZE) {
+            std::byte* p = static_cast<std::byte*>(buffer);
+            constexpr std::endian ORDER = Schema::WIRE_ORDER;
+            wire_detail::store<ORDER>(p, uint16_t(BLOCK_LENGTH));
+            wire_detail::store<ORDER>(p + 2, uint16_t(TEMPLATE_ID));
+            wire_detail::store<ORDER>(p + 4, uint16_t(Schema::SCHEMA_ID));
+            wire_detail::store<ORDER>(p + 6, uint16_t(Schema::SCHEMA_VERSION));
+        }
+
+        template<wire_detail::FieldName NAME>
+        Encoder& set(const typename Field<NAME>::type& value) noexcept {
+            using F = Field<NAME>;
+            wire_detail::Codec<typename F::type>::template write<Schema::WIRE_ORDER>(mBlock + offset_of<NAME>(), value);
+            return *this;
+        }
+
+        /**
+         * @brief Bytes written (header plus block).
+         */
+        static constexpr size_t size() noexcept {
+            return ENCODED_LENGTH;
+        }
+
+    private:
+        std::byte* mBlock;
+    };
+
+    /**
+     * @brief Read-side flyweight.
+     */
+    class Decoder {
+    public:
+        /**
+         * @brief Wrap an encoded message.
+         *
+         * @param buffer Start of the header.
+         * @param length Bytes available; checked against the header.
+         */
+        Decoder(const void* buffer, size_t length) noexcept
+            : mBlock(static_cast<const std::byte*>(buffer) + WireHeader::SIZE) {
+            if (length < WireHeader::SIZE) {
+                return;
+            }
+            WireHeader header = WireHeader::read<Schema>(buffer);
+            if (header.schemaId == Schema::SCHEMA_ID && header.templateId == TEMPLATE_ID &&
+                length >= WireHeader::SIZE + header.blockLength) {
+                mBlockLength = header.blockLength;
+                mVersion = header.version;
+                mValid = true;
+            }
+        }
+
+        /**
+         * @brief Check schema id, template id and length.
+         */
+        bool valid() const noexcept {
+            return mValid;
+        }
+
+        /**
+         * @brief Schema version of the encoder that wrote the message.
+         */
+        uint16_t version() const noexcept {
+            return mVersion;
+        }
+
+        /**
+         * @brief Bytes occupied by the message, including fields this
+         *        decoder does not know (for walking a journal).
+         */
+        size_t size() const noexcept {
+            return WireHeader::SIZE + mBlockLength;
+        }
+
+        /**
+         * @brief Check whether the encoder knew about a field.
+         */
+        template<wire_detail::FieldName NAME>
+        bool has() const noexcept {
+            using F = Field<NAME>;
+            return mValid && mVersion >= F::since_version && offset_of<NAME>() + F::size <= mBlockLength;
+        }
+
+        /**
+         * @brief Read a field, or a value-initialised T if absent.
+         */
+        template<wire_detail::FieldName NAME>
+        typename Field<NAME>::type get() const noexcept {
+            using F = Field<NAME>;
+            if constexpr (F::since_version == 0) {
+                // present in every version: only the length check can fail
+                if (offset_of<NAME>() + F::size <= mBlockLength) [[likely]] {
+                    return wire_detail::Codec<typename F::type>::template read<Schema::WIRE_ORDER>(mBlock + offset_of<NAME>());
+                }
+            } else if (has<NAME>()) {
+                return wire_detail::Codec<typename F::type>::template read<Schema::WIRE_ORDER>(mBlock + offset_of<NAME>());
+            }
+            return typename F::type{};
+        }
+
+    private:
+        const std::byte* mBlock;
+        size_t mBlockLength = 0;   ///< 0 when invalid, so every get() fails the length check
+        uint16_t mVersion = 0;
+        bool mValid = false;
+    };
+
+private:
+    static consteval bool unique_names() noexcept {
+        constexpr std::array<std::string_view, sizeof...(Fields)> names = {Fields::name.view()...};
+        for (size_t i = 0; i < names.size(); ++i) {
+            for (size_t j = i + 1; j < names.size(); ++j) {
+                if (names[i] == names[j]) return false;
+            }
+        }
+        return true;
+    }
+
+    static consteval bool appended_in_version_order() noexcept {
+        constexpr std::array<uint16_t, sizeof...(Fields)> since = {Fields::since_version...};
+        for (size_t i = 1; i < since.size(); ++i) {
+            if (since[i] < since[i - 1]) return false;
+        }
+        return true;
+    }
+
+    static_assert(unique_names(), "field names must be unique");
+    static_assert(appended_in_version_order(), "fields added in later versions must come last");
+};
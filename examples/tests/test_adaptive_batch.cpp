@@ -0,0 +1,254 @@
+#include "AdaptiveBatchConsumer.h"
+#include "SPSCRingBuffer.h"
+#include "MPSCQueue.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <set>
+#include <chrono>
+#include <iostream>
+
+// Test 1: Batch limit grows while the backlog is deep
+TEST(AdaptiveBatchConsumerTest, GrowsUnderBacklog) {
+    SPSCRingBuffer<int, 256> buffer;
+    AdaptiveBatchConsumer<decltype(buffer), 16> consumer(buffer);
+
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_TRUE(buffer.push(i));
+    }
+
+    std::vector<int> out;
+    auto collect = [&](int&& v) { out.push_back(v); };
+
+    // Full batches double the limit until MAX_BATCH
+    std::vector<size_t> limits;
+    for (int i = 0; i < 6; ++i) {
+        limits.push_back(consumer.batch_limit());
+        consumer.poll(collect);
+    }
+    EXPECT_EQ(limits, std::vector<size_t>({1, 2, 4, 8, 16, 16}));
+    EXPECT_EQ(consumer.batch_limit(), 16);
+
+    // Drain the rest and check FIFO order is preserved
+    consumer.drain(collect);
+    ASSERT_EQ(out.size(), 200);
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_EQ(out[i], i);
+    }
+    EXPECT_EQ(consumer.items(), 200);
+}
+
+// Test 2: Batch limit shrinks back towards single items when shallow
+TEST(AdaptiveBatchConsumerTest, ShrinksWhenShallow) {
+    SPSCRingBuffer<int, 256> buffer;
+    AdaptiveBatchConsumer<decltype(buffer), 64> consumer(buffer);
+    auto ignore = [](int&&) {};
+
+    for (int i = 0; i < 255; ++i) {
+        buffer.push(i);
+    }
+    consumer.drain(ignore);
+    EXPECT_GT(consumer.batch_limit(), 1);
+
+    // Repeated single-item polls decay the limit back to single items
+    for (int i = 0; i < 10; ++i) {
+        buffer.push(i);
+        EXPECT_EQ(consumer.poll(ignore), 1);
+    }
+    EXPECT_LE(consumer.batch_limit(), 2);
+
+    // An empty poll always settles on 1
+    EXPECT_EQ(consumer.poll(ignore), 0);
+    EXPECT_EQ(consumer.batch_limit(), 1);
+}
+
+// Test 3: Empty queue polls do not count as batches
+TEST(AdaptiveBatchConsumerTest, EmptyPoll) {
+    MPSCQueue<int> queue;
+    AdaptiveBatchConsumer<decltype(queue)> consumer(queue);
+
+    EXPECT_EQ(consumer.poll([](int&&) {}), 0);
+    EXPECT_EQ(consumer.batches(), 0);
+    EXPECT_EQ(consumer.items(), 0);
+    EXPECT_EQ(consumer.batch_limit(), 1);
+}
+
+// Test 4: Concurrent SPSC producer with adaptive consumer keeps FIFO order
+TEST(AdaptiveBatchConsumerTest, SPSCConcurrentOrder) {
+    SPSCRingBuffer<int, 1024> buffer;
+    AdaptiveBatchConsumer<decltype(buffer)> consumer(buffer);
+    constexpr int NUM_ITEMS = 100000;
+
+    std::thread producer([&]() {
+        for (int i = 0; i < NUM_ITEMS; ++i) {
+            while (!buffer.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    bool ordered = true;
+    while (expected < NUM_ITEMS) {
+        size_t n = consumer.poll([&](int&& v) {
+            ordered &= (v == expected);
+            ++expected;
+        });
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(consumer.items(), NUM_ITEMS);
+}
+
+// Test 5: Multiple producers into MPSCQueue, adaptive consumer sees every item
+TEST(AdaptiveBatchConsumerTest, MPSCMultipleProducers) {
+    MPSCQueue<int> queue;
+    AdaptiveBatchConsumer<decltype(queue), 32> consumer(queue);
+    constexpr int NUM_PRODUCERS = 4;
+    constexpr int ITEMS_PER_PRODUCER = 10000;
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < NUM_PRODUCERS; ++t) {
+        producers.emplace_back([&, t]() {
+            for (int i = 0; i < ITEMS_PER_PRODUCER; ++i) {
+                queue.push(t * ITEMS_PER_PRODUCER + i);
+            }
+        });
+    }
+
+    std::set<int> received;
+    while (received.size() < NUM_PRODUCERS * ITEMS_PER_PRODUCER) {
+        if (consumer.poll([&](int&& v) { received.insert(v); }) == 0) {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& t : producers) t.join();
+
+    EXPECT_EQ(received.size(), NUM_PRODUCERS * ITEMS_PER_PRODUCER);
+    EXPECT_EQ(*received.begin(), 0);
+    EXPECT_EQ(*received.rbegin(), NUM_PRODUCERS * ITEMS_PER_PRODUCER - 1);
+    EXPECT_TRUE(queue.empty());
+}
+
+// Test 6: Latency at low load (benchmark, paced producer)
+TEST(AdaptiveBatchConsumerTest, LowLoadLatencyBenchmark) {
+    using Clock = std::chrono::steady_clock;
+    constexpr int NUM_MESSAGES = 500;
+
+    auto run = [&](bool adaptive) {
+        SPSCRingBuffer<Clock::time_point, 1024> buffer;
+        AdaptiveBatchConsumer<decltype(buffer)> consumer(buffer);
+        std::atomic<bool> done{false};
+        int64_t total_ns = 0;
+        int received = 0;
+
+        std::thread producer([&]() {
+            for (int i = 0; i < NUM_MESSAGES; ++i) {
+                while (!buffer.push(Clock::now())) {
+                    std::this_thread::yield();
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+            done.store(true, std::memory_order_release);
+        });
+
+        auto record = [&](Clock::time_point&& ts) {
+            total_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    Clock::now() - ts).count();
+            ++received;
+        };
+
+        while (!done.load(std::memory_order_acquire) || !buffer.empty()) {
+            size_t n = 0;
+            if (adaptive) {
+                n = consumer.poll(record);
+            } else {
+                Clock::time_point ts;
+                if (buffer.pop(ts)) {
+                    record(std::move(ts));
+                    n = 1;
+                }
+            }
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+
+        EXPECT_EQ(received, NUM_MESSAGES);
+        return total_ns / std::max(received, 1);
+    };
+
+    auto single_ns = run(false);
+    auto adaptive_ns = run(true);
+
+    std::cout << "Low load mean latency: single pop " << single_ns
+              << " ns, adaptive " << adaptive_ns << " ns" << std::endl;
+}
+
+// Test 7: Throughput at saturation (benchmark, producer never pauses)
+TEST(AdaptiveBatchConsumerTest, SaturationThroughputBenchmark) {
+    constexpr int ITERATIONS = 1000000;
+
+    auto run = [&](bool adaptive, double& avg_batch) {
+        SPSCRingBuffer<int, 4096> buffer;
+        AdaptiveBatchConsumer<decltype(buffer), 256> consumer(buffer);
+        int64_t sum = 0;
+        int received = 0;
+        auto accumulate = [&](int&& v) {
+            sum += v;
+            ++received;
+        };
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        std::thread producer([&]() {
+            for (int i = 0; i < ITERATIONS; ++i) {
+                while (!buffer.push(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        while (received < ITERATIONS) {
+            size_t n = 0;
+            if (adaptive) {
+                n = consumer.poll(accumulate);
+            } else {
+                int v;
+                if (buffer.pop(v)) {
+                    accumulate(std::move(v));
+                    n = 1;
+                }
+            }
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+        EXPECT_EQ(sum, int64_t(ITERATIONS) * (ITERATIONS - 1) / 2);
+        avg_batch = consumer.batches() ? double(consumer.items()) / consumer.batches() : 1.0;
+        return ITERATIONS / (std::max<int64_t>(duration.count(), 1) / 1e6);
+    };
+
+    double single_batch = 1.0;
+    double adaptive_batch = 1.0;
+    double single_ops = run(false, single_batch);
+    double adaptive_ops = run(true, adaptive_batch);
+
+    std::cout << "Saturation throughput: single pop " << single_ops / 1e6
+              << " million items/sec, adaptive " << adaptive_ops / 1e6
+              << " million items/sec (avg batch " << adaptive_batch << ")" << std::endl;
+}
+
+// Main function is provided by gtest_main
@@ -0,0 +1,294 @@
+#include "BroadcastBus.h"
+#include "Tsc.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+struct Tick {
+    uint64_t id;
+    int64_t price;
+    uint64_t tsc;
+};
+
+// Unique shm name per test so parallel test runs do not collide
+std::string bus_name(const char* test) {
+    return std::string("/hft_bus_") + test + "_" + std::to_string(::getpid());
+}
+
+}  // namespace
+
+// Test 1: Invalid parameters and missing segments are reported, not crashed on
+TEST(BroadcastBusTest, OpenFailures) {
+    BroadcastBusWriter bad("/hft_bus_bad_" + std::to_string(::getpid()), 1000);
+    EXPECT_FALSE(bad.is_open());
+    EXPECT_FALSE(bad.publish(1, Tick{}));
+
+    BroadcastBusReader missing("/hft_bus_missing_" + std::to_string(::getpid()));
+    EXPECT_FALSE(missing.is_open());
+}
+
+// Test 2: Fixed and variable records round-trip across many wraps
+TEST(BroadcastBusTest, RoundTripAcrossWrap) {
+    auto name = bus_name("roundtrip");
+    BroadcastBusWriter writer(name, 4096);
+    ASSERT_TRUE(writer.is_open());
+    BroadcastBusReader reader(name);
+    ASSERT_TRUE(reader.is_open());
+
+    uint64_t expected_id = 0;
+    size_t text_records = 0;
+    bool ok = true;
+
+    for (uint64_t i = 0; i < 5000; ++i) {
+        ASSERT_TRUE(writer.publish(1, Tick{i, int64_t(i * 3), 0}));
+        std::string text(i % 97, char('a' + i % 26));
+        ASSERT_TRUE(writer.publish(2, text.data(), uint32_t(text.size())));
+
+        reader.poll([&](uint32_t type, const void* data, uint32_t size) {
+            if (type == 1) {
+                Tick t;
+                ok &= (size == sizeof(Tick));
+                std::memcpy(&t, data, sizeof(t));
+                ok &= (t.id == expected_id) && (t.price == int64_t(expected_id * 3));
+                ++expected_id;
+            } else {
+                // Text record i follows tick i: i % 97 copies of 'a' + i % 26
+                uint64_t i = expected_id - 1;
+                ok &= (size == i % 97);
+                ok &= size == 0 || static_cast<const char*>(data)[size - 1] == char('a' + i % 26);
+                ++text_records;
+            }
+        });
+    }
+
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(expected_id, 5000);
+    EXPECT_EQ(text_records, 5000);
+    EXPECT_EQ(reader.overruns(), 0);
+    EXPECT_FALSE(writer.publish(3, std::vector<char>(2048).data(), 2048));  // > capacity / 4
+
+    BroadcastBusWriter::unlink(name);
+}
+
+// Test 3: A reader that falls a full buffer behind detects the overrun and the loss
+TEST(BroadcastBusTest, OverrunDetection) {
+    auto name = bus_name("overrun");
+    BroadcastBusWriter writer(name, 4096);
+    ASSERT_TRUE(writer.is_open());
+    BroadcastBusReader reader(name);
+    ASSERT_TRUE(reader.is_open());
+
+    // Tick records are 48 bytes: 1000 of them lap a 4 KB buffer many times
+    for (uint64_t i = 0; i < 1000; ++i) {
+        writer.publish(1, Tick{i, 0, 0});
+    }
+    EXPECT_EQ(reader.poll([](uint32_t, const void*, uint32_t) {}), 0);
+    EXPECT_EQ(reader.overruns(), 1);
+
+    // After resync, new records flow again and the gap is accounted
+    uint64_t first_id = 0;
+    bool got = false;
+    writer.publish(1, Tick{1000, 0, 0});
+    EXPECT_EQ(reader.poll([&](uint32_t, const void* data, uint32_t) {
+        Tick t;
+        std::memcpy(&t, data, sizeof(t));
+        first_id = t.id;
+        got = true;
+    }), 1);
+    EXPECT_TRUE(got);
+    EXPECT_EQ(first_id, 1000);
+    EXPECT_EQ(reader.lost(), 1000);
+
+    BroadcastBusWriter::unlink(name);
+}
+
+// Test 4: Loss is only counted from a sequence the reader was synchronised to
+TEST(BroadcastBusTest, LossCountsFromKnownSequence) {
+    auto name = bus_name("lossbase");
+    BroadcastBusWriter writer(name, 4096);
+    ASSERT_TRUE(writer.is_open());
+    auto ignore = [](uint32_t, const void*, uint32_t) {};
+
+    for (uint64_t i = 0; i < 100000; ++i) {
+        writer.publish(1, Tick{i, 0, 0});
+    }
+
+    // Attached to a busy bus and lapped before the first record
+    BroadcastBusReader reader(name);
+    ASSERT_TRUE(reader.is_open());
+    for (uint64_t i = 0; i < 1002; ++i) {
+        writer.publish(1, Tick{i, 0, 0});
+    }
+    EXPECT_EQ(reader.poll(ignore), 0);
+    writer.publish(1, Tick{0, 0, 0});
+    EXPECT_EQ(reader.poll(ignore), 1);
+    EXPECT_EQ(reader.overruns(), 1);
+    EXPECT_EQ(reader.lost(), 0);   // no sequence to measure from, not the whole history
+
+    // Synchronised now: a lap is counted exactly
+    for (uint64_t i = 0; i < 500; ++i) {
+        writer.publish(1, Tick{i, 0, 0});
+    }
+    EXPECT_EQ(reader.poll(ignore), 0);
+    writer.publish(1, Tick{0, 0, 0});
+    EXPECT_EQ(reader.poll(ignore), 1);
+    EXPECT_EQ(reader.overruns(), 2);
+    EXPECT_EQ(reader.lost(), 500);
+
+    // A pending loss is dropped by an explicit seek
+    for (uint64_t i = 0; i < 500; ++i) {
+        writer.publish(1, Tick{i, 0, 0});
+    }
+    EXPECT_EQ(reader.poll(ignore), 0);
+    EXPECT_EQ(reader.overruns(), 3);
+    for (uint64_t i = 0; i < 10; ++i) {
+        writer.publish(1, Tick{i, 0, 0});
+    }
+    reader.seek_latest();
+    writer.publish(1, Tick{0, 0, 0});
+    EXPECT_EQ(reader.poll(ignore), 1);
+    EXPECT_EQ(reader.lost(), 500);
+
+    BroadcastBusWriter::unlink(name);
+}
+
+// Test 5: Late joiners start at the live tail
+TEST(BroadcastBusTest, LateJoinerStartsAtTail) {
+    auto name = bus_name("late");
+    BroadcastBusWriter writer(name, 1 << 16);
+    ASSERT_TRUE(writer.is_open());
+
+    for (uint64_t i = 0; i < 10; ++i) {
+        writer.publish(1, Tick{i, 0, 0});
+    }
+
+    BroadcastBusReader reader(name);
+    ASSERT_TRUE(reader.is_open());
+    EXPECT_EQ(reader.poll([](uint32_t, const void*, uint32_t) {}), 0);
+
+    writer.publish(1, Tick{10, 0, 0});
+    uint64_t id = 0;
+    EXPECT_EQ(reader.poll([&](uint32_t, const void* data, uint32_t) {
+        std::memcpy(&id, data, sizeof(id));
+    }), 1);
+    EXPECT_EQ(id, 10);
+    EXPECT_EQ(reader.lost(), 0);
+
+    BroadcastBusWriter::unlink(name);
+}
+
+// Test 6: A reader in another process sees every record in order
+TEST(BroadcastBusTest, CrossProcessReader) {
+    auto name = bus_name("xproc");
+    constexpr uint64_t NUM_RECORDS = 10000;
+    BroadcastBusWriter writer(name, 1 << 20);  // large enough to never lap
+    ASSERT_TRUE(writer.is_open());
+
+    // The child signals through a pipe once it has attached at tail 0
+    int ready[2];
+    ASSERT_EQ(::pipe(ready), 0);
+
+    pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        ::close(ready[0]);
+        BroadcastBusReader reader(name);
+        char byte = reader.is_open() ? 1 : 0;
+        if (::write(ready[1], &byte, 1) != 1 || !byte) {
+            ::_exit(2);
+        }
+        uint64_t next = 0;
+        bool ok = true;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while (next < NUM_RECORDS && std::chrono::steady_clock::now() < deadline) {
+            if (reader.poll([&](uint32_t, const void* data, uint32_t) {
+                    Tick t;
+                    std::memcpy(&t, data, sizeof(t));
+                    ok &= (t.id == next);
+                    ++next;
+                }) == 0) {
+                std::this_thread::yield();
+            }
+        }
+        ::_exit(ok && next == NUM_RECORDS && reader.overruns() == 0 ? 0 : 1);
+    }
+
+    ::close(ready[1]);
+    char byte = 0;
+    ASSERT_EQ(::read(ready[0], &byte, 1), 1);
+    ::close(ready[0]);
+    for (uint64_t i = 0; i < NUM_RECORDS; ++i) {
+        writer.publish(1, Tick{i, 0, 0});
+    }
+
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+
+    BroadcastBusWriter::unlink(name);
+}
+
+// Test 7: Delivery latency with N readers (benchmark)
+TEST(BroadcastBusTest, ReaderLatencyBenchmark) {
+    auto name = bus_name("latency");
+    constexpr uint64_t NUM_RECORDS = 2000;
+    BroadcastBusWriter writer(name, 1 << 20);
+    ASSERT_TRUE(writer.is_open());
+
+    for (int num_readers : {1, 2, 4}) {
+        std::atomic<int> ready{0};
+        std::vector<uint64_t> total_ticks(num_readers, 0);
+        std::vector<uint64_t> received(num_readers, 0);
+        std::vector<std::thread> readers;
+
+        for (int r = 0; r < num_readers; ++r) {
+            readers.emplace_back([&, r]() {
+                BroadcastBusReader reader(name);
+                ready.fetch_add(1);
+                while (received[r] < NUM_RECORDS) {
+                    size_t n = reader.poll([&](uint32_t, const void* data, uint32_t) {
+                        Tick t;
+                        std::memcpy(&t, data, sizeof(t));
+                        total_ticks[r] += Tsc::now() - t.tsc;
+                        ++received[r];
+                    });
+                    if (n == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        while (ready.load() < num_readers) {
+            std::this_thread::yield();
+        }
+
+        for (uint64_t i = 0; i < NUM_RECORDS; ++i) {
+            writer.publish(1, Tick{i, 0, Tsc::now()});
+            std::this_thread::yield();
+        }
+        for (auto& t : readers) t.join();
+
+        uint64_t sum = 0;
+        for (int r = 0; r < num_readers; ++r) {
+            EXPECT_EQ(received[r], NUM_RECORDS);
+            sum += total_ticks[r];
+        }
+        std::cout << num_readers << " reader(s): mean delivery latency "
+                  << Tsc::to_ns(sum / (NUM_RECORDS * num_readers)) << " ns" << std::endl;
+    }
+
+    BroadcastBusWriter::unlink(name);
+}
+
+// Main function is provided by gtest_main
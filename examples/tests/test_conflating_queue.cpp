@@ -0,0 +1,172 @@
+#include "ConflatingQueue.h"
+#include "MPSCQueue.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <iostream>
+
+namespace {
+
+struct Quote {
+    uint64_t seq;
+    int64_t bid;
+    int64_t ask;
+};
+
+}  // namespace
+
+// Test 1: Repeated updates to one key conflate into a single dequeue
+TEST(ConflatingQueueTest, LatestValueWins) {
+    auto queue = std::make_unique<ConflatingQueue<Quote, 8>>();
+    EXPECT_TRUE(queue->empty());
+
+    EXPECT_TRUE(queue->push(3, Quote{1, 100, 101}));
+    EXPECT_FALSE(queue->push(3, Quote{2, 102, 103}));
+    EXPECT_FALSE(queue->push(3, Quote{3, 104, 105}));
+
+    uint32_t key = 0;
+    Quote q{};
+    EXPECT_TRUE(queue->pop(key, q));
+    EXPECT_EQ(key, 3);
+    EXPECT_EQ(q.seq, 3);
+    EXPECT_EQ(q.bid, 104);
+    EXPECT_FALSE(queue->pop(key, q));
+    EXPECT_TRUE(queue->empty());
+
+    // After consuming, the next update enqueues the key again
+    EXPECT_TRUE(queue->push(3, Quote{4, 106, 107}));
+    EXPECT_TRUE(queue->pop(key, q));
+    EXPECT_EQ(q.seq, 4);
+}
+
+// Test 2: Keys come out in the order they first became dirty
+TEST(ConflatingQueueTest, FirstDirtyOrder) {
+    auto queue = std::make_unique<ConflatingQueue<int, 16>>();
+
+    queue->push(5, 1);
+    queue->push(2, 1);
+    queue->push(5, 2);
+    queue->push(9, 1);
+    queue->push(2, 2);
+
+    std::vector<std::pair<uint32_t, int>> seen;
+    EXPECT_EQ(queue->drain([&](uint32_t k, const int& v) { seen.emplace_back(k, v); }), 3);
+
+    std::vector<std::pair<uint32_t, int>> expected{{5, 2}, {2, 2}, {9, 1}};
+    EXPECT_EQ(seen, expected);
+}
+
+// Test 3: Memory stays bounded by the number of keys, whatever the update rate
+TEST(ConflatingQueueTest, BoundedByKeys) {
+    constexpr size_t NUM_KEYS = 16;
+    auto queue = std::make_unique<ConflatingQueue<int, NUM_KEYS>>();
+
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 100000; ++i) {
+            queue->push(i % NUM_KEYS, i);
+        }
+        std::vector<int> latest(NUM_KEYS, -1);
+        size_t n = queue->drain([&](uint32_t k, const int& v) { latest[k] = v; });
+        EXPECT_EQ(n, NUM_KEYS);
+        for (size_t k = 0; k < NUM_KEYS; ++k) {
+            EXPECT_EQ(latest[k], 100000 - NUM_KEYS + k);
+        }
+    }
+}
+
+// Test 4: Concurrent producers, consumer never sees torn or stale-after-newer values
+TEST(ConflatingQueueTest, ConcurrentProducers) {
+    constexpr size_t NUM_KEYS = 32;
+    constexpr int NUM_PRODUCERS = 4;
+    constexpr uint64_t UPDATES_PER_KEY = 2000;
+    auto queue = std::make_unique<ConflatingQueue<Quote, NUM_KEYS>>();
+
+    // Each producer owns NUM_KEYS / NUM_PRODUCERS keys and writes increasing seq
+    std::atomic<int> done{0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < NUM_PRODUCERS; ++p) {
+        producers.emplace_back([&, p]() {
+            for (uint64_t seq = 1; seq <= UPDATES_PER_KEY; ++seq) {
+                for (size_t k = p; k < NUM_KEYS; k += NUM_PRODUCERS) {
+                    int64_t px = int64_t(seq * 10 + k);
+                    queue->push(k, Quote{seq, px, px + 1});
+                }
+                if (seq % 128 == 0) {
+                    std::this_thread::yield();
+                }
+            }
+            done.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    std::vector<uint64_t> last_seq(NUM_KEYS, 0);
+    bool consistent = true;
+    bool monotonic = true;
+    size_t consumed = 0;
+
+    auto check = [&](uint32_t k, const Quote& q) {
+        consistent &= (q.bid == int64_t(q.seq * 10 + k)) && (q.ask == q.bid + 1);
+        monotonic &= (q.seq > last_seq[k]);
+        last_seq[k] = q.seq;
+        ++consumed;
+    };
+
+    while (done.load(std::memory_order_acquire) < NUM_PRODUCERS) {
+        if (queue->drain(check) == 0) {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& t : producers) t.join();
+    queue->drain(check);
+
+    EXPECT_TRUE(consistent);
+    EXPECT_TRUE(monotonic);
+    for (size_t k = 0; k < NUM_KEYS; ++k) {
+        EXPECT_EQ(last_seq[k], UPDATES_PER_KEY);
+    }
+    EXPECT_LE(consumed, NUM_KEYS * UPDATES_PER_KEY);
+    std::cout << "Consumer handled " << consumed << " of "
+              << NUM_KEYS * UPDATES_PER_KEY << " updates" << std::endl;
+}
+
+// Test 5: Consumer work per burst, conflating vs plain MPSCQueue (benchmark)
+TEST(ConflatingQueueTest, PerformanceBenchmark) {
+    constexpr size_t NUM_KEYS = 64;
+    constexpr int ITERATIONS = 1000000;
+    auto queue = std::make_unique<ConflatingQueue<Quote, NUM_KEYS>>();
+    MPSCQueue<std::pair<uint32_t, Quote>> plain;
+
+    size_t conflated_items = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        queue->push(i % NUM_KEYS, Quote{uint64_t(i), i, i + 1});
+        if (i % 1024 == 1023) {
+            conflated_items += queue->drain([](uint32_t, const Quote&) {});
+        }
+    }
+    auto mid = std::chrono::high_resolution_clock::now();
+
+    size_t plain_items = 0;
+    for (int i = 0; i < ITERATIONS; ++i) {
+        plain.push({uint32_t(i % NUM_KEYS), Quote{uint64_t(i), i, i + 1}});
+        if (i % 1024 == 1023) {
+            std::pair<uint32_t, Quote> item;
+            while (plain.pop(item)) {
+                ++plain_items;
+            }
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto conflated_us = std::chrono::duration_cast<std::chrono::microseconds>(mid - start).count();
+    auto plain_us = std::chrono::duration_cast<std::chrono::microseconds>(end - mid).count();
+
+    EXPECT_LT(conflated_items, plain_items);
+    std::cout << "Conflating: " << conflated_items << " items consumed in " << conflated_us
+              << " µs, MPSCQueue: " << plain_items << " items in " << plain_us << " µs" << std::endl;
+}
+
+// Main function is provided by gtest_main
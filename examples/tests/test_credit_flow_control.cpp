@@ -0,0 +1,150 @@
+#include "CreditFlowControl.h"
+#include "SPSCRingBuffer.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <chrono>
+#include <iostream>
+
+// Test 1: Credits run out at the window and come back on release
+TEST(CreditFlowControlTest, AcquireRelease) {
+    CreditFlowControl<1> credits(4);
+
+    EXPECT_EQ(credits.available(0), 4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(credits.try_acquire(0));
+    }
+    EXPECT_EQ(credits.in_flight(0), 4);
+    EXPECT_FALSE(credits.try_acquire(0));
+    EXPECT_EQ(credits.exhausted(0), 1);
+
+    credits.release(0, 2);
+    EXPECT_EQ(credits.available(0), 2);
+    EXPECT_FALSE(credits.try_acquire(0, 3));
+    EXPECT_TRUE(credits.try_acquire(0, 2));
+    EXPECT_EQ(credits.available(0), 0);
+    EXPECT_EQ(credits.exhausted(0), 2);
+}
+
+// Test 2: Sources have independent windows and metrics
+TEST(CreditFlowControlTest, PerSourceIsolation) {
+    CreditFlowControl<3> credits(2);
+
+    EXPECT_TRUE(credits.try_acquire(0, 2));
+    EXPECT_FALSE(credits.try_acquire(0));
+
+    // Source 1 is unaffected by source 0 being exhausted
+    EXPECT_TRUE(credits.try_acquire(1));
+    EXPECT_TRUE(credits.try_acquire(1));
+    EXPECT_FALSE(credits.try_acquire(1));
+    EXPECT_FALSE(credits.try_acquire(1));
+
+    EXPECT_EQ(credits.exhausted(0), 1);
+    EXPECT_EQ(credits.exhausted(1), 2);
+    EXPECT_EQ(credits.exhausted(2), 0);
+    EXPECT_EQ(credits.exhausted_total(), 3);
+    EXPECT_EQ(credits.window(2), 2);
+}
+
+// Test 3: Two-hop pipeline with a lagging sink never overflows internal rings
+TEST(CreditFlowControlTest, LaggingSinkBackpressuresIngress) {
+    constexpr int NUM_SOURCES = 2;
+    constexpr int ITEMS_PER_SOURCE = 2000;
+
+    struct Msg {
+        int source;
+        int seq;
+    };
+
+    // Ingress rings hold 15 each; the shared ring B holds 31 >= 2 * 15
+    std::array<SPSCRingBuffer<Msg, 16>, NUM_SOURCES> ingress;
+    SPSCRingBuffer<Msg, 32> stage;
+    CreditFlowControl<NUM_SOURCES> credits(15);
+
+    std::atomic<int> internal_overflows{0};
+    std::atomic<bool> sources_done{false};
+
+    std::vector<std::thread> sources;
+    for (int s = 0; s < NUM_SOURCES; ++s) {
+        sources.emplace_back([&, s]() {
+            for (int i = 0; i < ITEMS_PER_SOURCE; ++i) {
+                while (!credits.try_acquire(s)) {
+                    std::this_thread::yield();
+                }
+                if (!ingress[s].push(Msg{s, i})) {
+                    internal_overflows.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    // Middle stage: forwards both ingress rings into ring B
+    std::thread middle([&]() {
+        int forwarded = 0;
+        while (forwarded < NUM_SOURCES * ITEMS_PER_SOURCE) {
+            bool idle = true;
+            for (auto& ring : ingress) {
+                Msg m;
+                if (ring.pop(m)) {
+                    idle = false;
+                    if (!stage.push(m)) {
+                        internal_overflows.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    ++forwarded;
+                }
+            }
+            if (idle) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    // Lagging sink: returns credits only after each message is finished
+    std::vector<int> next(NUM_SOURCES, 0);
+    bool ordered = true;
+    int received = 0;
+    while (received < NUM_SOURCES * ITEMS_PER_SOURCE) {
+        Msg m;
+        if (stage.pop(m)) {
+            ordered &= (m.seq == next[m.source]);
+            ++next[m.source];
+            ++received;
+            if (received % 256 == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            credits.release(m.source);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    for (auto& t : sources) t.join();
+    middle.join();
+
+    EXPECT_EQ(internal_overflows.load(), 0);
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(credits.in_flight(0), 0);
+    EXPECT_EQ(credits.in_flight(1), 0);
+    std::cout << "Credit exhaustion events at ingress: "
+              << credits.exhausted_total() << std::endl;
+}
+
+// Test 4: Cost of acquire/release on the uncontended path (benchmark)
+TEST(CreditFlowControlTest, PerformanceBenchmark) {
+    CreditFlowControl<1> credits(1024);
+    constexpr int ITERATIONS = 1000000;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        EXPECT_TRUE(credits.try_acquire(0));
+        credits.release(0);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    std::cout << "Acquire + release: "
+              << (duration.count() * 1000.0) / ITERATIONS << " ns/pair" << std::endl;
+}
+
+// Main function is provided by gtest_main
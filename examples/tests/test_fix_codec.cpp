@@ -0,0 +1,263 @@
+#include "FixCodec.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+// Build a framed message from "|"-separated body fields (35=... onwards)
+std::string frame(const std::string& body, const std::string& beginString = "FIX.4.4") {
+    std::string fields = body;
+    std::replace(fields.begin(), fields.end(), '|', '\x01');
+    std::string message = "8=" + beginString + "\x01" "9=" + std::to_string(fields.size()) + "\x01" + fields;
+    unsigned sum = 0;
+    for (char c : message) sum += uint8_t(c);
+    char trailer[8];
+    std::snprintf(trailer, sizeof(trailer), "10=%03u\x01", sum % 256);
+    return message + trailer;
+}
+
+// Reference splitter: tag -> values, in order
+std::vector<std::pair<uint32_t, std::string>> naive_split(const std::string& message) {
+    std::vector<std::pair<uint32_t, std::string>> fields;
+    size_t start = 0;
+    while (start < message.size()) {
+        size_t soh = message.find('\x01', start);
+        size_t eq = message.find('=', start);
+        fields.emplace_back(std::stoul(message.substr(start, eq - start)), message.substr(eq + 1, soh - eq - 1));
+        start = soh + 1;
+    }
+    return fields;
+}
+
+}  // namespace
+
+// Test 1: Parse a framed message into zero-copy fields
+TEST(FixCodecTest, ParseMessage) {
+    std::string wire = frame("35=D|49=CLIENT|56=VENUE|34=12|52=20251018-12:00:00.000|11=ORD-1|55=AAPL|54=1|"
+                             "38=100|44=187.25|40=2|58=note=with equals|");
+    FixMessage message;
+    size_t consumed = 0;
+    ASSERT_EQ(FixParser::parse(wire, message, consumed), FixParseResult::OK);
+    EXPECT_EQ(consumed, wire.size());
+    EXPECT_EQ(message.raw(), wire);
+
+    EXPECT_EQ(message.msg_type(), "D");
+    EXPECT_EQ(message.get(55), "AAPL");
+    EXPECT_EQ(message.get(58), "note=with equals");   // only the first '=' separates
+    EXPECT_FALSE(message.has(99));
+    EXPECT_EQ(message.get(99), "");
+
+    int64_t seq = 0;
+    ASSERT_TRUE(message.get_int(34, seq));
+    EXPECT_EQ(seq, 12);
+    Price price;
+    ASSERT_TRUE(message.get_decimal(44, price));
+    EXPECT_EQ(price, Price::from_raw(187250000));
+
+    // Views point into the receive buffer
+    EXPECT_GE(message.get(11).data(), wire.data());
+    EXPECT_LT(message.get(11).data(), wire.data() + wire.size());
+    EXPECT_EQ(message.field(0).tag, 8u);
+    EXPECT_EQ(message.field(message.field_count() - 1).tag, 10u);
+}
+
+// Test 2: Encoder output parses back and carries a valid checksum
+TEST(FixCodecTest, EncodeRoundTrip) {
+    FixEncoder encoder("FIX.4.4", "CLIENT", "VENUE");
+    char buffer[512];
+    FixWriter writer = encoder.begin(buffer, sizeof(buffer), "D", 42, "20251018-12:00:00.123");
+    writer.add(11, std::string_view("ORD-42"))
+          .add(55, std::string_view("MSFT"))
+          .add(54, '2')
+          .add(38, int64_t(300))
+          .add(44, Price::from_raw(412500000))
+          .add(99999, int64_t(-7));   // high tag: not directly indexed
+    std::string_view wire = writer.finish();
+    ASSERT_FALSE(wire.empty());
+
+    EXPECT_EQ(std::string(wire), frame("35=D|49=CLIENT|56=VENUE|34=42|52=20251018-12:00:00.123|11=ORD-42|"
+                                       "55=MSFT|54=2|38=300|44=412.5|99999=-7|"));
+
+    FixMessage message;
+    size_t consumed = 0;
+    ASSERT_EQ(FixParser::parse(wire, message, consumed), FixParseResult::OK);
+    EXPECT_EQ(message.get(56), "VENUE");
+    EXPECT_EQ(message.get(44), "412.5");
+    int64_t value = 0;
+    ASSERT_TRUE(message.get_int(99999, value));
+    EXPECT_EQ(value, -7);
+
+    // Too small a buffer fails cleanly
+    char small[48];
+    FixWriter tight = encoder.begin(small, sizeof(small), "D", 1, "20251018-12:00:00.000");
+    tight.add(58, std::string_view("this text does not fit in the remaining space"));
+    EXPECT_TRUE(tight.finish().empty());
+}
+
+// Test 3: Partial reads report INCOMPLETE; back-to-back messages are framed one at a time
+TEST(FixCodecTest, StreamFraming) {
+    std::string a = frame("35=0|49=A|56=B|34=1|");
+    std::string b = frame("35=8|49=A|56=B|34=2|39=2|");
+    std::string stream = a + b;
+
+    FixMessage message;
+    size_t consumed = 0;
+    for (size_t n = 0; n < a.size(); ++n) {
+        EXPECT_EQ(FixParser::parse(std::string_view(stream).substr(0, n), message, consumed),
+                  FixParseResult::INCOMPLETE) << n;
+        EXPECT_EQ(consumed, 0u);
+    }
+
+    std::string_view rest = stream;
+    std::vector<std::string> types;
+    while (FixParser::parse(rest, message, consumed) == FixParseResult::OK) {
+        types.emplace_back(message.msg_type());
+        rest.remove_prefix(consumed);
+    }
+    EXPECT_EQ(types, (std::vector<std::string>{"0", "8"}));
+    EXPECT_TRUE(rest.empty());
+}
+
+// Test 4: Corrupt input is rejected
+TEST(FixCodecTest, RejectsBadInput) {
+    FixMessage message;
+    size_t consumed = 0;
+    std::string good = frame("35=0|34=1|");
+
+    std::string flipped = good;
+    flipped[good.find("34=1") + 3] = '2';
+    EXPECT_EQ(FixParser::parse(flipped, message, consumed), FixParseResult::BAD_CHECKSUM);
+
+    EXPECT_EQ(FixParser::parse("9=5\x01", message, consumed), FixParseResult::MALFORMED);
+    EXPECT_EQ(FixParser::parse(frame("35=0|x4=1|"), message, consumed), FixParseResult::MALFORMED);
+    EXPECT_EQ(FixParser::parse(frame("35=0|34|"), message, consumed), FixParseResult::MALFORMED);
+
+    std::string many = "35=0|";
+    for (int i = 0; i < 200; ++i) many += "100=" + std::to_string(i) + "|";
+    EXPECT_EQ(FixParser::parse(frame(many), message, consumed), FixParseResult::TOO_MANY_FIELDS);
+
+    // The message is fully reset between parses
+    ASSERT_EQ(FixParser::parse(good, message, consumed), FixParseResult::OK);
+    EXPECT_FALSE(message.has(100));
+    EXPECT_EQ(message.field_count(), 5u);
+}
+
+// Test 5: SIMD splitting matches a naive splitter at every length and alignment
+TEST(FixCodecTest, MatchesNaiveSplit) {
+    std::mt19937 rng(17);
+    FixMessage message;
+    for (int i = 0; i < 2000; ++i) {
+        std::string body = "35=D|";
+        for (size_t f = rng() % 12; f > 0; --f) {
+            body += std::to_string(1 + rng() % 2000) + "=";
+            for (size_t n = rng() % 40; n > 0; --n) {
+                body += char(rng() % 8 == 0 ? '=' : 'a' + rng() % 26);
+            }
+            body += "|";
+        }
+        std::string wire = frame(body);
+        std::string padded = std::string(i % 7, 'x') + wire;   // vary alignment
+
+        size_t consumed = 0;
+        ASSERT_EQ(FixParser::parse(std::string_view(padded).substr(i % 7), message, consumed),
+                  FixParseResult::OK) << wire;
+        auto expected = naive_split(wire);
+        ASSERT_EQ(message.field_count(), expected.size());
+        for (size_t f = 0; f < expected.size(); ++f) {
+            ASSERT_EQ(message.field(f).tag, expected[f].first);
+            ASSERT_EQ(message.field(f).value, expected[f].second);
+        }
+    }
+}
+
+// Test 6: Header fields too long for the templates invalidate the encoder instead of truncating
+TEST(FixCodecTest, EncoderRejectsOversizedHeader) {
+    char buffer[512];
+    std::string longCompId(200, 'X');
+
+    FixEncoder sender("FIX.4.4", longCompId, "VENUE");
+    EXPECT_FALSE(sender.valid());
+    FixWriter writer = sender.begin(buffer, sizeof(buffer), "0", 1, "20251018-12:00:00.000");
+    writer.add(112, std::string_view("TEST"));
+    EXPECT_TRUE(writer.finish().empty());
+
+    FixEncoder target("FIX.4.4", "CLIENT", longCompId);
+    EXPECT_FALSE(target.valid());
+    EXPECT_TRUE(target.begin(buffer, sizeof(buffer), "0", 1, "20251018-12:00:00.000").finish().empty());
+
+    FixEncoder version("FIXT.1.1-WITH-A-VERY-LONG-SUFFIX", "CLIENT", "VENUE");
+    EXPECT_FALSE(version.valid());
+    EXPECT_TRUE(version.begin(buffer, sizeof(buffer), "0", 1, "20251018-12:00:00.000").finish().empty());
+
+    // Longest BeginString that still fits the prefix template
+    FixEncoder fits(std::string(19, 'F'), "CLIENT", "VENUE");
+    EXPECT_TRUE(fits.valid());
+    std::string_view wire = fits.begin(buffer, sizeof(buffer), "0", 1, "20251018-12:00:00.000").finish();
+    ASSERT_FALSE(wire.empty());
+    FixMessage message;
+    size_t consumed = 0;
+    ASSERT_EQ(FixParser::parse(wire, message, consumed), FixParseResult::OK);
+    EXPECT_EQ(message.get(8), std::string(19, 'F'));
+    EXPECT_EQ(message.get(49), "CLIENT");
+}
+
+// Test 7: Messages per second per core, parse and encode (benchmark)
+TEST(FixCodecTest, ThroughputBenchmark) {
+    constexpr int ITERATIONS = 200000;
+    FixEncoder encoder("FIX.4.4", "CLIENT", "VENUE");
+    std::vector<char> buffer(512);
+
+    int64_t checksum = 0;
+    auto e0 = std::chrono::high_resolution_clock::now();
+    std::string_view wire;
+    for (int i = 0; i < ITERATIONS; ++i) {
+        FixWriter writer = encoder.begin(buffer.data(), buffer.size(), "D", uint64_t(i), "20251018-12:00:00.000");
+        writer.add(11, int64_t(i))
+              .add(55, std::string_view("AAPL"))
+              .add(54, '1')
+              .add(38, int64_t(100))
+              .add(44, Price::from_raw(187250000 + i))
+              .add(40, '2');
+        wire = writer.finish();
+        checksum += wire.size();
+    }
+    auto e1 = std::chrono::high_resolution_clock::now();
+
+    std::string message_text(wire);
+    FixMessage message;
+    size_t consumed = 0;
+    auto p0 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        FixParser::parse(message_text, message, consumed);
+        checksum += message.get(44).size();
+    }
+    auto p1 = std::chrono::high_resolution_clock::now();
+
+    auto n0 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS / 10; ++i) {
+        std::map<int, std::string> fields;
+        for (auto& [tag, value] : naive_split(message_text)) fields[int(tag)] = value;
+        checksum -= fields[44].size();
+    }
+    auto n1 = std::chrono::high_resolution_clock::now();
+    EXPECT_GT(checksum, 0);
+
+    auto rate = [](auto a, auto b, int n) {
+        return n / std::chrono::duration<double>(b - a).count();
+    };
+    std::cout << "FIX (" << message_text.size() << " bytes): encode " << rate(e0, e1, ITERATIONS)
+              << " msg/s, parse " << rate(p0, p1, ITERATIONS) << " msg/s, std::map split "
+              << rate(n0, n1, ITERATIONS / 10) << " msg/s (single core)" << std::endl;
+}
+
+// Main function is provided by gtest_main
@@ -0,0 +1,182 @@
+#include "FixedPoint.h"
+#include "SPSCRingBuffer.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <cstdlib>
+
+namespace {
+
+struct Fill {
+    Price price;
+    Quantity qty;
+};
+static_assert(std::is_trivially_copyable_v<Price> && sizeof(Price) == 8);
+static_assert(std::is_trivially_copyable_v<Fill>);
+
+constexpr Price kTick = Price::from_raw(5000);   // 0.005
+static_assert(Price::from_int(100).raw() == 100000000);
+static_assert((Price::from_raw(1) + Price::from_raw(2)).raw() == 3);
+static_assert((Price::from_int(2) * Quantity::from_int(3)).raw() == Notional::from_int(6).raw());
+
+}  // namespace
+
+// Test 1: Parse and format round-trip exactly
+TEST(FixedPointTest, ParseAndFormat) {
+    Price price;
+    ASSERT_TRUE(Price::parse("123.45", price));
+    EXPECT_EQ(price.raw(), 123450000);
+    EXPECT_EQ(price.to_string(), "123.45");
+
+    ASSERT_TRUE(Price::parse("-0.000001", price));
+    EXPECT_EQ(price.raw(), -1);
+    EXPECT_EQ(price.to_string(), "-0.000001");
+
+    ASSERT_TRUE(Price::parse("42", price));
+    EXPECT_EQ(price, Price::from_int(42));
+    EXPECT_EQ(price.to_string(), "42");
+
+    ASSERT_TRUE(Price::parse("0.1", price));
+    EXPECT_EQ(price.raw(), 100000);   // no binary rounding: 0.1 is exactly 0.1
+    ASSERT_TRUE(Price::parse("7.50000000000", price));   // extra zero decimals are fine
+    EXPECT_EQ(price.to_string(), "7.5");
+    ASSERT_TRUE(Price::parse("9223372036854.775807", price));
+    EXPECT_EQ(price.raw(), INT64_MAX);
+
+    for (const char* bad : {"", "-", ".", "1.2.3", "12a", "+5", "1e5", " 1", "1.0000001",
+                            "9223372036854.775808", "99999999999999999999"}) {
+        Price untouched = Price::from_int(1);
+        EXPECT_FALSE(Price::parse(bad, untouched)) << bad;
+        EXPECT_EQ(untouched, Price::from_int(1));
+    }
+}
+
+// Test 2: SIMD and scalar parsers agree on random and malformed input
+TEST(FixedPointTest, SimdMatchesScalar) {
+    std::mt19937_64 rng(99);
+    const std::string alphabet = "0123456789.-x";
+    for (int i = 0; i < 200000; ++i) {
+        std::string text;
+        if (i % 2 == 0) {
+            // well-formed: random integer and fraction digit counts
+            if (rng() % 4 == 0) text += '-';
+            for (size_t d = rng() % 14; d > 0; --d) text += char('0' + rng() % 10);
+            if (rng() % 4 != 0) {
+                text += '.';
+                for (size_t d = rng() % 10; d > 0; --d) text += char('0' + rng() % 10);
+            }
+        } else {
+            for (size_t n = rng() % 20; n > 0; --n) text += alphabet[rng() % alphabet.size()];
+        }
+
+        Price scalar = Price::from_raw(-7);
+        Price simd = Price::from_raw(-7);
+        bool ok_scalar = Price::parse_scalar(text, scalar);
+        bool ok_simd = Price::parse(text, simd);
+        ASSERT_EQ(ok_scalar, ok_simd) << text;
+        ASSERT_EQ(scalar, simd) << text;
+
+        if (ok_scalar) {
+            Price again;
+            ASSERT_TRUE(Price::parse(scalar.to_string(), again)) << text;
+            ASSERT_EQ(again, scalar) << text;
+        }
+    }
+}
+
+// Test 3: Exact arithmetic, rescaling and tick rounding
+TEST(FixedPointTest, Arithmetic) {
+    Price a = Price::from_raw(100100000);   // 100.1
+    Price b = Price::from_raw(200200000);   // 200.2
+    EXPECT_EQ((a + b).to_string(), "300.3");   // 0.1 + 0.2 style sums are exact
+    EXPECT_EQ((b - a - a).raw(), 0);
+    EXPECT_EQ((a * 3).to_string(), "300.3");
+    EXPECT_LT(a, b);
+    EXPECT_EQ(-a, Price::from_raw(-100100000));
+
+    Quantity qty;
+    ASSERT_TRUE(Quantity::parse("12.5", qty));
+    Notional notional = a * qty;
+    EXPECT_EQ(notional.to_string(), "1251.25");
+
+    Price mid = Price::from_raw(100002499);   // 100.002499
+    EXPECT_EQ(mid.round_to(kTick, Rounding::FLOOR).to_string(), "100");
+    EXPECT_EQ(mid.round_to(kTick, Rounding::CEIL).to_string(), "100.005");
+    EXPECT_EQ(mid.round_to(kTick, Rounding::NEAREST).to_string(), "100");
+    EXPECT_EQ((-mid).round_to(kTick, Rounding::FLOOR).to_string(), "-100.005");
+    EXPECT_EQ((-mid).round_to(kTick, Rounding::TRUNCATE).to_string(), "-100");
+
+    EXPECT_EQ(notional.rescale<2>(Rounding::NEAREST).to_string(), "1251.25");
+    EXPECT_EQ(Price::from_raw(1250000).rescale<1>(Rounding::NEAREST).to_string(), "1.3");
+    EXPECT_EQ(Price::from_raw(-1250000).rescale<1>(Rounding::NEAREST).to_string(), "-1.3");
+    EXPECT_EQ(Price::from_raw(1250000).rescale<1>(Rounding::TRUNCATE).to_string(), "1.2");
+}
+
+// Test 4: Binary feed prices at other scales convert exactly or with a named rounding
+TEST(FixedPointTest, BinaryFeedConversion) {
+    // ITCH-style 4 decimals, and a 9-decimal feed
+    EXPECT_EQ(Price::from_scaled<4>(1234567).to_string(), "123.4567");
+    EXPECT_EQ(Price::from_scaled<9>(123456789500).to_string(), "123.45679");
+    EXPECT_EQ(Price::from_scaled<9>(123456789500, Rounding::TRUNCATE).to_string(), "123.456789");
+    EXPECT_EQ(Price::from_scaled<6>(-5).raw(), -5);
+}
+
+// Test 5: Fixed-point fills flow through a ring buffer unchanged
+TEST(FixedPointTest, ThroughRingBuffer) {
+    SPSCRingBuffer<Fill, 64> ring;
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_TRUE(ring.push(Fill{Price::from_raw(i * 1000001), Quantity::from_int(i)}));
+    }
+    Fill fill{};
+    for (int i = 0; i < 50; ++i) {
+        ASSERT_TRUE(ring.pop(fill));
+        EXPECT_EQ(fill.price.raw(), i * 1000001);
+        EXPECT_EQ(fill.qty, Quantity::from_int(i));
+    }
+}
+
+// Test 6: Parse throughput, SIMD vs scalar vs strtod (benchmark)
+TEST(FixedPointTest, ParseBenchmark) {
+    constexpr int ITERATIONS = 1000000;
+    std::mt19937_64 rng(5);
+    std::vector<std::string> texts(1024);
+    for (auto& text : texts) {
+        text = std::to_string(rng() % 100000) + "." + std::to_string(100000 + rng() % 900000);
+    }
+
+    auto measure = [&](auto&& parse) {
+        int64_t sum = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            sum += parse(texts[i & 1023]);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::make_pair(sum, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() * 1.0 / ITERATIONS);
+    };
+
+    auto [sum_simd, ns_simd] = measure([](const std::string& text) {
+        Price p;
+        Price::parse(text, p);
+        return p.raw();
+    });
+    auto [sum_scalar, ns_scalar] = measure([](const std::string& text) {
+        Price p;
+        Price::parse_scalar(text, p);
+        return p.raw();
+    });
+    auto [sum_strtod, ns_strtod] = measure([](const std::string& text) {
+        return int64_t(std::strtod(text.c_str(), nullptr) * 1e6 + 0.5);
+    });
+
+    EXPECT_EQ(sum_simd, sum_scalar);
+    std::cout << "Price parse: dispatch (SSE4.1 if available) " << ns_simd << " ns, scalar "
+              << ns_scalar << " ns, strtod " << ns_strtod << " ns" << std::endl;
+}
+
+// Main function is provided by gtest_main
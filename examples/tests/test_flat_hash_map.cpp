@@ -0,0 +1,233 @@
+#include "FlatHashMap.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+
+namespace {
+
+struct OrderRef {
+    uint32_t book;
+    uint32_t slot;
+    int64_t price;
+};
+
+// Hash that sends every key to the same home slot, to exercise long probe runs
+struct CollidingHash {
+    size_t operator()(uint64_t key) const noexcept {
+        return (key & 0x7F) | (size_t{5} << 7);
+    }
+};
+
+}  // namespace
+
+// Test 1: Basic insert/find/assign/erase
+TEST(FlatHashMapTest, BasicOperations) {
+    FlatHashMap<uint64_t, OrderRef> map(100);
+    EXPECT_TRUE(map.empty());
+    EXPECT_GE(map.capacity(), 100);
+
+    EXPECT_TRUE(map.insert(42, OrderRef{1, 2, 100}));
+    EXPECT_FALSE(map.insert(42, OrderRef{9, 9, 9}));  // duplicate rejected
+    EXPECT_EQ(map.size(), 1);
+
+    OrderRef* ref = map.find(42);
+    ASSERT_NE(ref, nullptr);
+    EXPECT_EQ(ref->price, 100);
+    EXPECT_EQ(map.find(43), nullptr);
+
+    EXPECT_TRUE(map.assign(42, OrderRef{1, 2, 101}));
+    EXPECT_EQ(map.find(42)->price, 101);
+    EXPECT_TRUE(map.assign(43, OrderRef{3, 4, 5}));
+    EXPECT_EQ(map.size(), 2);
+
+    EXPECT_TRUE(map.erase(42));
+    EXPECT_FALSE(map.erase(42));
+    EXPECT_EQ(map.find(42), nullptr);
+    EXPECT_NE(map.find(43), nullptr);
+    EXPECT_EQ(map.size(), 1);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(43), nullptr);
+}
+
+// Test 2: Capacity is preallocated and never exceeded
+TEST(FlatHashMapTest, FixedCapacity) {
+    FlatHashMap<uint64_t, uint64_t> map(1000);
+    size_t capacity = map.capacity();
+
+    for (uint64_t i = 0; i < capacity; ++i) {
+        EXPECT_TRUE(map.insert(i, i * 2));
+    }
+    EXPECT_FALSE(map.insert(capacity, 0));
+    EXPECT_FALSE(map.assign(capacity, 0));
+    EXPECT_TRUE(map.assign(0, 7));  // existing keys can still be updated
+    for (uint64_t i = 1; i < capacity; ++i) {
+        ASSERT_NE(map.find(i), nullptr);
+        EXPECT_EQ(*map.find(i), i * 2);
+    }
+}
+
+// Test 3: Backward-shift erase keeps long collision runs intact
+TEST(FlatHashMapTest, EraseWithinCollisionRun) {
+    FlatHashMap<uint64_t, uint64_t, CollidingHash> map(200);
+
+    for (uint64_t i = 0; i < 100; ++i) {
+        EXPECT_TRUE(map.insert(i, i));
+    }
+    // Erase every third key from the middle of the single run
+    for (uint64_t i = 0; i < 100; i += 3) {
+        EXPECT_TRUE(map.erase(i));
+    }
+    for (uint64_t i = 0; i < 100; ++i) {
+        if (i % 3 == 0) {
+            EXPECT_EQ(map.find(i), nullptr);
+        } else {
+            ASSERT_NE(map.find(i), nullptr) << i;
+            EXPECT_EQ(*map.find(i), i);
+        }
+    }
+}
+
+// Test 4: Random churn agrees with std::unordered_map, and leaves no tombstones behind
+TEST(FlatHashMapTest, RandomChurnMatchesReference) {
+    FlatHashMap<uint64_t, uint64_t> map(4096);
+    std::unordered_map<uint64_t, uint64_t> reference;
+    std::mt19937_64 rng(12345);
+
+    for (int op = 0; op < 200000; ++op) {
+        uint64_t key = rng() % 8192;
+        switch (rng() % 3) {
+            case 0: {
+                bool fits = reference.size() < map.capacity() || reference.count(key);
+                EXPECT_EQ(map.assign(key, op), fits);
+                if (fits) reference[key] = op;
+                break;
+            }
+            case 1:
+                EXPECT_EQ(map.erase(key), reference.erase(key) == 1);
+                break;
+            default: {
+                const uint64_t* value = map.find(key);
+                auto it = reference.find(key);
+                ASSERT_EQ(value != nullptr, it != reference.end());
+                if (value) {
+                    EXPECT_EQ(*value, it->second);
+                }
+            }
+        }
+    }
+    EXPECT_EQ(map.size(), reference.size());
+
+    size_t visited = 0;
+    map.for_each([&](uint64_t key, uint64_t value) {
+        EXPECT_EQ(reference.at(key), value);
+        ++visited;
+    });
+    EXPECT_EQ(visited, reference.size());
+
+    // Erasing everything leaves only EMPTY control bytes behind
+    for (auto& [key, value] : reference) EXPECT_TRUE(map.erase(key));
+    EXPECT_TRUE(map.empty());
+    visited = 0;
+    map.for_each([&](uint64_t, uint64_t) { ++visited; });
+    EXPECT_EQ(visited, 0);
+}
+
+// Test 5: Readers never see a wrong value while the writer inserts, updates and erases
+TEST(FlatHashMapTest, SingleWriterMultiReader) {
+    FlatHashMap<uint64_t, uint64_t> map(1 << 14);
+    constexpr uint64_t STABLE = 4096;   // always present, value == key * 3
+    constexpr int NUM_READERS = 3;
+    for (uint64_t i = 0; i < STABLE; ++i) {
+        map.insert(i, i * 3);
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> ok{true};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < NUM_READERS; ++r) {
+        readers.emplace_back([&, r]() {
+            uint64_t key = r;
+            while (!done.load(std::memory_order_relaxed)) {
+                for (int i = 0; i < 256; ++i) {
+                    key = (key * 2654435761ull + 1) % STABLE;
+                    uint64_t value = 0;
+                    if (!map.find_concurrent(key, value) || value != key * 3) {
+                        ok.store(false);
+                    }
+                }
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    // Churn keys that share probe runs with the stable ones
+    for (int round = 0; round < 200; ++round) {
+        for (uint64_t i = STABLE; i < STABLE + 4096; ++i) {
+            map.insert(i, round);
+        }
+        for (uint64_t i = STABLE; i < STABLE + 4096; ++i) {
+            map.erase(i);
+        }
+        if (round % 8 == 0) {
+            std::this_thread::yield();
+        }
+    }
+    done.store(true);
+    for (auto& t : readers) t.join();
+
+    EXPECT_TRUE(ok.load());
+    EXPECT_EQ(map.size(), STABLE);
+}
+
+// Test 6: Lookup throughput versus std::unordered_map (benchmark)
+TEST(FlatHashMapTest, LookupBenchmark) {
+    constexpr size_t LOOKUPS = 2000000;
+
+    for (size_t num_keys : {size_t(1) << 16, size_t(1) << 20}) {
+        std::mt19937_64 rng(42);
+        std::vector<uint64_t> keys(num_keys);
+        for (auto& key : keys) key = rng();
+
+        auto flat = std::make_unique<FlatHashMap<uint64_t, uint64_t>>(num_keys);
+        std::unordered_map<uint64_t, uint64_t> node;
+        node.reserve(num_keys);
+        for (size_t i = 0; i < num_keys; ++i) {
+            flat->insert(keys[i], i);
+            node.emplace(keys[i], i);
+        }
+
+        // Random hit order, precomputed so both maps see the same pattern
+        std::vector<uint64_t> probes(LOOKUPS);
+        for (auto& probe : probes) probe = keys[rng() % num_keys];
+
+        uint64_t sum_flat = 0;
+        uint64_t sum_node = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (uint64_t probe : probes) {
+            sum_flat += *flat->find(probe);
+        }
+        auto mid = std::chrono::high_resolution_clock::now();
+        for (uint64_t probe : probes) {
+            sum_node += node.find(probe)->second;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        EXPECT_EQ(sum_flat, sum_node);
+        std::cout << num_keys << " keys: FlatHashMap "
+                  << std::chrono::duration_cast<std::chrono::nanoseconds>(mid - start).count() * 1.0 / LOOKUPS
+                  << " ns/lookup, std::unordered_map "
+                  << std::chrono::duration_cast<std::chrono::nanoseconds>(end - mid).count() * 1.0 / LOOKUPS
+                  << " ns/lookup" << std::endl;
+    }
+}
+
+// Main function is provided by gtest_main
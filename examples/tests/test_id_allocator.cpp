@@ -0,0 +1,152 @@
+#include "IdAllocator.h"
+#include "LockFreeStack.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <set>
+
+// Test 1: Every id is handed out exactly once, then exhaustion, then reuse
+TEST(IdAllocatorTest, AllocateAllThenReuse) {
+    IdAllocator ids(10000);
+    std::set<uint32_t> seen;
+    uint32_t id;
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_TRUE(ids.allocate(id));
+        ASSERT_LT(id, 10000u);
+        ASSERT_TRUE(seen.insert(id).second);
+    }
+    EXPECT_FALSE(ids.allocate(id));
+    EXPECT_EQ(ids.available(), 0u);
+
+    EXPECT_TRUE(ids.release(4321));
+    EXPECT_FALSE(ids.release(4321));    // double free
+    EXPECT_FALSE(ids.release(10000));   // out of range
+    EXPECT_FALSE(ids.is_allocated(4321));
+    ASSERT_TRUE(ids.allocate(id));
+    EXPECT_EQ(id, 4321u);
+    EXPECT_TRUE(ids.is_allocated(id));
+}
+
+// Test 2: Capacities that do not fill the last leaf or summary word
+TEST(IdAllocatorTest, PartialWords) {
+    for (uint32_t capacity : {0u, 1u, 63u, 64u, 65u, 4095u, 4096u, 4097u, 70000u}) {
+        IdAllocator ids(capacity);
+        EXPECT_EQ(ids.available(), capacity);
+        uint32_t id, count = 0;
+        while (ids.allocate(id)) {
+            ASSERT_LT(id, capacity);
+            ++count;
+        }
+        EXPECT_EQ(count, capacity) << "capacity " << capacity;
+    }
+}
+
+// Test 3: Concurrent allocate/release never hands one id to two owners
+TEST(IdAllocatorTest, ConcurrentExclusiveOwnership) {
+    constexpr uint32_t CAPACITY = 512;
+    constexpr int NUM_THREADS = 8;
+    constexpr int ITERATIONS = 20000;
+    IdAllocator ids(CAPACITY);
+    std::vector<std::atomic<int>> owner(CAPACITY);
+    for (auto& o : owner) o.store(-1);
+    std::atomic<int> violations{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            std::vector<uint32_t> held;
+            for (int i = 0; i < ITERATIONS; ++i) {
+                uint32_t id;
+                // Hold up to 80 ids per thread: 640 > CAPACITY, so exhaustion happens
+                if (held.size() < 80 && ids.allocate(id)) {
+                    int expected = -1;
+                    if (!owner[id].compare_exchange_strong(expected, t)) violations.fetch_add(1);
+                    held.push_back(id);
+                } else if (!held.empty()) {
+                    uint32_t victim = held[size_t(i) % held.size()];
+                    held.erase(held.begin() + long(size_t(i) % held.size()));
+                    owner[victim].store(-1);
+                    if (!ids.release(victim)) violations.fetch_add(1);
+                }
+                if (i % 256 == 0) std::this_thread::yield();
+            }
+            for (uint32_t id : held) {
+                owner[id].store(-1);
+                ids.release(id);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    EXPECT_EQ(violations.load(), 0);
+    EXPECT_EQ(ids.available(), CAPACITY);
+    // Summaries were restored: every id can be allocated again
+    uint32_t id, count = 0;
+    while (ids.allocate(id)) ++count;
+    EXPECT_EQ(count, CAPACITY);
+}
+
+// Test 4: Threads spread over different words via their hints
+TEST(IdAllocatorTest, ThreadHintsSpreadIds) {
+    IdAllocator ids(1 << 16);
+    std::vector<uint32_t> first(4);
+    for (size_t t = 0; t < first.size(); ++t) {
+        std::thread([&, t]() {
+            uint32_t id;
+            ASSERT_TRUE(ids.allocate(id));
+            first[t] = id;
+            for (int i = 0; i < 10; ++i) {
+                uint32_t next;
+                ASSERT_TRUE(ids.allocate(next));
+                EXPECT_EQ(next / 64, id / 64);   // later ids come from the same leaf
+            }
+        }).join();
+    }
+    EXPECT_EQ(ids.available(), (1u << 16) - 44);
+}
+
+// Test 5: Allocate+release throughput versus a LockFreeStack of ids (benchmark)
+TEST(IdAllocatorTest, ContentionBenchmark) {
+    constexpr uint32_t CAPACITY = 1 << 16;
+    constexpr int OPS_PER_THREAD = 200000;
+
+    for (int threads_count : {1, 4, 8}) {
+        auto run = [&](auto&& op) {
+            std::vector<std::thread> threads;
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int t = 0; t < threads_count; ++t) {
+                threads.emplace_back([&]() {
+                    for (int i = 0; i < OPS_PER_THREAD; ++i) op();
+                });
+            }
+            for (auto& t : threads) t.join();
+            auto end = std::chrono::high_resolution_clock::now();
+            return double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) /
+                   (double(threads_count) * OPS_PER_THREAD);
+        };
+
+        IdAllocator ids(CAPACITY);
+        double ns_bitmap = run([&]() {
+            uint32_t id;
+            if (ids.allocate(id)) ids.release(id);
+        });
+
+        LockFreeStack<uint32_t> stack;
+        for (uint32_t i = 0; i < CAPACITY; ++i) stack.push(i);
+        double ns_stack = run([&]() {
+            uint32_t id;
+            if (stack.pop(id)) stack.push(id);
+        });
+
+        EXPECT_EQ(ids.available(), CAPACITY);
+        std::cout << threads_count << " threads: IdAllocator allocate+release " << ns_bitmap
+                  << " ns, LockFreeStack pop+push " << ns_stack << " ns" << std::endl;
+    }
+}
+
+// Main function is provided by gtest_main
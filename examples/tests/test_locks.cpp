@@ -0,0 +1,278 @@
+#include "Locks.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+
+namespace {
+
+/**
+ * Increment a plain counter under the lock from several threads; any lost
+ * update means mutual exclusion failed.
+ */
+template<typename Lock>
+void check_mutual_exclusion(int threads_count, int per_thread) {
+    Lock lock;
+    int64_t counter = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threads_count; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < per_thread; ++i) {
+                std::lock_guard<Lock> guard(lock);
+                counter = counter + 1;
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(counter, int64_t(threads_count) * per_thread);
+}
+
+/**
+ * Time per lock+unlock pair across threads_count threads, with a short
+ * critical section touching shared data.
+ */
+template<typename Lock>
+double contended_ns(int threads_count, int per_thread) {
+    Lock lock;
+    int64_t shared[8] = {};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threads_count; ++t) {
+        threads.emplace_back([&]() {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (int i = 0; i < per_thread; ++i) {
+                std::lock_guard<Lock> guard(lock);
+                for (auto& s : shared) ++s;
+            }
+        });
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) t.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    EXPECT_EQ(shared[7], int64_t(threads_count) * per_thread);
+    return double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) /
+           (double(threads_count) * per_thread);
+}
+
+}  // namespace
+
+// Test 1: Every lock provides mutual exclusion under contention
+TEST(LocksTest, MutualExclusion) {
+    check_mutual_exclusion<AdaptiveMutex>(8, 20000);
+    check_mutual_exclusion<TicketLock>(4, 5000);
+    check_mutual_exclusion<McsLock>(4, 5000);
+    check_mutual_exclusion<RwLock>(4, 5000);
+}
+
+// Test 2: AdaptiveMutex sleeps while held and wakes on unlock
+TEST(LocksTest, AdaptiveMutexBlocksAndWakes) {
+    AdaptiveMutex mutex;
+    mutex.lock();
+    EXPECT_FALSE(mutex.try_lock());
+
+    std::atomic<bool> acquired{false};
+    std::thread waiter([&]() {
+        mutex.lock();
+        acquired.store(true);
+        mutex.unlock();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));   // past the spin phase: asleep on the futex
+    EXPECT_FALSE(acquired.load());
+    mutex.unlock();
+    waiter.join();
+    EXPECT_TRUE(acquired.load());
+    EXPECT_TRUE(mutex.try_lock());
+    mutex.unlock();
+
+    // Failed spins shrink the budget instead of ratcheting it up to MAX_SPINS
+    for (int round = 0; round < 50; ++round) {
+        std::atomic<bool> held{false};
+        std::thread holder([&]() {
+            mutex.lock();
+            held.store(true);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            mutex.unlock();
+        });
+        while (!held.load()) std::this_thread::yield();
+        mutex.lock();
+        mutex.unlock();
+        holder.join();
+    }
+    EXPECT_LT(mutex.spin_average(), 10u);
+}
+
+// Test 3: TicketLock serves waiters in arrival order
+TEST(LocksTest, TicketLockIsFifo) {
+    TicketLock lock;
+    lock.lock();
+    EXPECT_FALSE(lock.try_lock());
+
+    std::vector<int> order;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            lock.lock();
+            order.push_back(t);
+            lock.unlock();
+        });
+        // Wait until thread t holds its ticket before starting the next
+        while (lock.queue_depth() != uint32_t(t) + 2) std::this_thread::yield();
+    }
+    lock.unlock();
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(lock.queue_depth(), 0u);
+}
+
+// Test 4: MCS with explicit nodes, nested per-thread nodes and out-of-order unlocks
+TEST(LocksTest, McsNodes) {
+    McsLock a, b;
+    McsLock::Node node;
+    a.lock(node);
+    EXPECT_FALSE(a.try_lock());
+    a.unlock(node);
+    EXPECT_TRUE(a.try_lock());
+    a.unlock();
+
+    // Two locks held at once through the per-thread nodes, released in acquisition order
+    std::unique_lock<McsLock> first(a);
+    std::unique_lock<McsLock> second(b);
+    first.unlock();
+    std::thread([&]() {
+        EXPECT_TRUE(a.try_lock());
+        a.unlock();
+        EXPECT_FALSE(b.try_lock());
+    }).join();
+    second.unlock();
+
+    // Hand-off to a queued waiter
+    std::atomic<bool> acquired{false};
+    a.lock();
+    std::thread waiter([&]() {
+        std::lock_guard<McsLock> guard(a);
+        acquired.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(acquired.load());
+    a.unlock();
+    waiter.join();
+    EXPECT_TRUE(acquired.load());
+}
+
+// Test 5: RwLock admits concurrent readers and keeps writers exclusive
+TEST(LocksTest, RwLockReadersAndWriters) {
+    RwLock lock;
+    lock.lock_shared();
+    std::thread([&]() {
+        EXPECT_TRUE(lock.try_lock_shared());   // a second reader gets in
+        lock.unlock_shared();
+    }).join();
+
+    std::atomic<bool> written{false};
+    std::thread writer([&]() {
+        std::lock_guard<RwLock> guard(lock);
+        written.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(written.load());   // writer waits for the reader
+    lock.unlock_shared();
+    writer.join();
+    EXPECT_TRUE(written.load());
+
+    // try_lock fails while a reader or a writer is in, and works with std::scoped_lock
+    lock.lock_shared();
+    std::thread([&]() { EXPECT_FALSE(lock.try_lock()); }).join();
+    lock.unlock_shared();
+    EXPECT_TRUE(lock.try_lock());
+    std::thread([&]() {
+        EXPECT_FALSE(lock.try_lock());
+        EXPECT_FALSE(lock.try_lock_shared());
+    }).join();
+    lock.unlock();
+    {
+        AdaptiveMutex other;
+        std::scoped_lock both(lock, other);
+        EXPECT_FALSE(other.try_lock());
+    }
+    EXPECT_TRUE(lock.try_lock_shared());
+    lock.unlock_shared();
+
+    // Readers always see both halves of a pair updated together
+    int64_t pair[2] = {0, 0};
+    std::atomic<bool> stop{false};
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            while (!stop.load()) {
+                std::shared_lock<RwLock> guard(lock);
+                if (pair[0] != pair[1]) torn.fetch_add(1);
+            }
+        });
+    }
+    for (int i = 0; i < 2000; ++i) {
+        std::lock_guard<RwLock> guard(lock);
+        ++pair[0];
+        std::this_thread::yield();
+        ++pair[1];
+    }
+    stop.store(true);
+    for (auto& t : readers) t.join();
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(pair[1], 2000);
+}
+
+// Test 6: Contention suite: every lock at 1-8 threads, and read-mostly RW locks (benchmark)
+TEST(LocksTest, ContentionBenchmark) {
+    constexpr int PER_THREAD = 20000;
+    for (int threads_count : {1, 2, 4, 8}) {
+        int per_thread = PER_THREAD / threads_count;
+        std::cout << threads_count << " threads (ns per lock+unlock): std::mutex "
+                  << contended_ns<std::mutex>(threads_count, per_thread) << ", AdaptiveMutex "
+                  << contended_ns<AdaptiveMutex>(threads_count, per_thread) << ", TicketLock "
+                  << contended_ns<TicketLock>(threads_count, per_thread) << ", McsLock "
+                  << contended_ns<McsLock>(threads_count, per_thread) << std::endl;
+    }
+
+    // 1 write per 64 operations
+    auto read_mostly = [](auto& lock, int threads_count) {
+        constexpr int OPS = 100000;
+        int64_t value = 0;
+        std::vector<std::thread> threads;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int t = 0; t < threads_count; ++t) {
+            threads.emplace_back([&]() {
+                int64_t sink = 0;
+                for (int i = 0; i < OPS / threads_count; ++i) {
+                    if (i % 64 == 0) {
+                        std::unique_lock guard(lock);
+                        ++value;
+                    } else {
+                        std::shared_lock guard(lock);
+                        sink += value;
+                    }
+                }
+                EXPECT_GE(sink, 0);
+            });
+        }
+        for (auto& t : threads) t.join();
+        auto end = std::chrono::high_resolution_clock::now();
+        return double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / OPS;
+    };
+    for (int threads_count : {1, 4, 8}) {
+        std::shared_mutex shared;
+        RwLock rw;
+        std::cout << threads_count << " threads read-mostly (ns per op): std::shared_mutex "
+                  << read_mostly(shared, threads_count) << ", RwLock " << read_mostly(rw, threads_count)
+                  << std::endl;
+    }
+}
+
+// Main function is provided by gtest_main
@@ -0,0 +1,211 @@
+#include "MessageEnvelope.h"
+#include "SPSCRingBuffer.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <variant>
+#include <cstring>
+
+namespace {
+
+struct Quote {
+    uint32_t instrument;
+    int64_t bid;
+    int64_t ask;
+};
+
+struct Trade {
+    uint32_t instrument;
+    int64_t price;
+    int32_t qty;
+};
+
+struct OrderAck {
+    uint64_t orderId;
+    uint8_t status;
+};
+
+struct Heartbeat {
+    uint64_t timestamp;
+};
+
+struct Snapshot {
+    uint32_t instrument;
+    int64_t levels[6];
+};
+
+using Envelope = MessageEnvelope<Quote, Trade, OrderAck, Heartbeat, Snapshot>;
+using HotFirst = DispatchOrder<Quote, Trade>;
+
+static_assert(sizeof(Envelope) == 64 && alignof(Envelope) == 64);
+static_assert(std::is_trivially_copyable_v<Envelope>);
+static_assert(Envelope::index_of<Quote>() == 0 && Envelope::index_of<Snapshot>() == 4);
+static_assert(Envelope::INLINE_CAPACITY == 56);
+static_assert(sizeof(BasicEnvelope<16, uint8_t, uint16_t>) == 16);
+
+// Sums a message-dependent value; overloads return the same type
+struct Summer {
+    int64_t operator()(const Quote& q) const { return q.bid + q.ask; }
+    int64_t operator()(const Trade& t) const { return t.price * t.qty; }
+    int64_t operator()(const OrderAck& a) const { return int64_t(a.orderId) + a.status; }
+    int64_t operator()(const Heartbeat&) const { return 1; }
+    int64_t operator()(const Snapshot& s) const { return s.levels[5]; }
+};
+
+Envelope make_message(uint64_t i) {
+    switch (i % 16) {
+        case 13: return Trade{uint32_t(i), int64_t(i), 2};
+        case 14: return OrderAck{i, 1};
+        case 15: {
+            Envelope envelope;
+            envelope.emplace<Snapshot>(Snapshot{uint32_t(i), {0, 0, 0, 0, 0, int64_t(i)}});
+            return envelope;
+        }
+        default: return Quote{uint32_t(i), int64_t(i), int64_t(i) + 1};
+    }
+}
+
+}  // namespace
+
+// Test 1: Construction, tags and checked access
+TEST(MessageEnvelopeTest, BasicOperations) {
+    Envelope empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.index(), Envelope::NONE);
+    EXPECT_EQ(empty.get_if<Quote>(), nullptr);
+
+    Envelope envelope = Trade{7, 1005, 3};
+    EXPECT_FALSE(envelope.empty());
+    EXPECT_TRUE(envelope.holds<Trade>());
+    EXPECT_FALSE(envelope.holds<Quote>());
+    EXPECT_EQ(envelope.get_if<Quote>(), nullptr);
+    ASSERT_NE(envelope.get_if<Trade>(), nullptr);
+    EXPECT_EQ(envelope.get_if<Trade>()->price, 1005);
+
+    envelope.emplace<Heartbeat>(Heartbeat{99});
+    EXPECT_EQ(envelope.index(), Envelope::index_of<Heartbeat>());
+    EXPECT_EQ(envelope.get<Heartbeat>()->timestamp, 99u);
+
+    // Copies are plain byte copies
+    Envelope copy;
+    std::memcpy(static_cast<void*>(&copy), &envelope, sizeof(Envelope));
+    EXPECT_EQ(copy.get_if<Heartbeat>()->timestamp, 99u);
+}
+
+// Test 2: Table dispatch reaches the right overload, mutable and const
+TEST(MessageEnvelopeTest, Visit) {
+    Envelope quote = Quote{1, 100, 101};
+    Envelope ack = OrderAck{40, 2};
+    EXPECT_EQ(quote.visit(Summer{}), 201);
+    EXPECT_EQ(ack.visit(Summer{}), 42);
+
+    // Mutating visitor with void result
+    quote.visit([](auto& message) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(message)>, Quote>) {
+            message.ask = 200;
+        }
+    });
+    EXPECT_EQ(quote.get<Quote>()->ask, 200);
+
+    const Envelope& view = quote;
+    EXPECT_EQ(view.visit(Summer{}), 300);
+}
+
+// Test 3: Frequency-ordered dispatch agrees with table dispatch for every alternative
+TEST(MessageEnvelopeTest, OrderedVisitMatchesTable) {
+    for (uint64_t i = 0; i < 64; ++i) {
+        Envelope envelope = make_message(i);
+        EXPECT_EQ(envelope.visit_ordered<HotFirst>(Summer{}), envelope.visit(Summer{})) << i;
+        const Envelope& view = envelope;
+        EXPECT_EQ(view.visit_ordered<DispatchOrder<Snapshot>>(Summer{}), envelope.visit(Summer{})) << i;
+    }
+    Envelope beat = Heartbeat{5};
+    EXPECT_EQ(beat.visit_ordered<HotFirst>(Summer{}), 1);   // not listed: falls back to the table
+}
+
+// Test 4: Visiting an empty envelope aborts instead of indexing past the table
+TEST(MessageEnvelopeDeathTest, VisitEmptyAborts) {
+    Envelope empty;
+    const Envelope& view = empty;
+    EXPECT_DEATH(empty.visit(Summer{}), "");
+    EXPECT_DEATH(view.visit(Summer{}), "");
+    EXPECT_DEATH(empty.visit_ordered<HotFirst>(Summer{}), "");
+}
+
+// Test 5: Mixed traffic through one SPSCRingBuffer
+TEST(MessageEnvelopeTest, MixedTrafficThroughRing) {
+    constexpr uint64_t NUM_MESSAGES = 100000;
+    auto ring = std::make_unique<SPSCRingBuffer<Envelope, 1024>>();
+
+    int64_t expected = 0;
+    for (uint64_t i = 0; i < NUM_MESSAGES; ++i) {
+        expected += make_message(i).visit(Summer{});
+    }
+
+    std::thread producer([&]() {
+        for (uint64_t i = 0; i < NUM_MESSAGES; ++i) {
+            while (!ring->push(make_message(i))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int64_t total = 0;
+    uint64_t received = 0;
+    uint64_t counts[5] = {};
+    while (received < NUM_MESSAGES) {
+        size_t n = ring->pop_batch([&](Envelope&& envelope) {
+            total += envelope.visit_ordered<HotFirst>(Summer{});
+            ++counts[envelope.index()];
+        }, 64);
+        received += n;
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_EQ(total, expected);
+    EXPECT_EQ(counts[Envelope::index_of<Quote>()], NUM_MESSAGES / 16 * 13);
+    EXPECT_EQ(counts[Envelope::index_of<Heartbeat>()], 0u);
+}
+
+// Test 6: Envelope dispatch versus std::variant + std::visit (benchmark)
+TEST(MessageEnvelopeTest, DispatchBenchmark) {
+    constexpr int ITERATIONS = 1000000;
+    using Variant = std::variant<Quote, Trade, OrderAck, Heartbeat, Snapshot>;
+
+    std::vector<Envelope> envelopes;
+    std::vector<Variant> variants;
+    for (uint64_t i = 0; i < 4096; ++i) {
+        envelopes.push_back(make_message(i));
+        envelopes.back().visit([&](const auto& message) { variants.emplace_back(message); });
+    }
+
+    auto measure = [&](auto&& body) {
+        int64_t sum = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            sum += body(i & 4095);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::make_pair(sum, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() * 1.0 / ITERATIONS);
+    };
+
+    auto [sum_variant, ns_variant] = measure([&](int i) { return std::visit(Summer{}, variants[i]); });
+    auto [sum_table, ns_table] = measure([&](int i) { return envelopes[i].visit(Summer{}); });
+    auto [sum_ordered, ns_ordered] = measure([&](int i) { return envelopes[i].visit_ordered<HotFirst>(Summer{}); });
+
+    EXPECT_EQ(sum_variant, sum_table);
+    EXPECT_EQ(sum_variant, sum_ordered);
+    std::cout << "Dispatch: std::visit " << ns_variant << " ns (sizeof " << sizeof(Variant)
+              << "), table " << ns_table << " ns, frequency-ordered " << ns_ordered
+              << " ns (sizeof " << sizeof(Envelope) << ")" << std::endl;
+}
+
+// Main function is provided by gtest_main
@@ -464,4 +464,51 @@ TEST(MPSCQueueTest, InterleavedProducers) {
     EXPECT_EQ(all_values, received_set);
 }
 
+// Test 15: Batched pop
+TEST(MPSCQueueTest, PopBatch) {
+    MPSCQueue<int> queue;
+    std::vector<int> out;
+    auto collect = [&](int&& v) { out.push_back(v); };
+
+    EXPECT_EQ(queue.pop_batch(collect, 4), 0);
+
+    for (int i = 0; i < 10; ++i) {
+        queue.push(i);
+    }
+
+    EXPECT_EQ(queue.pop_batch(collect, 4), 4);
+    EXPECT_EQ(queue.pop_batch(collect, 100), 6);
+    EXPECT_TRUE(queue.empty());
+
+    // Queue stays usable after a batch drained it
+    queue.push(10);
+    int value = -1;
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 10);
+
+    std::vector<int> expected(10);
+    for (int i = 0; i < 10; ++i) expected[i] = i;
+    EXPECT_EQ(out, expected);
+}
+
+// Test 16: Discard leading values
+TEST(MPSCQueueTest, DiscardFront) {
+    MPSCQueue<int> queue;
+
+    EXPECT_EQ(queue.discard_front([](const int&) { return true; }), 0);
+
+    for (int i = 0; i < 10; ++i) {
+        queue.push(i);
+    }
+
+    EXPECT_EQ(queue.discard_front([](const int& v) { return v < 4; }), 4);
+
+    int value = -1;
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 4);
+
+    EXPECT_EQ(queue.discard_front([](const int&) { return true; }), 5);
+    EXPECT_TRUE(queue.empty());
+}
+
 // Main function is provided by gtest_main
\ No newline at end of file
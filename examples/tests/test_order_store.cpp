@@ -0,0 +1,243 @@
+#include "OrderStore.h"
+#include "SPSCRingBuffer.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <unordered_map>
+
+namespace {
+
+Price px(int64_t units) { return Price::from_int(units); }
+Quantity qty(int64_t units) { return Quantity::from_int(units); }
+
+}  // namespace
+
+// Test 1: Full lifecycle updates the record in place
+TEST(OrderStoreTest, LifecycleInPlace) {
+    OrderArena arena(16);
+    OrderHandle h = arena.create(1001, 7, true, px(100), qty(10));
+    ASSERT_TRUE(h);
+    Order* order = arena.get(h);
+    ASSERT_NE(order, nullptr);
+    EXPECT_EQ(order->state, OrderState::PENDING_NEW);
+
+    EXPECT_EQ(arena.on_ack(h, 555), OrderUpdate::OK);
+    EXPECT_EQ(arena.on_fill(h, qty(4), px(100)), OrderUpdate::OK);
+    EXPECT_EQ(order->state, OrderState::PARTIALLY_FILLED);
+    EXPECT_EQ(arena.on_fill(h, qty(6), px(101)), OrderUpdate::OK);
+
+    EXPECT_EQ(arena.get(h), order);   // same slot throughout
+    EXPECT_EQ(order->state, OrderState::FILLED);
+    EXPECT_EQ(order->exchangeOrderId, 555u);
+    EXPECT_EQ(order->filled, qty(10));
+    EXPECT_EQ(order->filledNotional, px(100) * qty(4) + px(101) * qty(6));
+    EXPECT_EQ(order->leaves(), Quantity());
+}
+
+// Test 2: Invalid transitions and overfills are refused without side effects
+TEST(OrderStoreTest, TransitionRules) {
+    OrderArena arena(16);
+    OrderHandle h = arena.create(1, 0, false, px(50), qty(10));
+    EXPECT_EQ(arena.on_fill(h, qty(1), px(50)), OrderUpdate::INVALID_TRANSITION);   // not acked
+    EXPECT_EQ(arena.on_cancel_request(h), OrderUpdate::INVALID_TRANSITION);
+    ASSERT_EQ(arena.on_ack(h, 1), OrderUpdate::OK);
+    EXPECT_EQ(arena.on_ack(h, 1), OrderUpdate::INVALID_TRANSITION);
+    EXPECT_EQ(arena.on_fill(h, qty(11), px(50)), OrderUpdate::OVERFILL);
+    EXPECT_EQ(arena.get(h)->filled, Quantity());
+
+    // A partial fill racing the cancel keeps it pending; the cancel reject restores it
+    ASSERT_EQ(arena.on_cancel_request(h), OrderUpdate::OK);
+    EXPECT_EQ(arena.on_fill(h, qty(3), px(50)), OrderUpdate::OK);
+    EXPECT_EQ(arena.get(h)->state, OrderState::PENDING_CANCEL);
+    EXPECT_EQ(arena.on_cancel_reject(h), OrderUpdate::OK);
+    EXPECT_EQ(arena.get(h)->state, OrderState::PARTIALLY_FILLED);
+    EXPECT_EQ(arena.on_cancelled(h), OrderUpdate::OK);   // unsolicited
+    EXPECT_EQ(arena.get(h)->state, OrderState::CANCELLED);
+    EXPECT_EQ(arena.on_fill(h, qty(1), px(50)), OrderUpdate::INVALID_TRANSITION);
+    EXPECT_EQ(arena.get(h)->leaves(), Quantity());
+
+    OrderHandle r = arena.create(2, 0, true, px(50), qty(1));
+    EXPECT_EQ(arena.on_reject(r), OrderUpdate::OK);
+    EXPECT_EQ(arena.on_cancelled(r), OrderUpdate::INVALID_TRANSITION);
+}
+
+// Test 3: Released and pre-reset handles are detected as stale
+TEST(OrderStoreTest, StaleHandles) {
+    OrderArena arena(4);
+    OrderHandle first = arena.create(1, 0, true, px(1), qty(1));
+    ASSERT_TRUE(arena.release(first));
+    EXPECT_FALSE(arena.release(first));
+    EXPECT_EQ(arena.get(first), nullptr);
+
+    OrderHandle reused = arena.create(2, 0, true, px(1), qty(1));
+    EXPECT_NE(reused.index(), first.index());   // fresh slots before freed ones
+    EXPECT_EQ(arena.get(first), nullptr);
+    EXPECT_EQ(arena.on_ack(first, 9), OrderUpdate::STALE_HANDLE);
+    EXPECT_EQ(arena.get(reused)->clOrdId, 2u);
+
+    // Reset: every handle goes stale, including when its slot is handed out again
+    OrderHandle other = arena.create(3, 0, true, px(1), qty(1));
+    arena.reset();
+    EXPECT_EQ(arena.size(), 0u);
+    EXPECT_EQ(arena.get(reused), nullptr);
+    EXPECT_EQ(arena.get(other), nullptr);
+    OrderHandle next = arena.create(4, 0, true, px(1), qty(1));
+    EXPECT_EQ(next.index(), first.index());   // same slot, new generation
+    EXPECT_NE(next, first);
+    EXPECT_EQ(arena.get(first), nullptr);
+    EXPECT_EQ(arena.get(next)->clOrdId, 4u);
+
+    EXPECT_EQ(arena.get(OrderHandle()), nullptr);
+    EXPECT_EQ(OrderHandle::from_raw(next.raw()), next);
+}
+
+// Test 4: Create/release cycles do not wrap a released handle's generation
+TEST(OrderStoreTest, ReuseSpreadsAcrossSlots) {
+    OrderArena arena(65536);
+    OrderHandle late = arena.create(1, 0, true, px(1), qty(1));
+    ASSERT_TRUE(arena.release(late));
+
+    // A late exchange reply must not reach an unrelated order
+    for (uint32_t i = 0; i < 2 * OrderHandle::GENERATION_MASK + 2; ++i) {
+        OrderHandle h = arena.create(i + 2, 0, true, px(1), qty(1));
+        ASSERT_TRUE(h);
+        EXPECT_EQ(arena.on_ack(late, 9), OrderUpdate::STALE_HANDLE) << i;
+        ASSERT_TRUE(arena.release(h));
+    }
+
+    // Once every slot has been used, freed slots come back oldest first
+    OrderArena full(4);
+    std::vector<OrderHandle> handles;
+    for (int i = 0; i < 4; ++i) handles.push_back(full.create(uint64_t(i), 0, true, px(1), qty(1)));
+    for (int i : {2, 0, 3, 1}) full.release(handles[i]);
+    for (int i : {2, 0, 3, 1}) {
+        EXPECT_EQ(full.create(uint64_t(10 + i), 0, true, px(1), qty(1)).index(), handles[i].index());
+    }
+}
+
+// Test 5: Fixed capacity, free-list reuse and per-session arenas
+TEST(OrderStoreTest, CapacityAndSessions) {
+    OrderStore store(2, 3);
+    OrderArena& a = store.session(0);
+    OrderArena& b = store.session(1);
+
+    std::vector<OrderHandle> handles;
+    for (int i = 0; i < 3; ++i) handles.push_back(a.create(uint64_t(i), 0, true, px(1), qty(1)));
+    EXPECT_FALSE(a.create(99, 0, true, px(1), qty(1)));   // full
+    EXPECT_TRUE(b.create(99, 0, true, px(1), qty(1)));    // other session unaffected
+
+    a.release(handles[1]);
+    OrderHandle again = a.create(100, 0, true, px(1), qty(1));
+    EXPECT_EQ(again.index(), handles[1].index());
+    EXPECT_EQ(a.size(), 3u);
+    EXPECT_EQ(b.size(), 1u);
+
+    // Generations skip 0 on wrap so handles never become null
+    OrderArena single(1);
+    for (uint32_t i = 0; i < 2 * OrderHandle::GENERATION_MASK; ++i) {
+        OrderHandle h = single.create(i, 0, true, px(1), qty(1));
+        ASSERT_TRUE(h);
+        ASSERT_TRUE(single.release(h));
+    }
+}
+
+// Test 6: Handles cross threads through queues; the owner detects stale replies
+TEST(OrderStoreTest, HandlesThroughQueues) {
+    constexpr int ORDERS = 20000;
+    OrderArena arena(256);
+    auto toGateway = std::make_unique<SPSCRingBuffer<OrderHandle, 1024>>();
+    auto fromGateway = std::make_unique<SPSCRingBuffer<OrderHandle, 1024>>();
+    std::atomic<bool> stop{false};
+
+    // The gateway acks each order twice: the second reply arrives after release
+    std::thread gateway([&]() {
+        OrderHandle h;
+        while (!stop.load(std::memory_order_acquire)) {
+            if (toGateway->pop(h)) {
+                while (!fromGateway->push(h)) std::this_thread::yield();
+                while (!fromGateway->push(h)) std::this_thread::yield();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int sent = 0, acked = 0, stale = 0;
+    while (acked < ORDERS) {
+        if (sent < ORDERS && sent - acked < 128) {
+            OrderHandle h = arena.create(uint64_t(sent), 0, true, px(1), qty(1));
+            ASSERT_TRUE(h);
+            while (!toGateway->push(h)) std::this_thread::yield();
+            ++sent;
+        }
+        OrderHandle reply;
+        while (fromGateway->pop(reply)) {
+            OrderUpdate result = arena.on_ack(reply, reply.raw());
+            if (result == OrderUpdate::OK) {
+                ++acked;
+                arena.release(reply);
+            } else {
+                EXPECT_EQ(result, OrderUpdate::STALE_HANDLE);
+                ++stale;
+            }
+        }
+        std::this_thread::yield();
+    }
+    stop.store(true, std::memory_order_release);
+    gateway.join();
+
+    EXPECT_EQ(acked, ORDERS);
+    EXPECT_GE(stale, ORDERS - 2);   // duplicates of the last few may still be in flight
+    EXPECT_EQ(arena.size(), 0u);
+}
+
+// Test 7: Arena lifecycle versus new + unordered_map (benchmark)
+TEST(OrderStoreTest, LifecycleBenchmark) {
+    constexpr int ORDERS = 1000000;
+    constexpr int WORKING = 1000;   // orders open at once
+
+    auto arena = std::make_unique<OrderArena>(WORKING);
+    std::vector<OrderHandle> open(WORKING);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ORDERS; ++i) {
+        OrderHandle& slot = open[size_t(i % WORKING)];
+        if (slot) arena->release(slot);
+        slot = arena->create(uint64_t(i), 7, true, px(100), qty(10));
+        arena->on_ack(slot, uint64_t(i));
+        arena->on_fill(slot, qty(10), px(100));
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double ns_arena = double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / ORDERS;
+
+    std::unordered_map<uint64_t, Order*> map;
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ORDERS; ++i) {
+        if (i >= WORKING) {
+            auto it = map.find(uint64_t(i - WORKING));
+            delete it->second;
+            map.erase(it);
+        }
+        Order* order = new Order{};
+        order->clOrdId = uint64_t(i);
+        order->qty = qty(10);
+        map.emplace(order->clOrdId, order);
+        Order* found = map.find(uint64_t(i))->second;
+        found->state = OrderState::NEW;
+        found->filled += qty(10);
+        found->filledNotional += px(100) * qty(10);
+        found->state = OrderState::FILLED;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double ns_map = double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / ORDERS;
+    for (auto& [id, order] : map) delete order;
+
+    std::cout << "OrderArena create+ack+fill+release: " << ns_arena
+              << " ns/order, new + unordered_map: " << ns_map << " ns/order" << std::endl;
+}
+
+// Main function is provided by gtest_main
@@ -0,0 +1,149 @@
+#include "PerfectHash.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+// Compile-time universes: built by the compiler, no startup cost
+constexpr auto kSymbols = make_perfect_hash<std::string_view>(std::array<std::string_view, 12>{
+    "AAPL", "MSFT", "NVDA", "AMZN", "GOOGL", "META",
+    "TSLA", "BRK.B", "JPM", "V", "ESZ5", "NQZ5"});
+
+constexpr auto kInstrumentIds = make_perfect_hash<uint64_t>(std::array<uint64_t, 6>{
+    1001, 1002, 2040, 77777, 123456789, 0});
+
+static_assert(kSymbols.find(std::string_view("AAPL")) == 0);
+static_assert(kSymbols.find(std::string_view("NQZ5")) == 11);
+static_assert(kSymbols.find(std::string_view("IBM")) == kSymbols.NOT_FOUND);
+static_assert(kInstrumentIds.find(uint64_t(77777)) == 3);
+static_assert(kInstrumentIds.find(uint64_t(0)) == 5);
+
+std::string make_symbol(std::mt19937_64& rng) {
+    std::string symbol(3 + rng() % 6, 'A');
+    for (auto& c : symbol) c = char('A' + rng() % 26);
+    return symbol;
+}
+
+}  // namespace
+
+// Test 1: Every instrument id maps to its position, unknown ids are rejected
+TEST(PerfectHashTest, InstrumentIds) {
+    std::mt19937_64 rng(7);
+    std::unordered_set<uint64_t> unique;
+    std::vector<uint64_t> ids;
+    while (ids.size() < 100000) {
+        uint64_t id = rng() % 10000000;
+        if (unique.insert(id).second) ids.push_back(id);
+    }
+
+    PerfectHashIndex<uint64_t> index;
+    ASSERT_TRUE(index.build(ids));
+    EXPECT_EQ(index.size(), ids.size());
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+        ASSERT_EQ(index.find(ids[i]), i);
+    }
+    size_t false_hits = 0;
+    for (uint64_t id = 10000000; id < 10100000; ++id) {
+        false_hits += index.find(id) != index.NOT_FOUND;
+    }
+    EXPECT_EQ(false_hits, 0);
+}
+
+// Test 2: Symbols, looked up by string_view without allocating
+TEST(PerfectHashTest, Symbols) {
+    std::mt19937_64 rng(11);
+    std::unordered_set<std::string> unique;
+    std::vector<std::string> symbols;
+    while (symbols.size() < 20000) {
+        auto symbol = make_symbol(rng);
+        if (unique.insert(symbol).second) symbols.push_back(symbol);
+    }
+
+    PerfectHashIndex<std::string> index;
+    ASSERT_TRUE(index.build(symbols));
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        ASSERT_EQ(index.find(std::string_view(symbols[i])), i);
+    }
+    EXPECT_EQ(index.find(std::string_view("lowercase")), index.NOT_FOUND);
+    EXPECT_EQ(index.find(std::string_view("")), index.NOT_FOUND);
+    EXPECT_LT(index.memory_bytes(), symbols.size() * 64);
+}
+
+// Test 3: Duplicates and empty universes
+TEST(PerfectHashTest, EdgeCases) {
+    PerfectHashIndex<uint64_t> index;
+    EXPECT_EQ(index.find(uint64_t(1)), index.NOT_FOUND);  // never built
+
+    EXPECT_FALSE(index.build({1, 2, 3, 2}));
+    EXPECT_EQ(index.size(), 0);
+    EXPECT_EQ(index.find(uint64_t(1)), index.NOT_FOUND);
+
+    EXPECT_TRUE(index.build({}));
+    EXPECT_EQ(index.find(uint64_t(0)), index.NOT_FOUND);
+
+    EXPECT_TRUE(index.build({42}));
+    EXPECT_EQ(index.find(uint64_t(42)), 0);
+}
+
+// Test 4: The compile-time tables also answer at run time
+TEST(PerfectHashTest, ConstexprTables) {
+    std::string symbol = "ESZ5";
+    EXPECT_EQ(kSymbols.find(std::string_view(symbol)), 10);
+    EXPECT_EQ(kSymbols.find(std::string_view("ESH6")), kSymbols.NOT_FOUND);
+    EXPECT_EQ(kInstrumentIds.find(uint64_t(123456789)), 4);
+    EXPECT_EQ(kInstrumentIds.find(uint64_t(2041)), kInstrumentIds.NOT_FOUND);
+    EXPECT_EQ(kSymbols.size(), 12);
+}
+
+// Test 5: Symbol lookup versus std::unordered_map (benchmark)
+TEST(PerfectHashTest, LookupBenchmark) {
+    constexpr size_t NUM_SYMBOLS = 10000;
+    constexpr size_t LOOKUPS = 2000000;
+    std::mt19937_64 rng(3);
+    std::unordered_set<std::string> unique;
+    std::vector<std::string> symbols;
+    while (symbols.size() < NUM_SYMBOLS) {
+        auto symbol = make_symbol(rng);
+        if (unique.insert(symbol).second) symbols.push_back(symbol);
+    }
+
+    auto build_start = std::chrono::high_resolution_clock::now();
+    PerfectHashIndex<std::string> index;
+    ASSERT_TRUE(index.build(symbols));
+    auto build_end = std::chrono::high_resolution_clock::now();
+
+    std::unordered_map<std::string_view, size_t> map;
+    for (size_t i = 0; i < symbols.size(); ++i) map.emplace(symbols[i], i);
+
+    std::vector<std::string_view> probes(LOOKUPS);
+    for (auto& probe : probes) probe = symbols[rng() % NUM_SYMBOLS];
+
+    size_t sum_perfect = 0;
+    size_t sum_map = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (auto probe : probes) sum_perfect += index.find(probe);
+    auto mid = std::chrono::high_resolution_clock::now();
+    for (auto probe : probes) sum_map += map.find(probe)->second;
+    auto end = std::chrono::high_resolution_clock::now();
+
+    EXPECT_EQ(sum_perfect, sum_map);
+    std::cout << NUM_SYMBOLS << " symbols: build "
+              << std::chrono::duration_cast<std::chrono::microseconds>(build_end - build_start).count()
+              << " us, perfect hash "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(mid - start).count() * 1.0 / LOOKUPS
+              << " ns/lookup, std::unordered_map "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(end - mid).count() * 1.0 / LOOKUPS
+              << " ns/lookup" << std::endl;
+}
+
+// Main function is provided by gtest_main
@@ -0,0 +1,220 @@
+#include "Published.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+
+namespace {
+
+std::atomic<int> live_limits{0};
+
+// Risk limits: every field of one version derives from the same value
+struct RiskLimits {
+    static constexpr uint64_t ALIVE = 0xA11CEA11CEull;
+    uint64_t alive = ALIVE;
+    int64_t maxQty = 0;
+    int64_t maxNotional = 0;
+    std::vector<int64_t> perSymbol = std::vector<int64_t>(16, 0);
+
+    explicit RiskLimits(int64_t v = 0) : maxQty(v), maxNotional(v * 100) {
+        for (auto& limit : perSymbol) limit = v;
+        live_limits.fetch_add(1);
+    }
+    RiskLimits(const RiskLimits& other)
+        : maxQty(other.maxQty), maxNotional(other.maxNotional), perSymbol(other.perSymbol) {
+        live_limits.fetch_add(1);
+    }
+    ~RiskLimits() {
+        alive = 0;
+        live_limits.fetch_sub(1);
+    }
+
+    bool consistent() const {
+        bool ok = alive == ALIVE && maxNotional == maxQty * 100;
+        for (auto limit : perSymbol) ok &= limit == maxQty;
+        return ok;
+    }
+};
+
+}  // namespace
+
+// Test 1: Readers see the initial version, then each published one
+TEST(PublishedTest, BasicOperations) {
+    QsbrDomain domain;
+    Published<RiskLimits> limits(domain, std::make_unique<RiskLimits>(10));
+
+    EXPECT_EQ(limits.read()->maxQty, 10);
+    limits.publish(std::make_unique<RiskLimits>(20));
+    EXPECT_EQ(limits.read()->maxQty, 20);
+
+    limits.update([](RiskLimits& next) {
+        next.maxQty = 30;
+        next.maxNotional = 3000;
+        for (auto& limit : next.perSymbol) limit = 30;
+    });
+    EXPECT_EQ(limits.read()->maxQty, 30);
+    EXPECT_TRUE(limits.read()->consistent());
+
+    // No readers registered: replaced versions are freed immediately
+    EXPECT_EQ(domain.pending(), 0);
+}
+
+// Test 2: A replaced version survives until the reader passes a quiescent state
+TEST(PublishedTest, GracePeriod) {
+    live_limits.store(0);
+    {
+        QsbrDomain domain;
+        Published<RiskLimits> limits(domain, std::make_unique<RiskLimits>(1));
+        QsbrDomain::Reader reader(domain);
+        ASSERT_TRUE(reader.is_registered());
+        EXPECT_EQ(domain.readers(), 1);
+
+        const RiskLimits* held = limits.read();
+        limits.publish(std::make_unique<RiskLimits>(2));
+        EXPECT_EQ(domain.pending(), 1);
+        EXPECT_EQ(live_limits.load(), 2);
+        EXPECT_TRUE(held->consistent());  // still safe to use
+        EXPECT_EQ(held->maxQty, 1);
+
+        reader.quiescent();
+        EXPECT_EQ(domain.reclaim(), 1);
+        EXPECT_EQ(live_limits.load(), 1);
+        EXPECT_EQ(limits.read()->maxQty, 2);
+
+        // An offline reader does not hold anything up
+        reader.offline();
+        limits.publish(std::make_unique<RiskLimits>(3));
+        EXPECT_EQ(domain.pending(), 0);
+        reader.online();
+        EXPECT_EQ(limits.read()->maxQty, 3);
+    }
+    EXPECT_EQ(live_limits.load(), 0);
+}
+
+// Test 3: synchronize() returns once every online reader has been quiescent
+TEST(PublishedTest, SynchronizeWaitsForReaders) {
+    QsbrDomain domain;
+    std::atomic<bool> registered{false};
+    std::atomic<bool> go{false};
+    std::atomic<bool> quiesced{false};
+
+    std::thread reader_thread([&]() {
+        QsbrDomain::Reader reader(domain);
+        registered.store(true);
+        while (!go.load()) {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        quiesced.store(true);
+        reader.quiescent();
+    });
+    while (!registered.load()) {
+        std::this_thread::yield();
+    }
+
+    go.store(true);
+    domain.synchronize();
+    EXPECT_TRUE(quiesced.load());
+    reader_thread.join();
+    EXPECT_EQ(domain.readers(), 0);
+}
+
+// Test 4: Concurrent readers never observe a torn or freed version
+TEST(PublishedTest, ConcurrentReadersAndWriters) {
+    live_limits.store(0);
+    {
+        QsbrDomain domain;
+        Published<RiskLimits> limits(domain, std::make_unique<RiskLimits>(0));
+        constexpr int NUM_READERS = 3;
+        constexpr int NUM_WRITERS = 2;
+        constexpr int UPDATES_PER_WRITER = 2000;
+        std::atomic<bool> done{false};
+        std::atomic<bool> ok{true};
+
+        std::vector<std::thread> readers;
+        for (int r = 0; r < NUM_READERS; ++r) {
+            readers.emplace_back([&]() {
+                QsbrDomain::Reader reader(domain);
+                int64_t last = 0;
+                while (!done.load(std::memory_order_relaxed)) {
+                    for (int i = 0; i < 16; ++i) {
+                        const RiskLimits* current = limits.read();
+                        if (!current->consistent() || current->maxQty < last) {
+                            ok.store(false);
+                        }
+                        last = current->maxQty;
+                    }
+                    reader.quiescent();
+                    std::this_thread::yield();
+                }
+            });
+        }
+
+        std::vector<std::thread> writers;
+        for (int w = 0; w < NUM_WRITERS; ++w) {
+            writers.emplace_back([&]() {
+                for (int i = 0; i < UPDATES_PER_WRITER; ++i) {
+                    limits.update([](RiskLimits& next) {
+                        ++next.maxQty;
+                        next.maxNotional = next.maxQty * 100;
+                        for (auto& limit : next.perSymbol) limit = next.maxQty;
+                    });
+                    if (i % 16 == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        for (auto& t : writers) t.join();
+        done.store(true);
+        for (auto& t : readers) t.join();
+
+        EXPECT_TRUE(ok.load());
+        EXPECT_EQ(limits.read()->maxQty, NUM_WRITERS * UPDATES_PER_WRITER);  // no lost update
+        domain.synchronize();
+        EXPECT_EQ(domain.pending(), 0);
+        EXPECT_EQ(live_limits.load(), 1);
+    }
+    EXPECT_EQ(live_limits.load(), 0);
+}
+
+// Test 5: Read path cost versus a mutex-guarded pointer (benchmark)
+TEST(PublishedTest, ReadBenchmark) {
+    QsbrDomain domain;
+    Published<RiskLimits> limits(domain, std::make_unique<RiskLimits>(7));
+    QsbrDomain::Reader reader(domain);
+    constexpr int ITERATIONS = 10000000;
+
+    std::mutex mutex;
+    auto guarded = std::make_shared<RiskLimits>(7);
+
+    int64_t sum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        sum += limits.read()->maxQty;
+        if ((i & 1023) == 0) {
+            reader.quiescent();
+        }
+    }
+    auto mid = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        std::lock_guard<std::mutex> lock(mutex);
+        sum += guarded->maxQty;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    EXPECT_EQ(sum, 2 * 7 * int64_t(ITERATIONS));
+    std::cout << "Reference data read: Published "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(mid - start).count() * 1.0 / ITERATIONS
+              << " ns, mutex "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(end - mid).count() * 1.0 / ITERATIONS
+              << " ns" << std::endl;
+}
+
+// Main function is provided by gtest_main
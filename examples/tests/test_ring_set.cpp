@@ -0,0 +1,247 @@
+#include "RingSet.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <iostream>
+
+// Test 1: Only rings that were pushed to are visited
+TEST(RingSetTest, VisitsOnlyActiveRings) {
+    auto set = std::make_unique<RingSet<int, 16, 64>>();
+
+    EXPECT_FALSE(set->any());
+    EXPECT_EQ(set->poll([](size_t, int&&) { FAIL() << "no ring should be visited"; }), 0);
+
+    EXPECT_TRUE(set->push(5, 50));
+    EXPECT_TRUE(set->push(63, 630));
+    EXPECT_TRUE(set->push(5, 51));
+    EXPECT_TRUE(set->any());
+    EXPECT_EQ(set->active_rings(), 2);
+
+    std::vector<std::pair<size_t, int>> seen;
+    EXPECT_EQ(set->poll([&](size_t ring, int&& v) { seen.emplace_back(ring, v); }), 3);
+
+    std::vector<std::pair<size_t, int>> expected{{5, 50}, {5, 51}, {63, 630}};
+    EXPECT_EQ(seen, expected);
+    EXPECT_TRUE(set->quiesce());
+}
+
+// Test 2: A ring that is not fully drained keeps its doorbell
+TEST(RingSetTest, LeftoverKeepsDoorbell) {
+    auto set = std::make_unique<RingSet<int, 16, 4, 4>>();
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(set->push(2, i));
+    }
+
+    std::vector<int> seen;
+    auto collect = [&](size_t, int&& v) { seen.push_back(v); };
+
+    EXPECT_EQ(set->poll(collect, 4), 4);
+    EXPECT_EQ(set->active_rings(), 1);
+    EXPECT_EQ(set->poll(collect, 4), 4);
+    EXPECT_EQ(set->poll(collect, 4), 2);
+    EXPECT_TRUE(set->quiesce());
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(seen[i], i);
+    }
+}
+
+// Test 3: Full ring rejects pushes without ringing twice
+TEST(RingSetTest, FullRing) {
+    auto set = std::make_unique<RingSet<int, 4, 8>>();
+
+    EXPECT_TRUE(set->push(0, 1));
+    EXPECT_TRUE(set->push(0, 2));
+    EXPECT_TRUE(set->push(0, 3));
+    EXPECT_FALSE(set->push(0, 4));
+    EXPECT_EQ(set->active_rings(), 1);
+
+    EXPECT_EQ(set->poll([](size_t, int&&) {}), 3);
+    EXPECT_TRUE(set->push(0, 4));
+}
+
+// Test 4: Doorbells stay set while drained and are cleared after a run of empty polls
+TEST(RingSetTest, QuiesceAfterIdlePolls) {
+    auto set = std::make_unique<RingSet<int, 16, 16, 8>>(4);
+    auto ignore = [](size_t, int&&) {};
+
+    EXPECT_TRUE(set->push(3, 1));
+    EXPECT_TRUE(set->push(12, 2));
+    EXPECT_EQ(set->poll(ignore), 2);
+    EXPECT_EQ(set->active_rings(), 2);   // busy rings keep their doorbell
+
+    // A push to a flagged ring needs no new doorbell and is still seen
+    EXPECT_TRUE(set->push(3, 3));
+    EXPECT_EQ(set->poll(ignore), 1);
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(set->poll(ignore), 0);
+        EXPECT_EQ(set->active_rings(), 2);
+    }
+    EXPECT_EQ(set->poll(ignore), 0);   // fourth empty poll quiesces
+    EXPECT_FALSE(set->any());
+
+    // quiesce() keeps the doorbell of a ring that is not empty
+    EXPECT_TRUE(set->push(5, 4));
+    EXPECT_FALSE(set->quiesce());
+    EXPECT_EQ(set->active_rings(), 1);
+    EXPECT_EQ(set->poll(ignore), 1);
+    EXPECT_TRUE(set->quiesce());
+}
+
+// Test 5: Concurrent producers, per-ring order preserved and no lost wakeups
+TEST(RingSetTest, ConcurrentNoLostWakeups) {
+    constexpr size_t NUM_RINGS = 64;
+    constexpr int NUM_PRODUCERS = 4;
+    constexpr int ITEMS_PER_RING = 2000;
+    auto set = std::make_unique<RingSet<int, 64, NUM_RINGS>>();
+
+    // Each producer owns NUM_RINGS / NUM_PRODUCERS rings
+    std::vector<std::thread> producers;
+    for (int p = 0; p < NUM_PRODUCERS; ++p) {
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < ITEMS_PER_RING; ++i) {
+                for (size_t r = p; r < NUM_RINGS; r += NUM_PRODUCERS) {
+                    while (!set->push(r, i)) {
+                        std::this_thread::yield();
+                    }
+                }
+                // Bursty traffic makes rings flip between idle and active
+                if (i % 64 == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<int> next(NUM_RINGS, 0);
+    bool ordered = true;
+    size_t total = 0;
+    const size_t expected_total = NUM_RINGS * ITEMS_PER_RING;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+
+    while (total < expected_total && std::chrono::steady_clock::now() < deadline) {
+        size_t n = set->poll([&](size_t ring, int&& v) {
+            ordered &= (v == next[ring]);
+            ++next[ring];
+        });
+        total += n;
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& t : producers) t.join();
+
+    EXPECT_EQ(total, expected_total);
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(set->quiesce());
+}
+
+// Test 6: Producers wait for every burst to be consumed, so a stranded item
+// (tail store not seen by the quiesce re-check, doorbell not re-rung) stalls its ring
+TEST(RingSetTest, PingPongNoLostWakeups) {
+    constexpr size_t NUM_RINGS = 16;
+    constexpr int NUM_PRODUCERS = 4;
+    constexpr int BURSTS_PER_RING = 5000;
+    auto set = std::make_unique<RingSet<int, 8, NUM_RINGS, 4>>(1);   // quiesce on every empty poll
+    std::cout << "membarrier in use: " << set->uses_membarrier() << std::endl;
+
+    std::vector<std::atomic<int>> consumed(NUM_RINGS);
+    std::atomic<bool> stalled{false};
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < NUM_PRODUCERS; ++p) {
+        producers.emplace_back([&, p]() {
+            std::vector<int> sent(NUM_RINGS, 0);
+            for (int i = 0; i < BURSTS_PER_RING && !stalled.load(); ++i) {
+                // Bursts of 1-3 items: the later pushes land on a non-empty
+                // ring whose doorbell the consumer may be clearing right now
+                for (size_t r = p; r < NUM_RINGS; r += NUM_PRODUCERS) {
+                    for (int k = 0; k <= i % 3; ++k) {
+                        while (!set->push(r, sent[r])) {
+                            std::this_thread::yield();
+                        }
+                        ++sent[r];
+                    }
+                }
+                for (size_t r = p; r < NUM_RINGS; r += NUM_PRODUCERS) {
+                    while (consumed[r].load(std::memory_order_acquire) != sent[r]) {
+                        if (std::chrono::steady_clock::now() > deadline) {
+                            stalled.store(true);
+                            return;
+                        }
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        });
+    }
+
+    std::atomic<int> done{0};
+    std::thread consumer([&]() {
+        std::vector<int> next(NUM_RINGS, 0);
+        while (done.load() < NUM_PRODUCERS && !stalled.load()) {
+            size_t n = set->poll([&](size_t ring, int&& v) {
+                if (v != next[ring]) {
+                    stalled.store(true);
+                }
+                ++next[ring];
+                consumed[ring].store(next[ring], std::memory_order_release);
+            });
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (auto& t : producers) {
+        t.join();
+        done.fetch_add(1);
+    }
+    consumer.join();
+
+    EXPECT_FALSE(stalled.load());
+    EXPECT_TRUE(set->quiesce());
+}
+
+// Test 7: Idle polling cost (benchmark), doorbell poll vs scanning every ring
+TEST(RingSetTest, IdlePollBenchmark) {
+    constexpr size_t NUM_RINGS = 64;
+    constexpr int ITERATIONS = 100000;
+    auto set = std::make_unique<RingSet<int, 64, NUM_RINGS>>();
+    auto rings = std::make_unique<std::array<SPSCRingBuffer<int, 64>, NUM_RINGS>>();
+
+    // One active ring out of 64
+    size_t sink = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        set->push(17, i);
+        sink += set->poll([&](size_t, int&& v) { sink += v; });
+    }
+    auto mid = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        (*rings)[17].push(i);
+        for (auto& ring : *rings) {
+            int v;
+            while (ring.pop(v)) {
+                sink += v + 1;
+            }
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto doorbell_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(mid - start).count();
+    auto scan_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - mid).count();
+
+    EXPECT_GT(sink, 0);
+    std::cout << "1 of " << NUM_RINGS << " rings active: doorbell poll "
+              << doorbell_ns / ITERATIONS << " ns/iter, full scan "
+              << scan_ns / ITERATIONS << " ns/iter" << std::endl;
+}
+
+// Main function is provided by gtest_main
@@ -0,0 +1,240 @@
+#include "RiskEngine.h"
+#include "Tsc.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+std::unique_ptr<RiskEngine> make_engine(size_t instruments, size_t accounts) {
+    auto engine = std::make_unique<RiskEngine>(instruments, accounts);
+    for (uint32_t i = 0; i < instruments; ++i) {
+        engine->set_instrument_limits(i, InstrumentLimits{100, 500, 900, 1100});
+    }
+    for (uint32_t a = 0; a < accounts; ++a) {
+        engine->set_account_limits(a, AccountLimits{100 * 1100, 1'000'000});
+    }
+    return engine;
+}
+
+RiskOrder order(uint32_t account, uint32_t instrument, bool buy, int64_t qty, int64_t price = 1000) {
+    static uint64_t nextId = 1;
+    return RiskOrder{nextId++, account, instrument, price, qty, buy};
+}
+
+}  // namespace
+
+// Test 1: Static limits reject before any accounting
+TEST(RiskEngineTest, StaticLimits) {
+    auto engine = make_engine(4, 2);
+    EXPECT_EQ(engine->check(order(0, 4, true, 10)), RiskResult::UNKNOWN_INSTRUMENT);
+    EXPECT_EQ(engine->check(order(2, 0, true, 10)), RiskResult::UNKNOWN_ACCOUNT);
+    EXPECT_EQ(engine->check(order(0, 0, true, 101)), RiskResult::ORDER_QTY);
+    EXPECT_EQ(engine->check(order(0, 0, true, 0)), RiskResult::ORDER_QTY);
+    EXPECT_EQ(engine->check(order(0, 0, true, 10, 899)), RiskResult::PRICE_BAND);
+    EXPECT_EQ(engine->check(order(0, 0, false, 10, 1101)), RiskResult::PRICE_BAND);
+    EXPECT_EQ(engine->working_notional(0), 0);
+
+    engine->set_account_limits(1, AccountLimits{50'000, 1'000'000});
+    EXPECT_EQ(engine->check(order(1, 0, true, 51)), RiskResult::ORDER_NOTIONAL);
+    EXPECT_EQ(engine->check(order(1, 0, true, 50)), RiskResult::ACCEPTED);
+    EXPECT_EQ(engine->working_notional(1), 50'000);
+}
+
+// Test 2: Position limit counts working orders at their worst case
+TEST(RiskEngineTest, WorstCasePosition) {
+    auto engine = make_engine(1, 1);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(engine->check(order(0, 0, true, 100)), RiskResult::ACCEPTED);
+    }
+    EXPECT_EQ(engine->check(order(0, 0, true, 1)), RiskResult::POSITION);   // 500 working
+    EXPECT_EQ(engine->check(order(0, 0, false, 100)), RiskResult::ACCEPTED);   // sells are independent
+
+    // 200 fill, 100 cancelled: position 200, 200 still working on the buy side
+    engine->apply(RiskExecution{0, 0, 1000, 200, 100, true});
+    EXPECT_EQ(engine->position(0), 200);
+    EXPECT_EQ(engine->check(order(0, 0, true, 100)), RiskResult::ACCEPTED);
+    EXPECT_EQ(engine->check(order(0, 0, true, 1)), RiskResult::POSITION);
+
+    // The sell fills: position 100, worst-case long 100 + 300 working
+    engine->apply(RiskExecution{0, 0, 1000, 100, 0, false});
+    EXPECT_EQ(engine->position(0), 100);
+    EXPECT_EQ(engine->check(order(0, 0, true, 100)), RiskResult::ACCEPTED);
+    EXPECT_EQ(engine->check(order(0, 0, true, 1)), RiskResult::POSITION);
+
+    // Short side: -500 limit against position 100
+    for (int i = 0; i < 6; ++i) {
+        ASSERT_EQ(engine->check(order(0, 0, false, 100)), RiskResult::ACCEPTED);
+    }
+    EXPECT_EQ(engine->check(order(0, 0, false, 1)), RiskResult::POSITION);
+}
+
+// Test 3: Account working notional and the kill switch
+TEST(RiskEngineTest, AccountExposureAndHalt) {
+    auto engine = make_engine(8, 1);
+    for (uint32_t i = 0; i < 8; ++i) {
+        ASSERT_EQ(engine->check(order(0, i, true, 100)), RiskResult::ACCEPTED);   // 100'000 each
+    }
+    engine->set_account_limits(0, AccountLimits{110'000, 850'000});
+    EXPECT_EQ(engine->check(order(0, 0, false, 50)), RiskResult::ACCEPTED);   // 850'000
+    EXPECT_EQ(engine->check(order(0, 1, false, 1)), RiskResult::ACCOUNT_EXPOSURE);
+
+    engine->apply(RiskExecution{0, 3, 1000, 60, 40, true});   // releases 100'000
+    EXPECT_EQ(engine->working_notional(0), 750'000);
+    EXPECT_EQ(engine->check(order(0, 1, false, 100)), RiskResult::ACCEPTED);
+
+    std::thread([&]() { engine->halt(0); }).join();
+    EXPECT_EQ(engine->check(order(0, 2, false, 1)), RiskResult::HALTED);
+    engine->halt(0, false);
+    engine->apply(RiskExecution{0, 2, 1000, 0, 1, true});
+    EXPECT_EQ(engine->check(order(0, 2, false, 1)), RiskResult::ACCEPTED);
+}
+
+// Test 4: Checker and execution thread run concurrently; limits hold throughout
+TEST(RiskEngineTest, ConcurrentFillsNeverBreachLimit) {
+    constexpr uint32_t INSTRUMENTS = 4;
+    constexpr int ORDERS = 20000;
+    auto engine = make_engine(INSTRUMENTS, 1);
+    engine->set_account_limits(0, AccountLimits{INT64_MAX, INT64_MAX});
+
+    // Accepted orders go to the "exchange" (the execution thread), which fills them all
+    MPSCQueue<RiskOrder> toExchange;
+    std::atomic<bool> done{false};
+    int64_t expectedPosition[INSTRUMENTS] = {};
+    std::atomic<int64_t> maxSeen{0};
+
+    std::thread exchange([&]() {
+        RiskOrder accepted;
+        auto fill = [&]() {
+            // Two partial fills per order
+            int64_t half = accepted.qty / 2;
+            engine->apply(RiskExecution{0, accepted.instrument, accepted.price, half, 0, accepted.buy});
+            engine->apply(RiskExecution{0, accepted.instrument, accepted.price, accepted.qty - half, 0, accepted.buy});
+            int64_t p = std::abs(engine->position(accepted.instrument));
+            if (p > maxSeen.load(std::memory_order_relaxed)) maxSeen.store(p, std::memory_order_relaxed);
+        };
+        while (!done.load(std::memory_order_acquire)) {
+            if (toExchange.pop(accepted)) {
+                fill();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        while (toExchange.pop(accepted)) fill();
+    });
+
+    std::mt19937 rng(7);
+    int accepted = 0;
+    for (int i = 0; i < ORDERS; ++i) {
+        RiskOrder o = order(0, rng() % INSTRUMENTS, rng() % 3 != 0, 1 + rng() % 100);
+        if (engine->check(o) == RiskResult::ACCEPTED) {
+            expectedPosition[o.instrument] += o.buy ? o.qty : -o.qty;
+            toExchange.push(o);
+            ++accepted;
+        }
+        if (i % 64 == 0) std::this_thread::yield();
+    }
+    done.store(true, std::memory_order_release);
+    exchange.join();
+
+    EXPECT_GT(accepted, ORDERS / 10);
+    EXPECT_LE(maxSeen.load(), 500);
+    for (uint32_t i = 0; i < INSTRUMENTS; ++i) {
+        EXPECT_EQ(engine->position(i), expectedPosition[i]);
+        EXPECT_LE(std::abs(expectedPosition[i]), 500);
+    }
+    EXPECT_EQ(engine->working_notional(0), 0);
+}
+
+// Test 5: check_batch drains queue runs from several strategy threads
+TEST(RiskEngineTest, BatchFromQueue) {
+    constexpr int PRODUCERS = 3;
+    constexpr int PER_PRODUCER = 3000;
+    auto engine = make_engine(16, PRODUCERS);
+    for (uint32_t a = 0; a < PRODUCERS; ++a) {
+        engine->set_account_limits(a, AccountLimits{INT64_MAX, INT64_MAX});
+    }
+    for (uint32_t i = 0; i < 16; ++i) {
+        engine->set_instrument_limits(i, InstrumentLimits{100, PRODUCERS * PER_PRODUCER, 900, 1100});
+    }
+
+    MPSCQueue<RiskOrder> queue;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                // every 10th order breaks the price band
+                queue.push(RiskOrder{uint64_t(i), uint32_t(p), uint32_t(i % 16), i % 10 ? 1000 : 1200, 1, i % 2 == 0});
+            }
+        });
+    }
+
+    int checked = 0, accepted = 0, banded = 0;
+    while (checked < PRODUCERS * PER_PRODUCER) {
+        size_t n = engine->check_batch(queue, [&](const RiskOrder&, RiskResult result) {
+            accepted += result == RiskResult::ACCEPTED;
+            banded += result == RiskResult::PRICE_BAND;
+        }, 256);
+        checked += int(n);
+        if (n == 0) std::this_thread::yield();
+    }
+    for (auto& t : producers) t.join();
+
+    EXPECT_EQ(banded, PRODUCERS * PER_PRODUCER / 10);
+    EXPECT_EQ(accepted + banded, checked);
+}
+
+// Test 6: Checks per second and added latency per order (benchmark)
+TEST(RiskEngineTest, ThroughputBenchmark) {
+    constexpr uint32_t INSTRUMENTS = 4096;
+    constexpr uint32_t ACCOUNTS = 64;
+    constexpr int ORDERS = 1 << 20;
+    auto engine = make_engine(INSTRUMENTS, ACCOUNTS);
+    for (uint32_t a = 0; a < ACCOUNTS; ++a) {
+        engine->set_account_limits(a, AccountLimits{INT64_MAX, INT64_MAX});
+    }
+    for (uint32_t i = 0; i < INSTRUMENTS; ++i) {
+        engine->set_instrument_limits(i, InstrumentLimits{100, INT64_MAX / 4, 900, 1100});
+    }
+
+    std::mt19937 rng(11);
+    std::vector<RiskOrder> orders;
+    orders.reserve(ORDERS);
+    for (int i = 0; i < ORDERS; ++i) {
+        orders.push_back(order(rng() % ACCOUNTS, rng() % INSTRUMENTS, rng() & 1, 1 + rng() % 100, 950 + rng() % 100));
+    }
+
+    // Throughput: straight loop over pre-built orders
+    auto start = std::chrono::high_resolution_clock::now();
+    int accepted = 0;
+    for (const RiskOrder& o : orders) {
+        accepted += engine->check(o) == RiskResult::ACCEPTED;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    EXPECT_EQ(accepted, ORDERS);
+
+    // Latency: TSC around each check
+    constexpr int SAMPLES = 100000;
+    std::vector<uint64_t> ticks(SAMPLES);
+    for (int i = 0; i < SAMPLES; ++i) {
+        uint64_t t0 = Tsc::now();
+        engine->check(orders[size_t(i)]);
+        ticks[size_t(i)] = Tsc::now() - t0;
+    }
+    std::sort(ticks.begin(), ticks.end());
+
+    std::cout << "RiskEngine::check: " << ORDERS / (ns / 1e9) / 1e6 << " million checks/sec, added latency p50 "
+              << Tsc::to_ns(ticks[SAMPLES / 2]) << " ns, p99 " << Tsc::to_ns(ticks[SAMPLES * 99 / 100])
+              << " ns (includes TSC read overhead)" << std::endl;
+}
+
+// Main function is provided by gtest_main
@@ -0,0 +1,116 @@
+#include "ShardedCounter.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <map>
+
+// Test 1: Single-thread counting and gauges
+TEST(ShardedCounterTest, BasicOperations) {
+    ShardedCounter counter;
+    EXPECT_EQ(counter.value(), 0u);
+    counter.increment();
+    counter.add(41);
+    EXPECT_EQ(counter.value(), 42u);
+
+    ShardedGauge gauge;
+    gauge.add(10);
+    gauge.sub(15);
+    EXPECT_EQ(gauge.value(), -5);
+}
+
+// Test 2: Concurrent increments from more threads than exclusive slots are exact
+TEST(ShardedCounterTest, ConcurrentExact) {
+    constexpr int NUM_THREADS = 80;   // more than THREAD_SLOTS: some use shared slots
+    constexpr int PER_THREAD = 5000;
+    auto counter = std::make_unique<ShardedCounter>();
+    auto gauge = std::make_unique<ShardedGauge>();
+
+    std::atomic<int> ready{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            ready.fetch_add(1);
+            while (ready.load() < NUM_THREADS) std::this_thread::yield();   // all alive at once
+            for (int i = 0; i < PER_THREAD; ++i) {
+                counter->increment();
+                gauge->add(t % 2 ? 1 : -1);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    EXPECT_EQ(counter->value(), uint64_t(NUM_THREADS) * PER_THREAD);
+    EXPECT_EQ(gauge->value(), 0);
+}
+
+// Test 3: Counts survive thread exit and slot reuse
+TEST(ShardedCounterTest, SlotReuseKeepsTotals) {
+    ShardedCounter counter;
+    for (int round = 0; round < 200; ++round) {
+        std::thread([&]() {
+            for (int i = 0; i < 100; ++i) counter.increment();
+        }).join();
+    }
+    EXPECT_EQ(counter.value(), 20000u);
+}
+
+// Test 4: The registry enumerates live metrics for export
+TEST(ShardedCounterTest, RegistryExport) {
+    CounterRegistry registry;
+    ShardedCounter fills(registry, "fills");
+    ShardedGauge open_orders(registry, "open_orders");
+    {
+        ShardedCounter rejects(registry, "rejects");
+        rejects.add(3);
+        EXPECT_EQ(registry.size(), 3u);
+    }
+    EXPECT_EQ(registry.size(), 2u);   // unregistered on destruction
+
+    fills.add(7);
+    open_orders.add(2);
+    std::thread([&]() { open_orders.sub(1); }).join();
+
+    std::map<std::string, std::pair<MetricKind, int64_t>> exported;
+    registry.for_each([&](std::string_view name, MetricKind kind, int64_t value) {
+        exported[std::string(name)] = {kind, value};
+    });
+    ASSERT_EQ(exported.size(), 2u);
+    EXPECT_EQ(exported["fills"], std::make_pair(MetricKind::COUNTER, int64_t(7)));
+    EXPECT_EQ(exported["open_orders"], std::make_pair(MetricKind::GAUGE, int64_t(1)));
+}
+
+// Test 5: Sharded counter versus one shared std::atomic (benchmark)
+TEST(ShardedCounterTest, ContentionBenchmark) {
+    constexpr int PER_THREAD = 1000000;
+    for (int threads_count : {1, 4, 8}) {
+        auto run = [&](auto&& op) {
+            std::vector<std::thread> threads;
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int t = 0; t < threads_count; ++t) {
+                threads.emplace_back([&]() {
+                    for (int i = 0; i < PER_THREAD; ++i) op();
+                });
+            }
+            for (auto& t : threads) t.join();
+            auto end = std::chrono::high_resolution_clock::now();
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() * 1.0 /
+                   (double(threads_count) * PER_THREAD);
+        };
+
+        ShardedCounter sharded;
+        std::atomic<uint64_t> shared{0};
+        double ns_sharded = run([&]() { sharded.increment(); });
+        double ns_shared = run([&]() { shared.fetch_add(1, std::memory_order_relaxed); });
+
+        EXPECT_EQ(sharded.value(), shared.load());
+        std::cout << threads_count << " threads: ShardedCounter " << ns_sharded
+                  << " ns/increment, std::atomic fetch_add " << ns_shared << " ns/increment" << std::endl;
+    }
+}
+
+// Main function is provided by gtest_main
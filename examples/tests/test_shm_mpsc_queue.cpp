@@ -0,0 +1,349 @@
+#include "ShmMPSCQueue.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+struct Order {
+    uint32_t producer;
+    uint32_t seq;
+    int64_t price;
+    int64_t qty;
+};
+
+// Unique shm name per test so parallel test runs do not collide
+std::string queue_name(const char* test) {
+    return std::string("/hft_shmq_") + test + "_" + std::to_string(::getpid());
+}
+
+}  // namespace
+
+// Test 1: Basic push/pop through the shared segment
+TEST(ShmMPSCQueueTest, BasicOperations) {
+    auto name = queue_name("basic");
+    ShmMPSCProducer<Order, 16> early(name);
+    EXPECT_FALSE(early.is_open());  // nothing to attach to yet
+
+    ShmMPSCConsumer<Order, 16> consumer(name);
+    ASSERT_TRUE(consumer.is_open());
+    ShmMPSCProducer<Order, 16> producer(name);
+    ASSERT_TRUE(producer.is_open());
+    EXPECT_EQ(consumer.producers(), 1);
+
+    Order out{};
+    EXPECT_FALSE(consumer.pop(out));
+
+    EXPECT_TRUE(producer.push(Order{0, 1, 100, 5}));
+    EXPECT_TRUE(producer.push(Order{0, 2, 101, 6}));
+
+    EXPECT_TRUE(consumer.pop(out));
+    EXPECT_EQ(out.seq, 1);
+    EXPECT_EQ(out.price, 100);
+    EXPECT_TRUE(consumer.pop(out));
+    EXPECT_EQ(out.seq, 2);
+    EXPECT_FALSE(consumer.pop(out));
+
+    // A layout with another capacity must not attach
+    ShmMPSCProducer<Order, 32> mismatched(name);
+    EXPECT_FALSE(mismatched.is_open());
+
+    ShmMPSCConsumer<Order, 16>::unlink(name);
+}
+
+// Test 2: Bounded capacity, slots are reused after the consumer frees them
+TEST(ShmMPSCQueueTest, FullAndWrap) {
+    auto name = queue_name("full");
+    ShmMPSCConsumer<Order, 4> consumer(name);
+    ShmMPSCProducer<Order, 4> producer(name);
+    ASSERT_TRUE(producer.is_open());
+
+    for (uint32_t lap = 0; lap < 100; ++lap) {
+        for (uint32_t i = 0; i < 4; ++i) {
+            EXPECT_TRUE(producer.push(Order{0, lap * 4 + i, 0, 0}));
+        }
+        EXPECT_FALSE(producer.push(Order{}));
+
+        Order out{};
+        for (uint32_t i = 0; i < 4; ++i) {
+            EXPECT_TRUE(consumer.pop(out));
+            EXPECT_EQ(out.seq, lap * 4 + i);
+        }
+        EXPECT_FALSE(consumer.pop(out));
+    }
+
+    ShmMPSCConsumer<Order, 4>::unlink(name);
+}
+
+// Test 3: Registration table is bounded and entries are returned on detach
+TEST(ShmMPSCQueueTest, ProducerRegistration) {
+    auto name = queue_name("reg");
+    ShmMPSCConsumer<Order, 4> consumer(name);
+
+    std::vector<std::unique_ptr<ShmMPSCProducer<Order, 4>>> producers;
+    for (int i = 0; i < 64; ++i) {
+        producers.push_back(std::make_unique<ShmMPSCProducer<Order, 4>>(name));
+        EXPECT_TRUE(producers.back()->is_open());
+    }
+    ShmMPSCProducer<Order, 4> extra(name);
+    EXPECT_FALSE(extra.is_open());
+    EXPECT_EQ(consumer.producers(), 64);
+
+    producers.pop_back();
+    EXPECT_EQ(consumer.producers(), 63);
+    ShmMPSCProducer<Order, 4> again(name);
+    EXPECT_TRUE(again.is_open());
+    EXPECT_EQ(again.id(), 63);
+
+    ShmMPSCConsumer<Order, 4>::unlink(name);
+}
+
+// Test 4: Producer processes send to one consumer, per-producer order preserved
+TEST(ShmMPSCQueueTest, MultiProcessProducers) {
+    auto name = queue_name("multi");
+    constexpr int NUM_CHILDREN = 3;
+    constexpr uint32_t ITEMS_PER_CHILD = 5000;
+    ShmMPSCConsumer<Order, 256> consumer(name);
+    ASSERT_TRUE(consumer.is_open());
+
+    std::vector<pid_t> children;
+    for (int c = 0; c < NUM_CHILDREN; ++c) {
+        pid_t pid = ::fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0) {
+            ShmMPSCProducer<Order, 256> producer(name);
+            if (!producer.is_open()) {
+                ::_exit(2);
+            }
+            for (uint32_t i = 0; i < ITEMS_PER_CHILD; ++i) {
+                while (!producer.push(Order{uint32_t(c), i, int64_t(i) * 10, 1})) {
+                    std::this_thread::yield();
+                }
+            }
+            ::_exit(0);
+        }
+        children.push_back(pid);
+    }
+
+    std::vector<uint32_t> next(NUM_CHILDREN, 0);
+    bool ordered = true;
+    size_t received = 0;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    while (received < NUM_CHILDREN * ITEMS_PER_CHILD && std::chrono::steady_clock::now() < deadline) {
+        Order out{};
+        if (consumer.pop(out)) {
+            ordered &= out.producer < NUM_CHILDREN && out.seq == next[out.producer];
+            ordered &= out.price == int64_t(out.seq) * 10;
+            ++next[out.producer];
+            ++received;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    for (pid_t pid : children) {
+        int status = 0;
+        ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+        EXPECT_EQ(WEXITSTATUS(status), 0);
+    }
+    EXPECT_EQ(received, NUM_CHILDREN * ITEMS_PER_CHILD);
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(consumer.abandoned(), 0);
+
+    ShmMPSCConsumer<Order, 256>::unlink(name);
+}
+
+// Test 5: A producer that dies between claim and publish does not block the queue
+TEST(ShmMPSCQueueTest, CrashedProducerIsReclaimed) {
+    auto name = queue_name("crash");
+    ShmMPSCConsumer<Order, 16> consumer(name, 1000000);  // 1 ms stall timeout
+    ASSERT_TRUE(consumer.is_open());
+
+    pid_t pid = ::fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        ShmMPSCProducer<Order, 16> producer(name);
+        if (!producer.is_open() || !producer.claim()) {
+            ::_exit(2);
+        }
+        ::_exit(0);  // crash with the slot CLAIMED
+    }
+    int status = 0;
+    ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    // A live producer queues behind the dead one's slot
+    ShmMPSCProducer<Order, 16> producer(name);
+    ASSERT_TRUE(producer.is_open());
+    EXPECT_EQ(producer.id(), 0);  // dead process's registration is reused
+    EXPECT_TRUE(producer.push(Order{1, 42, 0, 0}));
+
+    Order out{};
+    EXPECT_FALSE(consumer.pop(out));  // head is CLAIMED, stall timer starts
+    std::this_thread::sleep_for(std::chrono::milliseconds(3));
+    EXPECT_TRUE(consumer.pop(out));
+    EXPECT_EQ(out.seq, 42);
+    EXPECT_EQ(consumer.abandoned(), 1);
+
+    ShmMPSCConsumer<Order, 16>::unlink(name);
+}
+
+// Test 6: A producer that dies between its slot CAS and the tail CAS does not block later claims
+TEST(ShmMPSCQueueTest, CrashBeforeTailMoveIsReclaimed) {
+    using Layout = ShmMPSCLayout<Order, 16>;
+    auto name = queue_name("crashtail");
+    ShmMPSCConsumer<Order, 16> consumer(name, 1000000);  // 1 ms stall timeout
+    ASSERT_TRUE(consumer.is_open());
+
+    pid_t pid = ::fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        ShmMPSCProducer<Order, 16> producer(name);
+        int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+        if (!producer.is_open() || fd < 0) {
+            ::_exit(2);
+        }
+        void* addr = ::mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (addr == MAP_FAILED) {
+            ::_exit(2);
+        }
+
+        // The first half of claim(): take slot 0, but die before moving the tail hint
+        auto layout = static_cast<Layout*>(addr);
+        uint32_t count = Layout::count(layout->producers[producer.id()].entry.load());
+        uint64_t state = Layout::make(0, Layout::FREE, 0);
+        if (!layout->slots[0].state.compare_exchange_strong(state, Layout::make(0, Layout::CLAIMED, producer.id(), count))) {
+            ::_exit(2);
+        }
+        ::_exit(0);
+    }
+    int status = 0;
+    ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    // No live producer helps the hint during the stall: the consumer reclaims first
+    Order out{};
+    EXPECT_FALSE(consumer.pop(out));
+    std::this_thread::sleep_for(std::chrono::milliseconds(3));
+    EXPECT_FALSE(consumer.pop(out));
+    EXPECT_EQ(consumer.abandoned(), 1);
+
+    // The tail hint still points at the reclaimed slot; claims must get past it
+    ShmMPSCProducer<Order, 16> producer(name);
+    ASSERT_TRUE(producer.is_open());
+    for (uint32_t i = 0; i < 20; ++i) {
+        ASSERT_TRUE(producer.push(Order{1, i, 0, 0}));
+        ASSERT_TRUE(consumer.pop(out));
+        EXPECT_EQ(out.seq, i);
+    }
+
+    ShmMPSCConsumer<Order, 16>::unlink(name);
+}
+
+// Test 7: A dead producer whose pid now names another live process is still reclaimed
+TEST(ShmMPSCQueueTest, ReusedPidIsReclaimed) {
+    using Layout = ShmMPSCLayout<Order, 16>;
+    if (shm_detail::process_start_time(1) == 0) {
+        GTEST_SKIP() << "/proc/1/stat not readable";
+    }
+    auto name = queue_name("pidreuse");
+    ShmMPSCConsumer<Order, 16> consumer(name, 1000000);  // 1 ms stall timeout
+    ASSERT_TRUE(consumer.is_open());
+
+    pid_t pid = ::fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        ShmMPSCProducer<Order, 16> producer(name);
+        if (!producer.is_open() || !producer.claim()) {
+            ::_exit(2);
+        }
+        ::_exit(0);  // crash with the slot CLAIMED
+    }
+    int status = 0;
+    ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    // Simulate pid reuse: the dead producer's entry now names pid 1, which is alive
+    int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    ASSERT_GE(fd, 0);
+    void* addr = ::mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    ASSERT_NE(addr, MAP_FAILED);
+    auto& entry = static_cast<Layout*>(addr)->producers[0].entry;
+    entry.store(Layout::entry(1, Layout::count(entry.load())));
+    ::munmap(addr, sizeof(Layout));
+
+    // The entry is recognised as stale and reused, and the claimed slot is skipped
+    ShmMPSCProducer<Order, 16> producer(name);
+    ASSERT_TRUE(producer.is_open());
+    EXPECT_EQ(producer.id(), 0);
+    EXPECT_TRUE(producer.push(Order{1, 42, 0, 0}));
+
+    Order out{};
+    EXPECT_FALSE(consumer.pop(out));
+    std::this_thread::sleep_for(std::chrono::milliseconds(3));
+    EXPECT_TRUE(consumer.pop(out));
+    EXPECT_EQ(out.seq, 42);
+    EXPECT_EQ(consumer.abandoned(), 1);
+
+    ShmMPSCConsumer<Order, 16>::unlink(name);
+}
+
+// Test 8: A live but slow producer is never skipped
+TEST(ShmMPSCQueueTest, SlowProducerIsNotReclaimed) {
+    auto name = queue_name("slow");
+    ShmMPSCConsumer<Order, 16> consumer(name, 100000);  // 0.1 ms stall timeout
+    ShmMPSCProducer<Order, 16> producer(name);
+    ASSERT_TRUE(producer.is_open());
+
+    Order* slot = producer.claim();
+    ASSERT_NE(slot, nullptr);
+
+    Order out{};
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_FALSE(consumer.pop(out));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(consumer.abandoned(), 0);
+
+    *slot = Order{0, 7, 0, 0};
+    producer.publish();
+    EXPECT_TRUE(consumer.pop(out));
+    EXPECT_EQ(out.seq, 7);
+
+    ShmMPSCConsumer<Order, 16>::unlink(name);
+}
+
+// Test 9: Performance benchmark (single process, push/pop pairs)
+TEST(ShmMPSCQueueTest, PerformanceBenchmark) {
+    auto name = queue_name("perf");
+    ShmMPSCConsumer<Order, 1024> consumer(name);
+    ShmMPSCProducer<Order, 1024> producer(name);
+    ASSERT_TRUE(producer.is_open());
+    constexpr int ITERATIONS = 1000000;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    Order out{};
+    for (int i = 0; i < ITERATIONS; ++i) {
+        producer.push(Order{0, uint32_t(i), i, 1});
+        consumer.pop(out);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    EXPECT_EQ(out.seq, ITERATIONS - 1);
+    std::cout << "Shared-memory MPSC push+pop: "
+              << (duration.count() * 1000.0) / ITERATIONS << " ns/pair" << std::endl;
+
+    ShmMPSCConsumer<Order, 1024>::unlink(name);
+}
+
+// Main function is provided by gtest_main
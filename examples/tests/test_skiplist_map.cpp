@@ -0,0 +1,249 @@
+#include "SkipListMap.h"
+#include "FixedPoint.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+
+// Test 1: Random inserts, updates and erases match std::map
+TEST(SkipListMapTest, MatchesStdMap) {
+    QsbrDomain domain;
+    SkipListMap<int64_t, int64_t> list(domain);
+    std::map<int64_t, int64_t> reference;
+    std::mt19937 rng(3);
+
+    for (int i = 0; i < 20000; ++i) {
+        int64_t key = int64_t(rng() % 2000);
+        if (rng() % 3 == 0) {
+            EXPECT_EQ(list.erase(key), reference.erase(key) == 1);
+        } else {
+            int64_t value = int64_t(rng());
+            EXPECT_EQ(list.insert_or_assign(key, value), reference.find(key) == reference.end());
+            reference[key] = value;
+        }
+    }
+    ASSERT_EQ(list.size(), reference.size());
+
+    auto it = reference.begin();
+    list.for_each([&](int64_t key, int64_t value) {
+        EXPECT_EQ(key, it->first);
+        EXPECT_EQ(value, it->second);
+        ++it;
+        return true;
+    });
+    EXPECT_EQ(it, reference.end());
+
+    for (int64_t key = 0; key < 2000; ++key) {
+        int64_t value = 0;
+        auto ref = reference.find(key);
+        ASSERT_EQ(list.find(key, value), ref != reference.end());
+        if (ref != reference.end()) {
+            EXPECT_EQ(value, ref->second);
+        }
+    }
+}
+
+// Test 2: Bid-side ordering and range iteration from the best price
+TEST(SkipListMapTest, BidLadderRanges) {
+    QsbrDomain domain;
+    SkipListMap<Price, Quantity, std::greater<Price>> bids(domain);
+    for (int64_t px : {100, 250, 90, 175, 300}) {
+        bids.insert_or_assign(Price::from_int(px), Quantity::from_int(px / 10));
+    }
+
+    Price best;
+    Quantity qty;
+    ASSERT_TRUE(bids.front(best, qty));
+    EXPECT_EQ(best, Price::from_int(300));
+    EXPECT_EQ(qty, Quantity::from_int(30));
+
+    // Top 3 levels
+    std::vector<int64_t> top;
+    bids.for_each([&](Price px, Quantity) {
+        top.push_back(px.raw() / Price::from_int(1).raw());
+        return top.size() < 3;
+    });
+    EXPECT_EQ(top, (std::vector<int64_t>{300, 250, 175}));
+
+    // Levels at or below 200, i.e. starting at the first key not better than 200
+    std::vector<int64_t> below;
+    size_t visited = bids.for_each_from(Price::from_int(200), [&](Price px, Quantity) {
+        below.push_back(px.raw() / Price::from_int(1).raw());
+        return true;
+    });
+    EXPECT_EQ(below, (std::vector<int64_t>{175, 100, 90}));
+    EXPECT_EQ(visited, 3u);
+
+    EXPECT_FALSE(bids.insert_or_assign(Price::from_int(300), Quantity::from_int(1)));
+    ASSERT_TRUE(bids.find(Price::from_int(300), qty));
+    EXPECT_EQ(qty, Quantity::from_int(1));
+}
+
+// Test 3: Erased nodes are reused after a grace period instead of growing the pool
+TEST(SkipListMapTest, PooledNodeReuse) {
+    QsbrDomain domain;
+    SkipListMap<int64_t, int64_t> list(domain);
+    for (int64_t key = 0; key < 5000; ++key) list.insert_or_assign(key, key);
+    size_t reserved = list.memory_usage();
+
+    for (int round = 0; round < 20; ++round) {
+        for (int64_t key = 0; key < 5000; ++key) list.erase(key);
+        list.flush_retired();
+        domain.synchronize();   // no readers online: nodes return to the pool
+        for (int64_t key = 0; key < 5000; ++key) list.insert_or_assign(key, key);
+    }
+    EXPECT_EQ(list.size(), 5000u);
+    // Heights are random per insert, so allow a little slack for the per-height free lists
+    EXPECT_LE(list.memory_usage(), 2 * reserved);
+}
+
+// Test 4: Keys with 16-byte alignment stay aligned in every pooled node
+TEST(SkipListMapTest, OverAlignedKeys) {
+    struct alignas(16) Level {
+        int64_t price;
+        int64_t venue;
+        bool operator<(const Level& other) const noexcept {
+            return price != other.price ? price < other.price : venue < other.venue;
+        }
+    };
+
+    QsbrDomain domain;
+    SkipListMap<Level, int64_t> list(domain);
+    for (int64_t key = 0; key < 2000; ++key) list.insert_or_assign(Level{key, key % 3}, key);
+
+    size_t misaligned = 0;
+    size_t visited = list.for_each([&](const Level& level, int64_t) {
+        misaligned += reinterpret_cast<uintptr_t>(&level) % alignof(Level) != 0;
+        return true;
+    });
+    EXPECT_EQ(visited, 2000u);
+    EXPECT_EQ(misaligned, 0u);
+}
+
+// Test 5: Readers walk ordered, consistent entries while the writer churns
+TEST(SkipListMapTest, ConcurrentReadersDuringChurn) {
+    constexpr int NUM_READERS = 3;
+    QsbrDomain domain;
+    auto list = std::make_unique<SkipListMap<int64_t, int64_t>>(domain);
+    std::atomic<bool> stop{false};
+    std::atomic<int> errors{0};
+    std::atomic<uint64_t> walks{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < NUM_READERS; ++r) {
+        readers.emplace_back([&]() {
+            QsbrDomain::Reader reader(domain);
+            while (!stop.load(std::memory_order_relaxed)) {
+                int64_t last = -1;
+                list->for_each([&](int64_t key, int64_t value) {
+                    // Values always encode key * 3 / 1000: a recycled node would break this
+                    if (key <= last || value / 1000 != key * 3 / 1000) {
+                        errors.fetch_add(1);
+                    }
+                    last = key;
+                    return true;
+                });
+                int64_t value;
+                if (list->find(500, value) && value / 1000 != 1) errors.fetch_add(1);
+                walks.fetch_add(1, std::memory_order_relaxed);
+                reader.quiescent();
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    std::mt19937 rng(5);
+    for (int i = 0; i < 200000; ++i) {
+        int64_t key = int64_t(rng() % 1000);
+        if (rng() % 2) {
+            list->insert_or_assign(key, key * 3 / 1000 * 1000 + int64_t(rng() % 1000));
+        } else {
+            list->erase(key);
+        }
+        if (i % 1000 == 0) std::this_thread::yield();
+    }
+    stop.store(true);
+    for (auto& t : readers) t.join();
+    list.reset();
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_GT(walks.load(), 0u);
+    EXPECT_EQ(domain.pending(), 0u);
+}
+
+// Test 6: Writer plus readers versus std::map guarded by a mutex (benchmark)
+TEST(SkipListMapTest, ReadersBenchmark) {
+    constexpr int NUM_READERS = 3;
+    constexpr int WRITES = 200000;
+    constexpr int64_t LEVELS = 2000;   // sparse: keys spread over a wide range
+
+    auto run = [&](auto&& write, auto&& read, auto&& reader_scope) {
+        std::atomic<bool> stop{false};
+        std::atomic<uint64_t> reads{0};
+        std::vector<std::thread> readers;
+        for (int r = 0; r < NUM_READERS; ++r) {
+            readers.emplace_back([&]() {
+                auto scope = reader_scope();
+                uint64_t local = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    read(scope.get());
+                    ++local;
+                }
+                reads.fetch_add(local);
+            });
+        }
+        std::mt19937 rng(9);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < WRITES; ++i) {
+            write(int64_t(rng() % LEVELS) * 37, int64_t(i));
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        stop.store(true);
+        for (auto& t : readers) t.join();
+        double seconds = double(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()) / 1e6;
+        return std::make_pair(WRITES / seconds, double(reads.load()) / seconds);
+    };
+
+    // Reader: top 5 levels from the best price
+    QsbrDomain domain;
+    auto list = std::make_unique<SkipListMap<int64_t, int64_t>>(domain);
+    auto skip = run(
+        [&](int64_t key, int64_t i) {
+            if (i % 4 == 0) list->erase(key); else list->insert_or_assign(key, i);
+        },
+        [&](QsbrDomain::Reader* reader) {
+            int n = 0;
+            list->for_each([&](int64_t, int64_t) { return ++n < 5; });
+            reader->quiescent();
+        },
+        [&]() { return std::make_unique<QsbrDomain::Reader>(domain); });
+    list.reset();
+
+    std::map<int64_t, int64_t> map;
+    std::mutex mutex;
+    auto locked = run(
+        [&](int64_t key, int64_t i) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (i % 4 == 0) map.erase(key); else map[key] = i;
+        },
+        [&](int*) {
+            std::lock_guard<std::mutex> lock(mutex);
+            int n = 0;
+            for (auto it = map.begin(); it != map.end() && n < 5; ++it, ++n) {
+            }
+        },
+        [&]() { return std::unique_ptr<int>(); });
+
+    std::cout << "SkipListMap: " << skip.first / 1e6 << " M writes/sec, " << skip.second / 1e6
+              << " M top-5 reads/sec; std::map + mutex: " << locked.first / 1e6 << " M writes/sec, "
+              << locked.second / 1e6 << " M top-5 reads/sec" << std::endl;
+}
+
+// Main function is provided by gtest_main
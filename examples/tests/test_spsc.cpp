@@ -445,5 +445,65 @@ TEST(SPSCRingBufferTest, BatchOperations) {
     EXPECT_TRUE(buffer.empty());
 }
 
+// Test 16: Batched pop releases the head once per batch
+TEST(SPSCRingBufferTest, PopBatch) {
+    SPSCRingBuffer<int, 8> buffer;
+    std::vector<int> out;
+    auto collect = [&](int&& v) { out.push_back(v); };
+
+    // Empty buffer yields nothing
+    EXPECT_EQ(buffer.pop_batch(collect, 4), 0);
+
+    // Move head/tail close to the end so the batch wraps around
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(buffer.push(i));
+        int val;
+        EXPECT_TRUE(buffer.pop(val));
+    }
+
+    for (int i = 0; i < 7; ++i) {
+        EXPECT_TRUE(buffer.push(i));
+    }
+    EXPECT_TRUE(buffer.full());
+
+    // Limited by maxItems
+    EXPECT_EQ(buffer.pop_batch(collect, 3), 3);
+    EXPECT_EQ(buffer.size(), 4);
+
+    // Limited by available items
+    EXPECT_EQ(buffer.pop_batch(collect, 100), 4);
+    EXPECT_TRUE(buffer.empty());
+
+    EXPECT_EQ(out, std::vector<int>({0, 1, 2, 3, 4, 5, 6}));
+}
+
+// Test 17: Bulk discard of a monotonic prefix
+TEST(SPSCRingBufferTest, DiscardFront) {
+    SPSCRingBuffer<int, 16> buffer;
+
+    // Wrap the indices first
+    for (int i = 0; i < 12; ++i) {
+        int val;
+        EXPECT_TRUE(buffer.push(i));
+        EXPECT_TRUE(buffer.pop(val));
+    }
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(buffer.push(i));
+    }
+
+    EXPECT_EQ(buffer.discard_front([](const int& v) { return v < 0; }), 0);
+    EXPECT_EQ(buffer.discard_front([](const int& v) { return v < 7; }), 7);
+    EXPECT_EQ(buffer.size(), 3);
+
+    int val = -1;
+    EXPECT_TRUE(buffer.pop(val));
+    EXPECT_EQ(val, 7);
+
+    // Everything matches: buffer ends up empty
+    EXPECT_EQ(buffer.discard_front([](const int&) { return true; }), 2);
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.discard_front([](const int&) { return true; }), 0);
+}
+
 // Main function is provided by gtest_main
 // No need to write main() when linking with gtest_main
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "Symbol.h"
+#include "SPSCRingBuffer.h"
+#include "MPSCQueue.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+
+namespace {
+
+// A quote that carries its symbol inline instead of in a std::string
+struct Quote {
+    Symbol8 symbol;
+    int64_t bid;
+    int64_t ask;
+};
+static_assert(std::is_trivially_copyable_v<Quote>);
+
+constexpr Symbol8 kAapl("AAPL");
+static_assert(kAapl.size() == 4);
+static_assert(kAapl == Symbol8("AAPL"));
+static_assert(Symbol8("AAPL") < Symbol8("AAPLX"));
+static_assert(Symbol16("SPXW251219C0600") > Symbol16("SPXW251219C05"));
+
+}  // namespace
+
+// Test 1: Construction, padding, truncation and views
+TEST(SymbolTest, BasicOperations) {
+    Symbol8 empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.size(), 0);
+    EXPECT_EQ(empty.view(), "");
+
+    Symbol8 full("ABCDEFGH");
+    EXPECT_EQ(full.size(), 8);
+    EXPECT_EQ(full.view(), "ABCDEFGH");
+
+    Symbol8 truncated("ABCDEFGHIJ");
+    EXPECT_EQ(truncated.view(), "ABCDEFGH");
+    EXPECT_FALSE(Symbol8::fits("ABCDEFGHIJ"));
+    EXPECT_TRUE(Symbol8::fits("ESZ5"));
+
+    Symbol16 option("AAPL  251219C00200000");  // OSI is 21 bytes: truncated
+    EXPECT_EQ(option.size(), 16);
+    Symbol16 root("BRK.B");
+    EXPECT_EQ(root.view(), "BRK.B");
+    EXPECT_EQ(root.size(), 5);
+    EXPECT_EQ(Symbol16("ABCDEFGHI").size(), 9);
+}
+
+// Test 2: Equality and ordering agree with std::string_view
+TEST(SymbolTest, CompareMatchesStringView) {
+    std::vector<std::string> texts = {"", "A", "AA", "AAPL", "AAPLX", "AB", "ESZ5", "ESH6",
+                                      "MSFT", "Z", "ZZZZZZZZ", "BRK.A", "BRK.B", "a"};
+    for (const auto& x : texts) {
+        for (const auto& y : texts) {
+            Symbol8 a(x), b(y);
+            EXPECT_EQ(a == b, x == y) << x << " " << y;
+            EXPECT_EQ(a < b, std::string_view(x) < std::string_view(y)) << x << " " << y;
+
+            Symbol16 c(x + x), d(y + y);
+            EXPECT_EQ(c == d, x == y);
+            EXPECT_EQ(c < d, std::string_view(x + x).substr(0, 16) < std::string_view(y + y).substr(0, 16));
+        }
+    }
+
+    std::vector<Symbol8> sorted;
+    for (const auto& text : texts) sorted.emplace_back(text);
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end(), [](const Symbol8& a, const Symbol8& b) {
+        return a.view() < b.view();
+    }));
+}
+
+// Test 3: Messages with symbols flow through the queues without allocation
+TEST(SymbolTest, MessagesThroughQueues) {
+    SPSCRingBuffer<Quote, 16> ring;
+    EXPECT_TRUE(ring.push(Quote{Symbol8("NVDA"), 100, 101}));
+    Quote out{};
+    EXPECT_TRUE(ring.pop(out));
+    EXPECT_EQ(out.symbol, Symbol8("NVDA"));
+    EXPECT_EQ(out.ask, 101);
+
+    MPSCQueue<Symbol16> queue;
+    queue.push(Symbol16("Hello"));
+    queue.push(Symbol16("World"));
+    Symbol16 value;
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value.view(), "Hello");  // FIFO
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value.view(), "World");
+}
+
+// Test 4: Interning assigns dense ids in first-seen order
+TEST(SymbolTableTest, InternAndFind) {
+    auto table = std::make_unique<SymbolTable<8, 4>>();
+
+    EXPECT_EQ(table->find(Symbol8("AAPL")), table->INVALID_ID);
+    EXPECT_EQ(table->intern(Symbol8("AAPL")), 0);
+    EXPECT_EQ(table->intern(Symbol8("MSFT")), 1);
+    EXPECT_EQ(table->intern(Symbol8("AAPL")), 0);
+    EXPECT_EQ(table->find(Symbol8("MSFT")), 1);
+    EXPECT_EQ(table->symbol(1).view(), "MSFT");
+    EXPECT_EQ(table->size(), 2);
+
+    EXPECT_EQ(table->intern(Symbol8("NVDA")), 2);
+    EXPECT_EQ(table->intern(Symbol8("TSLA")), 3);
+    EXPECT_EQ(table->intern(Symbol8("AMZN")), table->INVALID_ID);  // full
+    EXPECT_EQ(table->intern(Symbol8("AMZN")), table->INVALID_ID);
+    EXPECT_EQ(table->intern(Symbol8("TSLA")), 3);
+    EXPECT_EQ(table->size(), 4);
+}
+
+// Test 5: Concurrent interning of overlapping symbol sets agrees on every id
+TEST(SymbolTableTest, ConcurrentIntern) {
+    constexpr int NUM_THREADS = 4;
+    constexpr int NUM_SYMBOLS = 2000;
+    constexpr int STRIDES[NUM_THREADS] = {1, 7, 3, 7919};   // coprime to NUM_SYMBOLS
+    auto table = std::make_unique<SymbolTable<16, NUM_SYMBOLS>>();
+    std::vector<std::vector<uint32_t>> ids(NUM_THREADS, std::vector<uint32_t>(NUM_SYMBOLS));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < NUM_SYMBOLS; ++i) {
+                int s = (i * STRIDES[t] + t) % NUM_SYMBOLS;   // different order per thread
+                ids[t][s] = table->intern(Symbol16("SYM" + std::to_string(s)));
+                if (i % 64 == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    EXPECT_EQ(table->size(), NUM_SYMBOLS);
+    std::vector<bool> seen(NUM_SYMBOLS, false);
+    for (int s = 0; s < NUM_SYMBOLS; ++s) {
+        uint32_t id = ids[0][s];
+        ASSERT_LT(id, NUM_SYMBOLS);
+        for (int t = 1; t < NUM_THREADS; ++t) {
+            EXPECT_EQ(ids[t][s], id);
+        }
+        EXPECT_FALSE(seen[id]);
+        seen[id] = true;
+        EXPECT_EQ(table->symbol(id).view(), "SYM" + std::to_string(s));
+    }
+}
+
+// Test 6: Overfilling the table fails fast instead of exhausting the slots
+TEST(SymbolTableTest, OverfillReturnsInvalid) {
+    auto table = std::make_unique<SymbolTable<8, 2>>();   // 4 slots
+    EXPECT_EQ(table->intern(Symbol8("S0")), 0);
+    EXPECT_EQ(table->intern(Symbol8("S1")), 1);
+
+    // Far more distinct symbols than slots: every call returns, none takes a slot
+    for (int i = 2; i < 100; ++i) {
+        Symbol8 symbol("S" + std::to_string(i));
+        EXPECT_EQ(table->intern(symbol), table->INVALID_ID);
+        EXPECT_EQ(table->find(symbol), table->INVALID_ID);
+    }
+    EXPECT_EQ(table->intern(Symbol8("S0")), 0);
+    EXPECT_EQ(table->find(Symbol8("S1")), 1);
+    EXPECT_EQ(table->size(), 2);
+}
+
+// Test 7: Symbol compare and queue transfer versus std::string (benchmark)
+TEST(SymbolTest, CompareBenchmark) {
+    constexpr int ITERATIONS = 1000000;
+    std::vector<std::string> strings = {"AAPL", "AAPM", "MSFT", "AAPL"};
+    std::vector<Symbol8> symbols(strings.begin(), strings.end());
+
+    size_t equal_strings = 0;
+    size_t equal_symbols = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        equal_strings += strings[i & 3] == strings[(i >> 2) & 3];
+    }
+    auto mid = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        equal_symbols += symbols[i & 3] == symbols[(i >> 2) & 3];
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    EXPECT_EQ(equal_strings, equal_symbols);
+
+    MPSCQueue<std::string> string_queue;
+    MPSCQueue<Symbol8> symbol_queue;
+    std::string sval;
+    Symbol8 yval;
+    auto q0 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS / 10; ++i) {
+        string_queue.push(strings[i & 3]);
+        string_queue.pop(sval);
+    }
+    auto q1 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS / 10; ++i) {
+        symbol_queue.push(symbols[i & 3]);
+        symbol_queue.pop(yval);
+    }
+    auto q2 = std::chrono::high_resolution_clock::now();
+    EXPECT_EQ(yval.view(), sval);
+
+    auto ns = [](auto a, auto b, int n) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(b - a).count() * 1.0 / n;
+    };
+    std::cout << "Compare: std::string " << ns(start, mid, ITERATIONS) << " ns, Symbol8 "
+              << ns(mid, end, ITERATIONS) << " ns; MPSCQueue push+pop: std::string "
+              << ns(q0, q1, ITERATIONS / 10) << " ns, Symbol8 " << ns(q1, q2, ITERATIONS / 10)
+              << " ns" << std::endl;
+}
+
+// Main function is provided by gtest_main
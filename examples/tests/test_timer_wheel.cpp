@@ -0,0 +1,199 @@
+#include "TimerWheel.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <queue>
+#include <random>
+
+namespace {
+
+struct OrderTimer : TimerNode {
+    uint64_t id = 0;
+    uint64_t firedAt = 0;   // wheel time at which it fired, 0 = never
+};
+
+}  // namespace
+
+// Test 1: Timers fire in deadline order, never early
+TEST(TimerWheelTest, FiresInOrder) {
+    TimerWheel<OrderTimer> wheel(1, 1000);
+    std::vector<OrderTimer> timers(5);
+    const uint64_t deadlines[] = {1030, 1010, 1500, 1010, 5000};
+    for (size_t i = 0; i < timers.size(); ++i) {
+        timers[i].id = i;
+        wheel.schedule(timers[i], deadlines[i]);
+    }
+    EXPECT_EQ(wheel.size(), 5u);
+
+    std::vector<uint64_t> fired;
+    auto record = [&](OrderTimer& t) { fired.push_back(t.id); };
+    EXPECT_EQ(wheel.advance(record, 1009), 0u);
+    EXPECT_EQ(wheel.advance(record, 1010), 2u);
+    EXPECT_EQ(wheel.advance(record, 1499), 1u);
+    EXPECT_EQ(wheel.advance(record, 100000), 2u);
+    EXPECT_EQ(fired, (std::vector<uint64_t>{1, 3, 0, 2, 4}));
+    EXPECT_TRUE(wheel.empty());
+    EXPECT_FALSE(timers[0].scheduled());
+}
+
+// Test 2: Cancel, reschedule, and callbacks that re-arm or cancel other timers
+TEST(TimerWheelTest, CancelAndReschedule) {
+    TimerWheel<OrderTimer> wheel(16, 0);   // coarse resolution: deadlines round up
+    EXPECT_EQ(wheel.resolution(), 16u);
+    OrderTimer order, heartbeat, victim;
+    order.id = 1;
+    heartbeat.id = 2;
+    victim.id = 3;
+
+    wheel.schedule(order, 100);
+    EXPECT_TRUE(wheel.cancel(order));
+    EXPECT_FALSE(wheel.cancel(order));
+    wheel.schedule(order, 100);
+    wheel.schedule(order, 300);   // moved, still counted once
+    EXPECT_EQ(wheel.size(), 1u);
+
+    wheel.schedule(heartbeat, 50);
+    wheel.schedule(victim, 60);
+    int beats = 0;
+    std::vector<uint64_t> fired;
+    auto on_expire = [&](OrderTimer& t) {
+        fired.push_back(t.id);
+        if (&t == &heartbeat) {
+            ++beats;
+            wheel.cancel(victim);   // same slot, not yet fired
+            if (beats < 4) wheel.schedule(heartbeat, t.deadline() + 50);
+        }
+    };
+    wheel.advance(on_expire, 99);
+    EXPECT_EQ(fired, (std::vector<uint64_t>{2}));
+    EXPECT_GE(99u, heartbeat.deadline() - 50);   // fired no earlier than 50
+
+    wheel.advance(on_expire, 1000);
+    EXPECT_EQ(beats, 4);
+    EXPECT_EQ(fired, (std::vector<uint64_t>{2, 2, 2, 2, 1}));
+    EXPECT_TRUE(wheel.empty());
+
+    // Scheduling in the past fires at the next advance
+    wheel.schedule(order, 10);
+    EXPECT_EQ(wheel.advance(on_expire, 1000), 1u);
+}
+
+// Test 3: Random deadlines across every level, and beyond the span, fire exactly once and never early
+TEST(TimerWheelTest, FiresAcrossLevels) {
+    constexpr size_t NUM_TIMERS = 20000;
+    std::mt19937_64 rng(11);
+    TimerWheel<OrderTimer> wheel(1, 0);
+    std::vector<OrderTimer> timers(NUM_TIMERS);
+    for (size_t i = 0; i < NUM_TIMERS; ++i) {
+        timers[i].id = i;
+        // Spread over every level, including beyond the 2^36 span
+        uint64_t deadline = 1 + (rng() >> (rng() % 44 + 20));
+        if (i % 97 == 0) deadline = (uint64_t{1} << 37) + i;
+        wheel.schedule(timers[i], deadline);
+    }
+    for (size_t i = 0; i < NUM_TIMERS; i += 5) {
+        wheel.cancel(timers[i]);
+    }
+
+    uint64_t now = 0;
+    bool early = false;
+    size_t fired = 0;
+    while (!wheel.empty()) {
+        now += 1 + (rng() >> (rng() % 36 + 28));
+        fired += wheel.advance([&](OrderTimer& t) {
+            early |= t.deadline() > now;
+            t.firedAt = now;
+        }, now);
+    }
+    EXPECT_FALSE(early);
+    EXPECT_EQ(fired, NUM_TIMERS - NUM_TIMERS / 5);
+    for (size_t i = 0; i < NUM_TIMERS; ++i) {
+        if (i % 5 == 0) {
+            EXPECT_EQ(timers[i].firedAt, 0u);
+        } else {
+            ASSERT_GE(timers[i].firedAt, timers[i].deadline());
+        }
+    }
+}
+
+// Test 4: Other threads arm and cancel timers through the inbox
+TEST(TimerWheelTest, CrossThreadInbox) {
+    constexpr int NUM_THREADS = 4;
+    constexpr int PER_THREAD = 500;
+    TimerWheel<OrderTimer> wheel(1, 0);
+    std::vector<OrderTimer> timers(NUM_THREADS * PER_THREAD);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                OrderTimer& timer = timers[t * PER_THREAD + i];
+                timer.id = t * PER_THREAD + i;
+                wheel.post_schedule(timer, 100 + i);
+                if (i % 2 == 1) {
+                    wheel.post_cancel(timer);   // applied in order after the schedule
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    size_t fired = 0;
+    EXPECT_EQ(wheel.advance([&](OrderTimer&) { ++fired; }, 50), 0u);
+    EXPECT_EQ(wheel.size(), size_t(NUM_THREADS * PER_THREAD / 2));
+    wheel.advance([&](OrderTimer& t) {
+        ++fired;
+        EXPECT_EQ(t.id % 2, 0u);
+    }, 100 + PER_THREAD);
+    EXPECT_EQ(fired, size_t(NUM_THREADS * PER_THREAD / 2));
+}
+
+// Test 5: Schedule/cancel/expire versus std::priority_queue (benchmark)
+TEST(TimerWheelTest, ThroughputBenchmark) {
+    constexpr size_t NUM_TIMERS = 200000;
+    std::mt19937_64 rng(3);
+    std::vector<uint64_t> deadlines(NUM_TIMERS);
+    for (auto& d : deadlines) d = 1 + rng() % 1000000;
+
+    auto timers = std::make_unique<OrderTimer[]>(NUM_TIMERS);
+    TimerWheel<OrderTimer> wheel(16, 0);
+    size_t wheel_fired = 0;
+    auto w0 = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < NUM_TIMERS; ++i) wheel.schedule(timers[i], deadlines[i]);
+    for (size_t i = 0; i < NUM_TIMERS; i += 2) wheel.cancel(timers[i]);
+    for (uint64_t now = 0; now <= 1000000; now += 1000) {
+        wheel_fired += wheel.advance([](OrderTimer&) {}, now);
+    }
+    auto w1 = std::chrono::high_resolution_clock::now();
+
+    // Priority queue with lazy cancellation (the usual workaround)
+    using Entry = std::pair<uint64_t, size_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> heap;
+    std::vector<bool> cancelled(NUM_TIMERS, false);
+    size_t heap_fired = 0;
+    auto h0 = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < NUM_TIMERS; ++i) heap.emplace(deadlines[i], i);
+    for (size_t i = 0; i < NUM_TIMERS; i += 2) cancelled[i] = true;
+    for (uint64_t now = 0; now <= 1000000; now += 1000) {
+        while (!heap.empty() && heap.top().first <= now) {
+            heap_fired += !cancelled[heap.top().second];
+            heap.pop();
+        }
+    }
+    auto h1 = std::chrono::high_resolution_clock::now();
+
+    EXPECT_EQ(wheel_fired, NUM_TIMERS / 2);
+    EXPECT_EQ(heap_fired, NUM_TIMERS / 2);
+    auto ns = [](auto a, auto b) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(b - a).count() * 1.0 / NUM_TIMERS;
+    };
+    std::cout << "Timers (schedule + cancel half + expire), per timer: TimerWheel " << ns(w0, w1)
+              << " ns, std::priority_queue " << ns(h0, h1) << " ns" << std::endl;
+}
+
+// Main function is provided by gtest_main
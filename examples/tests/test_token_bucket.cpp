@@ -0,0 +1,180 @@
+#include "TokenBucket.h"
+#include "LockFreeStack.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+
+// Test 1: A new bucket holds a full burst, then rejects without taking anything
+TEST(TokenBucketTest, BurstThenReject) {
+    TokenBucket bucket(100, 10, 0);
+    EXPECT_EQ(bucket.available(0), 10u);
+    EXPECT_TRUE(bucket.try_acquire(4, 0));
+    EXPECT_TRUE(bucket.try_acquire(6, 0));
+    EXPECT_FALSE(bucket.try_acquire(1, 0));
+    EXPECT_EQ(bucket.available(0), 0u);
+
+    EXPECT_FALSE(bucket.try_acquire(11, 100000));   // more than burst: never
+    EXPECT_EQ(bucket.available(100000), 10u);
+}
+
+// Test 2: Tokens refill lazily in proportion to elapsed ticks
+TEST(TokenBucketTest, LazyRefill) {
+    TokenBucket bucket(100, 10, 1000);
+    ASSERT_TRUE(bucket.try_acquire(10, 1000));
+
+    EXPECT_EQ(bucket.available(1099), 0u);
+    EXPECT_EQ(bucket.wait_ticks(1, 1099), 1u);
+    EXPECT_EQ(bucket.wait_ticks(3, 1000), 300u);
+    EXPECT_FALSE(bucket.try_acquire(1, 1099));
+    EXPECT_TRUE(bucket.try_acquire(1, 1100));
+    EXPECT_FALSE(bucket.try_acquire(1, 1100));
+
+    EXPECT_EQ(bucket.available(1550), 4u);
+    EXPECT_FALSE(bucket.try_acquire(5, 1550));   // all or nothing
+    EXPECT_TRUE(bucket.try_acquire(4, 1550));
+
+    // A long idle period refills to burst, not beyond
+    EXPECT_EQ(bucket.available(1000000), 10u);
+    EXPECT_EQ(bucket.wait_ticks(10, 1000000), 0u);
+}
+
+// Test 3: A caller's clock older than the last grant reads as empty, not as a wrapped count
+TEST(TokenBucketTest, StaleClockAvailable) {
+    TokenBucket bucket(100, 10, 0);
+    ASSERT_TRUE(bucket.try_acquire(10, 1000));
+    EXPECT_EQ(bucket.available(500), 0u);
+    EXPECT_EQ(bucket.available(0), 0u);
+    EXPECT_EQ(bucket.available(2000), 10u);
+}
+
+// Test 4: interval_for_rate rounds up, so one second of ticks grants at most rate + burst
+TEST(TokenBucketTest, IntervalNeverExceedsRate) {
+    constexpr uint32_t BURST = 8;   // absorbs the sampling step, so the lower bound holds
+    const uint64_t ticksPerSecond = uint64_t(Tsc::ticks_per_ns() * 1e9);
+
+    for (uint64_t rate : {300000ull, 30000ull, 7ull}) {
+        uint64_t interval = TokenBucket::interval_for_rate(rate);
+        EXPECT_GE(double(interval) * double(rate), double(ticksPerSecond)) << rate;
+
+        // Acquire greedily as simulated time sweeps over one second
+        TokenBucket bucket(interval, BURST, 0);
+        uint64_t step = interval / 4 ? interval / 4 : 1;
+        uint64_t granted = 0;
+        for (uint64_t now = 0; now <= ticksPerSecond; now += step) {
+            while (bucket.try_acquire(1, now)) {
+                ++granted;
+            }
+        }
+        EXPECT_LE(granted, rate + BURST) << rate;
+        EXPECT_GE(double(granted), 0.999 * double(rate)) << rate;
+    }
+}
+
+// Test 5: Contending threads never get more than the bucket allows
+TEST(TokenBucketTest, NoOverGrantUnderContention) {
+    constexpr int NUM_THREADS = 8;
+    constexpr uint32_t BURST = 1000;
+    constexpr int STEPS = 50;
+    TokenBucket bucket(10, BURST, 0);
+
+    std::atomic<uint64_t> granted{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int step = 0; step < STEPS; ++step) {
+                uint64_t now = uint64_t(step) * 1000;   // 100 tokens per step
+                for (int i = 0; i < 200; ++i) {
+                    granted.fetch_add(bucket.try_acquire(1 + (i + t) % 3, now) ? 1 + (i + t) % 3 : 0,
+                                      std::memory_order_relaxed);
+                }
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    // The last simulated time any thread can have used is (STEPS - 1) * 1000
+    EXPECT_LE(granted.load(), BURST + uint64_t(STEPS - 1) * 100);
+    EXPECT_GE(granted.load(), BURST);
+}
+
+// Test 6: Real-time rate over the TSC stays within rate * elapsed + burst
+TEST(TokenBucketTest, RealTimeRate) {
+    constexpr uint64_t RATE = 20000;   // per second
+    constexpr uint32_t BURST = 50;
+    uint64_t start = Tsc::now();
+    TokenBucket bucket(TokenBucket::interval_for_rate(RATE), BURST, start);
+
+    std::atomic<uint64_t> granted{0};
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&]() {
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (bucket.try_acquire()) {
+                    granted.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    stop.store(true);
+    for (auto& t : threads) t.join();
+
+    double seconds = double(Tsc::to_ns(Tsc::now() - start)) / 1e9;
+    double limit = BURST + RATE * seconds + 1;
+    EXPECT_LE(double(granted.load()), limit);
+    EXPECT_GT(double(granted.load()), 0.2 * RATE * seconds);   // the limiter, not the threads, is the bottleneck
+}
+
+// Test 7: try_acquire throughput at high thread counts, beside LockFreeStack (benchmark)
+TEST(TokenBucketTest, ContentionBenchmark) {
+    constexpr int OPS_PER_THREAD = 20000;
+
+    for (int threads_count : {1, 2, 4, 8, 16}) {
+        auto run = [&](auto&& op) {
+            std::vector<std::thread> threads;
+            std::atomic<bool> go{false};
+            for (int t = 0; t < threads_count; ++t) {
+                threads.emplace_back([&]() {
+                    while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                    for (int i = 0; i < OPS_PER_THREAD; ++i) op();
+                });
+            }
+            auto start = std::chrono::high_resolution_clock::now();
+            go.store(true, std::memory_order_release);
+            for (auto& t : threads) t.join();
+            auto end = std::chrono::high_resolution_clock::now();
+            auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+            return double(threads_count) * OPS_PER_THREAD / (double(us > 0 ? us : 1) / 1e6);
+        };
+
+        // Half the calls are granted: a mix of CAS successes and read-only rejections
+        TokenBucket bucket(1, uint32_t(threads_count) * OPS_PER_THREAD / 2, 0);
+        std::atomic<uint64_t> granted{0};
+        double bucket_ops = run([&]() {
+            if (bucket.try_acquire(1, 0)) granted.fetch_add(1, std::memory_order_relaxed);
+        });
+
+        LockFreeStack<int> stack;
+        double stack_ops = run([&]() {
+            int value;
+            stack.push(1);
+            stack.pop(value);
+        });
+
+        EXPECT_EQ(granted.load(), uint64_t(threads_count) * OPS_PER_THREAD / 2);
+        std::cout << threads_count << " threads: TokenBucket::try_acquire " << bucket_ops / 1e6
+                  << " million ops/sec, LockFreeStack push+pop " << stack_ops / 1e6
+                  << " million ops/sec" << std::endl;
+    }
+}
+
+// Main function is provided by gtest_main
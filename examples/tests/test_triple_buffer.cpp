@@ -0,0 +1,145 @@
+#include "TripleBuffer.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+
+namespace {
+
+// ~50 KB position table: every entry of one version carries the same stamp
+struct PositionTable {
+    static constexpr size_t ENTRIES = 3200;
+    struct Entry {
+        uint64_t version;
+        int64_t position;
+    };
+    std::array<Entry, ENTRIES> entries{};
+};
+
+}  // namespace
+
+// Test 1: Nothing published yields the initial value, then the latest snapshot
+TEST(TripleBufferTest, BasicOperations) {
+    TripleBuffer<int> buffer(-1);
+
+    EXPECT_FALSE(buffer.has_update());
+    EXPECT_EQ(buffer.read(), -1);
+
+    buffer.back() = 1;
+    buffer.publish();
+    EXPECT_TRUE(buffer.has_update());
+    EXPECT_EQ(buffer.read(), 1);
+    EXPECT_FALSE(buffer.has_update());
+    EXPECT_EQ(buffer.read(), 1);  // re-read without a new publish
+    EXPECT_EQ(buffer.front(), 1);
+}
+
+// Test 2: Unread intermediate snapshots are replaced by the newest one
+TEST(TripleBufferTest, LatestWins) {
+    TripleBuffer<std::string> buffer;
+
+    for (int i = 0; i < 10; ++i) {
+        buffer.publish("v" + std::to_string(i));
+    }
+    EXPECT_EQ(buffer.read(), "v9");
+
+    buffer.publish("v10");
+    const std::string& held = buffer.front();
+    buffer.publish("v11");
+    buffer.publish("v12");
+    EXPECT_EQ(held, "v9");  // the reader's buffer is never written behind its back
+    EXPECT_EQ(buffer.read(), "v12");
+}
+
+// Test 3: Writer and reader buffers are always distinct
+TEST(TripleBufferTest, BuffersDoNotAlias) {
+    TripleBuffer<int> buffer;
+
+    for (int i = 0; i < 100; ++i) {
+        int& back = buffer.publish();
+        const int& front = buffer.read();
+        EXPECT_NE(&back, &front);
+        back = i;
+    }
+}
+
+// Test 4: Concurrent writer and reader, every snapshot read is complete and versions never go back
+TEST(TripleBufferTest, ConcurrentSnapshotsAreConsistent) {
+    auto buffer = std::make_unique<TripleBuffer<PositionTable>>();
+    constexpr uint64_t NUM_VERSIONS = 20000;
+    std::atomic<bool> done{false};
+
+    std::thread writer([&]() {
+        for (uint64_t v = 1; v <= NUM_VERSIONS; ++v) {
+            PositionTable& table = buffer->back();
+            for (auto& entry : table.entries) {
+                entry.version = v;
+                entry.position = int64_t(v) * 7;
+            }
+            buffer->publish();
+            if (v % 64 == 0) {
+                std::this_thread::yield();
+            }
+        }
+        done.store(true);
+    });
+
+    uint64_t last = 0;
+    size_t reads = 0;
+    bool consistent = true;
+    while (!done.load() || buffer->has_update()) {
+        if (!buffer->has_update()) {
+            std::this_thread::yield();
+            continue;
+        }
+        const PositionTable& table = buffer->read();
+        uint64_t v = table.entries[0].version;
+        for (const auto& entry : table.entries) {
+            consistent &= entry.version == v && entry.position == int64_t(v) * 7;
+        }
+        consistent &= v > last;
+        last = v;
+        ++reads;
+    }
+    writer.join();
+
+    EXPECT_TRUE(consistent);
+    EXPECT_EQ(last, NUM_VERSIONS);
+    EXPECT_GT(reads, 0);
+}
+
+// Test 5: Cost of taking a 50 KB snapshot versus copying it (benchmark)
+TEST(TripleBufferTest, SnapshotBenchmark) {
+    auto buffer = std::make_unique<TripleBuffer<PositionTable>>();
+    auto source = std::make_unique<PositionTable>();
+    auto snapshot = std::make_unique<PositionTable>();
+    constexpr int ITERATIONS = 100000;
+
+    int64_t sum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        buffer->back().entries[0].position = i;
+        buffer->publish();
+        sum += buffer->read().entries[0].position;
+    }
+    auto mid = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        source->entries[0].position = i;
+        *snapshot = *source;
+        sum += snapshot->entries[0].position;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    EXPECT_EQ(sum, 2 * (int64_t(ITERATIONS) * (ITERATIONS - 1) / 2));
+    std::cout << "50 KB snapshot handoff: triple buffer "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(mid - start).count() / ITERATIONS
+              << " ns, full copy "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(end - mid).count() / ITERATIONS
+              << " ns" << std::endl;
+}
+
+// Main function is provided by gtest_main
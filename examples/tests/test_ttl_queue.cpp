@@ -0,0 +1,145 @@
+#include "TtlQueue.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+
+// Test 1: Tick calibration round-trips within a few percent
+TEST(TscTest, Calibration) {
+    EXPECT_GT(Tsc::ticks_per_ns(), 0.0);
+
+    uint64_t ticks = Tsc::from_ns(1000000);
+    uint64_t ns = Tsc::to_ns(ticks);
+    EXPECT_NEAR(double(ns), 1e6, 1e4);
+
+    uint64_t t0 = Tsc::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    uint64_t elapsed_ns = Tsc::to_ns(Tsc::now() - t0);
+    EXPECT_GE(elapsed_ns, 1500000);
+}
+
+// Test 2: Fresh items pass, stale items are dropped and counted
+TEST(TtlRingBufferTest, DropsExpired) {
+    TtlRingBuffer<int, 256> buffer(Tsc::from_ns(1000000));  // 1 ms
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(buffer.push(i));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(3));
+    for (int i = 100; i < 110; ++i) {
+        EXPECT_TRUE(buffer.push(i));
+    }
+
+    // The stale prefix is skipped in one go, the live tail is delivered
+    int value = -1;
+    EXPECT_TRUE(buffer.pop(value));
+    EXPECT_EQ(value, 100);
+    EXPECT_EQ(buffer.expired(), 100);
+
+    for (int i = 101; i < 110; ++i) {
+        EXPECT_TRUE(buffer.pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(buffer.pop(value));
+    EXPECT_EQ(buffer.expired(), 100);
+}
+
+// Test 3: Everything expired leaves an empty buffer
+TEST(TtlRingBufferTest, AllExpired) {
+    TtlRingBuffer<std::string, 64> buffer(Tsc::from_ns(500000));  // 0.5 ms
+
+    for (int i = 0; i < 63; ++i) {
+        EXPECT_TRUE(buffer.push("tick"));
+    }
+    EXPECT_FALSE(buffer.push("overflow"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+    EXPECT_EQ(buffer.discard_expired(), 63);
+    EXPECT_TRUE(buffer.empty());
+
+    std::string value;
+    EXPECT_FALSE(buffer.pop(value));
+    EXPECT_TRUE(buffer.push("fresh"));
+    EXPECT_TRUE(buffer.pop(value));
+    EXPECT_EQ(value, "fresh");
+}
+
+// Test 4: A TTL of zero disables dropping
+TEST(TtlRingBufferTest, ZeroTtlKeepsEverything) {
+    TtlRingBuffer<int, 16> buffer(0);
+
+    EXPECT_TRUE(buffer.push(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    int value = 0;
+    EXPECT_TRUE(buffer.pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_EQ(buffer.expired(), 0);
+}
+
+// Test 5: MPSC variant drops stale values from every producer
+TEST(TtlMPSCQueueTest, DropsExpired) {
+    TtlMPSCQueue<int> queue(Tsc::from_ns(1000000));  // 1 ms
+    constexpr int NUM_PRODUCERS = 3;
+    constexpr int ITEMS_PER_PRODUCER = 100;
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < NUM_PRODUCERS; ++t) {
+        producers.emplace_back([&, t]() {
+            for (int i = 0; i < ITEMS_PER_PRODUCER; ++i) {
+                queue.push(t * 1000 + i);
+            }
+        });
+    }
+    for (auto& t : producers) t.join();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(3));
+    queue.push(-1);
+
+    int value = 0;
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, -1);
+    EXPECT_EQ(queue.expired(), NUM_PRODUCERS * ITEMS_PER_PRODUCER);
+    EXPECT_FALSE(queue.pop(value));
+}
+
+// Test 6: Catch-up time of a stalled consumer (benchmark)
+TEST(TtlRingBufferTest, CatchUpBenchmark) {
+    constexpr size_t CAPACITY = 1 << 16;
+    auto ttl = std::make_unique<TtlRingBuffer<int, CAPACITY>>(Tsc::from_ns(1000000));
+    auto plain = std::make_unique<SPSCRingBuffer<Stamped<int>, CAPACITY>>();
+
+    for (int i = 0; i < int(CAPACITY - 1); ++i) {
+        ttl->push(i);
+        plain->push(Stamped<int>{Tsc::now(), i});
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(3));
+
+    // TTL mode: binary search over the stale prefix
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t dropped = ttl->discard_expired();
+    auto mid = std::chrono::high_resolution_clock::now();
+
+    // Without TTL support: pop and check every item
+    size_t checked = 0;
+    uint64_t cutoff = Tsc::now() - Tsc::from_ns(1000000);
+    Stamped<int> item;
+    while (plain->pop(item)) {
+        checked += item.tsc < cutoff;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    EXPECT_EQ(dropped, CAPACITY - 1);
+    EXPECT_EQ(checked, CAPACITY - 1);
+    std::cout << "Skipping " << dropped << " stale items: bulk discard "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(mid - start).count()
+              << " ns, pop-and-check "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(end - mid).count()
+              << " ns" << std::endl;
+}
+
+// Main function is provided by gtest_main
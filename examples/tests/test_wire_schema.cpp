@@ -0,0 +1,226 @@
+#include "WireSchema.h"
+#include "SPSCRingBuffer.h"
+#include "FixedPoint.h"
+#include "Symbol.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+enum class Side : uint8_t { BUY = 1, SELL = 2 };
+
+using Schema = WireSchema<7, 2>;
+using BigEndianSchema = WireSchema<8, 1, std::endian::big>;
+
+// Version 2 of the order message: "tif" was appended in version 2
+using NewOrder = WireMessage<Schema, 1,
+                             WireField<"orderId", uint64_t>,
+                             WireField<"symbol", Symbol8>,
+                             WireField<"price", Price>,
+                             WireField<"qty", uint32_t>,
+                             WireField<"side", Side>,
+                             WireField<"tif", uint8_t, 2>>;
+
+// What a version 1 peer compiled before "tif" existed
+using NewOrderV1 = WireMessage<WireSchema<7, 1>, 1,
+                               WireField<"orderId", uint64_t>,
+                               WireField<"symbol", Symbol8>,
+                               WireField<"price", Price>,
+                               WireField<"qty", uint32_t>,
+                               WireField<"side", Side>>;
+
+using Cancel = WireMessage<Schema, 2,
+                           WireField<"orderId", uint64_t>,
+                           WireField<"reason", std::array<char, 4>>>;
+
+using Tick = WireMessage<BigEndianSchema, 3,
+                         WireField<"seq", uint32_t>,
+                         WireField<"px", double>>;
+
+static_assert(NewOrder::BLOCK_LENGTH == 8 + 8 + 8 + 4 + 1 + 1);
+static_assert(NewOrder::ENCODED_LENGTH == WireHeader::SIZE + NewOrder::BLOCK_LENGTH);
+static_assert(NewOrder::offset_of<"price">() == 16);
+static_assert(NewOrder::offset_of<"tif">() == 29);
+static_assert(std::is_trivially_copyable_v<NewOrder::Frame>);
+
+void encode_order(void* buffer, uint64_t id) {
+    NewOrder::Encoder(buffer)
+        .set<"orderId">(id)
+        .set<"symbol">(Symbol8("AAPL"))
+        .set<"price">(Price::from_raw(187250000 + int64_t(id)))
+        .set<"qty">(uint32_t(100 + id))
+        .set<"side">(id % 2 ? Side::SELL : Side::BUY)
+        .set<"tif">(uint8_t(3));
+}
+
+}  // namespace
+
+// Test 1: Fields round-trip through a frame at their fixed offsets
+TEST(WireSchemaTest, EncodeDecode) {
+    NewOrder::Frame frame{};
+    encode_order(frame.data(), 42);
+
+    NewOrder::Decoder order(frame.data(), sizeof(frame));
+    ASSERT_TRUE(order.valid());
+    EXPECT_EQ(order.version(), 2);
+    EXPECT_EQ(order.size(), NewOrder::ENCODED_LENGTH);
+    EXPECT_EQ(order.get<"orderId">(), 42u);
+    EXPECT_EQ(order.get<"symbol">(), Symbol8("AAPL"));
+    EXPECT_EQ(order.get<"price">(), Price::from_raw(187250042));
+    EXPECT_EQ(order.get<"qty">(), 142u);
+    EXPECT_EQ(order.get<"side">(), Side::BUY);
+    EXPECT_EQ(order.get<"tif">(), 3);
+
+    // Little-endian header and packed block
+    const auto* bytes = reinterpret_cast<const uint8_t*>(frame.data());
+    EXPECT_EQ(bytes[0], NewOrder::BLOCK_LENGTH);
+    EXPECT_EQ(bytes[2], 1);   // template id
+    EXPECT_EQ(bytes[4], 7);   // schema id
+    EXPECT_EQ(bytes[WireHeader::SIZE], 42);
+    EXPECT_EQ(bytes[WireHeader::SIZE + 8], 'A');
+}
+
+// Test 2: Non-native byte order swaps on the wire only
+TEST(WireSchemaTest, BigEndianSchema) {
+    Tick::Frame frame{};
+    Tick::Encoder(frame.data()).set<"seq">(0x01020304u).set<"px">(101.25);
+
+    const auto* bytes = reinterpret_cast<const uint8_t*>(frame.data());
+    EXPECT_EQ(bytes[0], 0);
+    EXPECT_EQ(bytes[1], Tick::BLOCK_LENGTH);
+    EXPECT_EQ(bytes[WireHeader::SIZE], 0x01);
+    EXPECT_EQ(bytes[WireHeader::SIZE + 3], 0x04);
+
+    Tick::Decoder tick(frame.data(), sizeof(frame));
+    ASSERT_TRUE(tick.valid());
+    EXPECT_EQ(tick.get<"seq">(), 0x01020304u);
+    EXPECT_EQ(tick.get<"px">(), 101.25);
+}
+
+// Test 3: Old and new schema versions read each other's messages
+TEST(WireSchemaTest, Versioning) {
+    // New writer, old reader: the appended field is skipped via blockLength
+    NewOrder::Frame v2{};
+    encode_order(v2.data(), 7);
+    NewOrderV1::Decoder old_reader(v2.data(), sizeof(v2));
+    ASSERT_TRUE(old_reader.valid());
+    EXPECT_EQ(old_reader.get<"qty">(), 107u);
+    EXPECT_EQ(old_reader.size(), NewOrder::ENCODED_LENGTH);   // walks past the unknown tail
+
+    // Old writer, new reader: the field added in version 2 is absent
+    NewOrderV1::Frame v1{};
+    NewOrderV1::Encoder(v1.data()).set<"orderId">(9).set<"qty">(5u).set<"side">(Side::SELL);
+    NewOrder::Decoder new_reader(v1.data(), sizeof(v1));
+    ASSERT_TRUE(new_reader.valid());
+    EXPECT_EQ(new_reader.version(), 1);
+    EXPECT_EQ(new_reader.get<"side">(), Side::SELL);
+    EXPECT_FALSE(new_reader.has<"tif">());
+    EXPECT_EQ(new_reader.get<"tif">(), 0);
+}
+
+// Test 4: Wrong template, schema or truncated buffers are rejected
+TEST(WireSchemaTest, RejectsForeignBytes) {
+    NewOrder::Frame frame{};
+    encode_order(frame.data(), 1);
+
+    EXPECT_FALSE(Cancel::Decoder(frame.data(), sizeof(frame)).valid());
+    EXPECT_FALSE(Tick::Decoder(frame.data(), sizeof(frame)).valid());
+    NewOrder::Decoder truncated(frame.data(), NewOrder::ENCODED_LENGTH - 1);
+    EXPECT_FALSE(truncated.valid());
+    EXPECT_EQ(truncated.get<"orderId">(), 0u);
+    EXPECT_FALSE(NewOrder::Decoder(frame.data(), 4).valid());
+}
+
+// Test 5: Encode into and decode from SPSCRingBuffer slot bytes
+TEST(WireSchemaTest, OverRingSlots) {
+    constexpr uint64_t NUM_MESSAGES = 50000;
+    auto ring = std::make_unique<SPSCRingBuffer<NewOrder::Frame, 1024>>();
+
+    std::thread producer([&]() {
+        for (uint64_t i = 0; i < NUM_MESSAGES; ++i) {
+            while (!ring->push_in_place([&](NewOrder::Frame& slot) { encode_order(slot.data(), i); })) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t expected = 0;
+    bool ordered = true;
+    while (expected < NUM_MESSAGES) {
+        size_t n = ring->pop_batch([&](NewOrder::Frame&& slot) {
+            NewOrder::Decoder order(slot.data(), sizeof(slot));   // reads the slot in place
+            ordered &= order.valid() && order.get<"orderId">() == expected &&
+                       order.get<"qty">() == uint32_t(100 + expected);
+            ++expected;
+        }, 64);
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(ordered);
+}
+
+// Test 6: A mixed-type journal in an mmap'd file, walked by header
+TEST(WireSchemaTest, MmapJournal) {
+    char path[] = "/tmp/wire_schema_journalXXXXXX";
+    int fd = ::mkstemp(path);
+    ASSERT_GE(fd, 0);
+    constexpr size_t FILE_SIZE = 4096;
+    ASSERT_EQ(::ftruncate(fd, FILE_SIZE), 0);
+
+    {
+        void* addr = ::mmap(nullptr, FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ASSERT_NE(addr, MAP_FAILED);
+        auto* out = static_cast<std::byte*>(addr);
+        for (uint64_t i = 0; i < 10; ++i) {
+            if (i % 3 == 2) {
+                Cancel::Encoder(out).set<"orderId">(i).set<"reason">({'U', 'S', 'E', 'R'});
+                out += Cancel::ENCODED_LENGTH;
+            } else {
+                encode_order(out, i);
+                out += NewOrder::ENCODED_LENGTH;
+            }
+        }
+        ::munmap(addr, FILE_SIZE);
+    }
+
+    void* addr = ::mmap(nullptr, FILE_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+    ASSERT_NE(addr, MAP_FAILED);
+    const auto* in = static_cast<const std::byte*>(addr);
+    const auto* end = in + FILE_SIZE;
+    std::vector<uint64_t> orders, cancels;
+    while (in + WireHeader::SIZE <= end) {
+        WireHeader header = WireHeader::read<Schema>(in);
+        if (header.schemaId != Schema::SCHEMA_ID) {
+            break;   // zero-filled tail
+        }
+        if (header.templateId == NewOrder::ID) {
+            NewOrder::Decoder order(in, size_t(end - in));
+            orders.push_back(order.get<"orderId">());
+        } else if (header.templateId == Cancel::ID) {
+            Cancel::Decoder cancel(in, size_t(end - in));
+            EXPECT_EQ(cancel.get<"reason">()[0], 'U');
+            cancels.push_back(cancel.get<"orderId">());
+        }
+        in += WireHeader::SIZE + header.blockLength;
+    }
+    ::munmap(addr, FILE_SIZE);
+    ::close(fd);
+    ::unlink(path);
+
+    EXPECT_EQ(orders, (std::vector<uint64_t>{0, 1, 3, 4, 6, 7, 9}));
+    EXPECT_EQ(cancels, (std::vector<uint64_t>{2, 5, 8}));
+}
+
+// Main function is provided by gtest_main